@@ -0,0 +1,168 @@
+#include "mod/AsyncLogSink.h"
+#include "mod/Language.h"
+#include "mod/TextFormat.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+namespace potato_bonemeal_blocker {
+
+void BlockedAttemptRecord::setPlayerName(std::string_view name) noexcept {
+    const auto length = std::min(name.size(), playerName.size() - 1);
+    std::memcpy(playerName.data(), name.data(), length);
+    std::fill(playerName.begin() + static_cast<std::ptrdiff_t>(length), playerName.end(), '\0');
+}
+
+std::string_view BlockedAttemptRecord::getPlayerName() const noexcept {
+    const auto end = std::find(playerName.begin(), playerName.end(), '\0');
+    return {playerName.data(), static_cast<std::size_t>(end - playerName.begin())};
+}
+
+AsyncLogSink::~AsyncLogSink() { stop(); }
+
+std::string_view AsyncLogSink::policyName(OverflowPolicy policy) noexcept {
+    return policy == OverflowPolicy::SAMPLE ? "sample" : "drop";
+}
+
+bool AsyncLogSink::start(LineWriter writer) {
+    if (mRunning.load()) {
+        return true;
+    }
+
+    mSettings.batchSize = std::max<std::size_t>(mSettings.batchSize, 1);
+
+    const auto capacity = std::bit_ceil(std::max<std::size_t>(mSettings.capacity, 2));
+    mCells              = std::make_unique<Cell[]>(capacity);
+    for (std::size_t i = 0; i < capacity; ++i) {
+        mCells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    mMask      = capacity - 1;
+    mHighWater = capacity - capacity / 4;
+    mEnqueuePos.store(0, std::memory_order_relaxed);
+    mDequeuePos.store(0, std::memory_order_relaxed);
+    mWriter = std::move(writer);
+
+    mRunning.store(true);
+    mThread = std::thread([this] { run(); });
+    return true;
+}
+
+void AsyncLogSink::stop() noexcept {
+    if (!mRunning.exchange(false)) {
+        return;
+    }
+    if (mThread.joinable()) {
+        mThread.join();
+    }
+}
+
+bool AsyncLogSink::push(const BlockedAttemptRecord& record) noexcept {
+    if (!mRunning.load(std::memory_order_relaxed)) [[unlikely]] {
+        return false;
+    }
+
+    auto position = mEnqueuePos.load(std::memory_order_relaxed);
+
+    // Thin out the stream before the ring fills up so later records still get through
+    if (mSettings.policy == OverflowPolicy::SAMPLE
+        && position - mDequeuePos.load(std::memory_order_relaxed) >= mHighWater) {
+        const auto sampleRate = std::max<std::uint32_t>(mSettings.sampleRate, 1);
+        if (mSampleCounter.fetch_add(1, std::memory_order_relaxed) % sampleRate != 0) {
+            mSampledOut.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+    }
+
+    for (;;) {
+        auto&      cell     = mCells[position & mMask];
+        const auto sequence = cell.sequence.load(std::memory_order_acquire);
+        const auto diff     = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position);
+
+        if (diff == 0) {
+            // Cell is free for this position, claim it
+            if (mEnqueuePos.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                cell.record = record;
+                cell.sequence.store(position + 1, std::memory_order_release);
+                return true;
+            }
+        } else if (diff < 0) {
+            // The consumer has not released this cell yet: the ring is full
+            mDropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        } else {
+            position = mEnqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+std::size_t AsyncLogSink::drain(std::string& line) noexcept {
+    const auto pattern = Language::getInstance().getMessage(Language::MessageKey::BLOCKED_ATTEMPT_LOG);
+
+    std::size_t written  = 0;
+    auto        position = mDequeuePos.load(std::memory_order_relaxed);
+    while (written < mSettings.batchSize) {
+        auto&      cell     = mCells[position & mMask];
+        const auto sequence = cell.sequence.load(std::memory_order_acquire);
+        if (sequence != position + 1) {
+            break; // Next record not published yet
+        }
+
+        const auto& record = cell.record;
+        try {
+            line.clear();
+            if (record.kind == BlockedAttemptRecord::Kind::GROWTH_BATCH) {
+                appendFormatted(
+                    line,
+                    "Blocked {} bone meal uses by {} in dimension {} chunk ({}, {})",
+                    {record.y, record.getPlayerName(), record.dimension, record.x, record.z}
+                );
+            } else {
+                appendFormatted(line, pattern, {record.getPlayerName(), record.x, record.y, record.z});
+            }
+            mWriter(line);
+        } catch (...) {
+            // A failing writer must not stall the ring
+        }
+
+        cell.sequence.store(position + mMask + 1, std::memory_order_release);
+        ++position;
+        ++written;
+    }
+    mDequeuePos.store(position, std::memory_order_relaxed);
+    mWritten.fetch_add(written, std::memory_order_relaxed);
+    return written;
+}
+
+void AsyncLogSink::run() noexcept {
+    std::string   line;
+    std::uint64_t reportedLosses = getDroppedCount() + getSampledOutCount(); // Reported by an earlier run
+
+    for (;;) {
+        const bool running = mRunning.load();
+
+        // Format full batches back to back, sleep only once the ring is empty
+        while (drain(line) == mSettings.batchSize) {}
+
+        const auto losses = getDroppedCount() + getSampledOutCount();
+        if (losses != reportedLosses) {
+            try {
+                line.clear();
+                appendFormatted(
+                    line,
+                    "{} blocked-attempt log records dropped by overflow policy",
+                    {losses - reportedLosses}
+                );
+                mWriter(line);
+            } catch (...) {}
+            reportedLosses = losses;
+        }
+
+        if (!running) {
+            break; // Final drain after stop() completed above
+        }
+        std::this_thread::sleep_for(mSettings.flushInterval);
+    }
+}
+
+} // namespace potato_bonemeal_blocker
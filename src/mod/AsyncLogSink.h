@@ -0,0 +1,187 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+
+namespace potato_bonemeal_blocker {
+
+/**
+ * @brief Fixed-size binary record of one blocked attempt
+ *
+ * Exactly one cache line, copied into the ring buffer by the game thread and
+ * formatted later by the sink thread. A GROWTH_BATCH record stands for the
+ * attempts of one non-player source in one chunk: x and z hold the chunk
+ * coordinates, y the attempt count and the name the source.
+ */
+struct BlockedAttemptRecord {
+    enum class Kind : std::uint8_t {
+        ATTEMPT,     // One player interaction
+        GROWTH_BATCH // Dispenser or other source attempts folded per chunk
+    };
+
+    std::int64_t         playerId    = 0; ///< Actor unique ID of the player
+    std::int64_t         timestampMs = 0; ///< Wall-clock time in milliseconds since the epoch
+    std::int32_t         x           = 0;
+    std::int32_t         y           = 0;
+    std::int32_t         z           = 0;
+    std::int32_t         dimension   = 0;
+    std::array<char, 31> playerName{};    ///< NUL-padded, truncated to 30 bytes
+    Kind                 kind = Kind::ATTEMPT;
+
+    /**
+     * @brief Store a player name, truncating it to the fixed buffer
+     * @param name The player name
+     */
+    void setPlayerName(std::string_view name) noexcept;
+
+    /**
+     * @brief Get the stored player name
+     * @return View of the NUL-padded name buffer
+     */
+    [[nodiscard]] std::string_view getPlayerName() const noexcept;
+};
+
+static_assert(sizeof(BlockedAttemptRecord) == 64, "BlockedAttemptRecord should fill exactly one cache line");
+
+/**
+ * @brief Asynchronous, lock-free sink for blocked-attempt log records
+ *
+ * Game-thread producers push records into a bounded MPSC ring buffer
+ * (Vyukov sequence cells) without locks or allocation. A background thread
+ * drains the ring in batches, formats each record with the localized
+ * `blocked_attempt_log` template and hands the lines to a writer.
+ *
+ * Producers never block: when the ring is full the record is dropped, and
+ * under the SAMPLE policy records are thinned out before that point.
+ */
+class AsyncLogSink {
+public:
+    /**
+     * @brief What to do with records that arrive faster than the sink drains them
+     */
+    enum class OverflowPolicy : std::uint8_t {
+        DROP,  // Accept everything until the ring is full, then drop and count
+        SAMPLE // Above the high-water mark keep one record out of every sampleRate
+    };
+
+    /// Ring sizes a configuration may ask for
+    static constexpr std::size_t MIN_CAPACITY = 16;
+    static constexpr std::size_t MAX_CAPACITY = std::size_t{1} << 20;
+
+    /// Largest SAMPLE rate a configuration may ask for
+    static constexpr std::uint32_t MAX_SAMPLE_RATE = 65536;
+
+    /**
+     * @brief Sink configuration, applied when the sink is started
+     */
+    struct Settings {
+        std::size_t               capacity      = 4096; ///< Ring size, rounded up to a power of two
+        OverflowPolicy            policy        = OverflowPolicy::DROP;
+        std::uint32_t             sampleRate    = 8;    ///< SAMPLE: keep 1 of N records above high water
+        std::size_t               batchSize     = 256;  ///< Maximum records formatted per wake-up
+        std::chrono::milliseconds flushInterval = std::chrono::milliseconds(100);
+
+        bool operator==(const Settings&) const = default;
+    };
+
+    /**
+     * @brief Get the configuration name of an overflow policy
+     * @param policy The policy
+     * @return "drop" or "sample"
+     */
+    [[nodiscard]] static std::string_view policyName(OverflowPolicy policy) noexcept;
+
+    using LineWriter = std::function<void(std::string_view)>;
+
+    AsyncLogSink() = default;
+    ~AsyncLogSink();
+
+    AsyncLogSink(const AsyncLogSink&)            = delete;
+    AsyncLogSink& operator=(const AsyncLogSink&) = delete;
+
+    /**
+     * @brief Replace the settings; only takes effect on the next start()
+     * @param settings The new settings
+     */
+    void configure(const Settings& settings) noexcept { mSettings = settings; }
+
+    /**
+     * @brief Allocate the ring buffer and start the background writer thread
+     * @param writer Receives each formatted line on the writer thread
+     * @return true if the sink is running
+     */
+    bool start(LineWriter writer);
+
+    /**
+     * @brief Drain the remaining records and stop the writer thread
+     */
+    void stop() noexcept;
+
+    /**
+     * @brief Push a record without blocking
+     * @param record The record to enqueue
+     * @return true if the record was accepted, false if it was dropped or sampled out
+     */
+    bool push(const BlockedAttemptRecord& record) noexcept;
+
+    /**
+     * @brief Get the number of records dropped because the ring was full
+     * @return Dropped record count
+     */
+    [[nodiscard]] std::uint64_t getDroppedCount() const noexcept { return mDropped.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Get the number of records skipped by the SAMPLE policy
+     * @return Sampled-out record count
+     */
+    [[nodiscard]] std::uint64_t getSampledOutCount() const noexcept {
+        return mSampledOut.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Get the number of records queued but not written yet
+     * @return Records in the ring
+     */
+    [[nodiscard]] std::size_t getPendingCount() const noexcept {
+        return mEnqueuePos.load(std::memory_order_relaxed) - mDequeuePos.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Get the number of records written
+     * @return Written record count
+     */
+    [[nodiscard]] std::uint64_t getWrittenCount() const noexcept { return mWritten.load(std::memory_order_relaxed); }
+
+private:
+    struct Cell {
+        std::atomic<std::size_t> sequence{0};
+        BlockedAttemptRecord     record;
+    };
+
+    void run() noexcept;
+    std::size_t drain(std::string& line) noexcept;
+
+    Settings                mSettings;
+    LineWriter              mWriter;
+    std::unique_ptr<Cell[]> mCells;
+    std::size_t             mMask      = 0;
+    std::size_t             mHighWater = 0;
+    std::thread             mThread;
+    std::atomic<bool>       mRunning{false};
+
+    alignas(64) std::atomic<std::size_t> mEnqueuePos{0};
+    alignas(64) std::atomic<std::size_t> mDequeuePos{0}; ///< Written by the sink thread only
+    alignas(64) std::atomic<std::uint64_t> mDropped{0};
+    std::atomic<std::uint64_t> mSampledOut{0};
+    std::atomic<std::uint64_t> mSampleCounter{0};
+    std::atomic<std::uint64_t> mWritten{0};
+};
+
+} // namespace potato_bonemeal_blocker
@@ -0,0 +1,61 @@
+#include "mod/BlockLookupCache.h"
+
+#include "mc/world/level/block/Block.h"
+
+#include <algorithm>
+#include <bit>
+#include <utility>
+
+namespace potato_bonemeal_blocker {
+
+BlockLookupCache::Entry* BlockLookupCache::slot(int dimension, int x, int y, int z) noexcept {
+    if (dimension < 0 || dimension >= MAX_DIMENSIONS) {
+        return nullptr;
+    }
+    // Fibonacci hashing of the packed position spreads a field of neighbouring blocks over the table
+    const auto key = (static_cast<std::uint64_t>(static_cast<std::uint32_t>(x)) << 38)
+                   ^ (static_cast<std::uint64_t>(static_cast<std::uint32_t>(z)) << 12)
+                   ^ static_cast<std::uint64_t>(static_cast<std::uint32_t>(y));
+    const auto index = (key * 0x9E37'79B9'7F4A'7C15ull) >> (64 - std::countr_zero(ENTRIES));
+    return &mTables[static_cast<std::size_t>(dimension)][index];
+}
+
+const Block* BlockLookupCache::find(int dimension, int x, int y, int z, std::uint64_t tick) noexcept {
+    const auto* entry = slot(dimension, x, y, z);
+    if (entry && entry->block && entry->x == x && entry->y == y && entry->z == z && tick < entry->expiresTick) {
+        ++mHits;
+        return entry->block;
+    }
+    ++mMisses;
+    return nullptr;
+}
+
+void BlockLookupCache::insert(int dimension, int x, int y, int z, const Block& block, std::uint64_t tick) noexcept {
+    auto* entry = slot(dimension, x, y, z);
+    if (!entry
+        || std::find(mVolatileTypes.begin(), mVolatileTypes.end(), &block.getLegacyBlock()) != mVolatileTypes.end()) {
+        return;
+    }
+    *entry = Entry{&block, tick + TTL_TICKS, x, y, z};
+}
+
+void BlockLookupCache::invalidate(int dimension, int x, int y, int z) noexcept {
+    auto* entry = slot(dimension, x, y, z);
+    if (entry && entry->block && entry->x == x && entry->y == y && entry->z == z) {
+        entry->block = nullptr;
+        ++mInvalidations;
+    }
+}
+
+void BlockLookupCache::setVolatileTypes(std::vector<const BlockLegacy*> types) {
+    mVolatileTypes = std::move(types);
+    clear();
+}
+
+void BlockLookupCache::clear() noexcept {
+    for (auto& table : mTables) {
+        table.fill(Entry{});
+    }
+}
+
+} // namespace potato_bonemeal_blocker
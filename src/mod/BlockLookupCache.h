@@ -0,0 +1,108 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+class Block;
+class BlockLegacy;
+
+namespace potato_bonemeal_blocker {
+
+/**
+ * @brief Recently resolved positions of the fallback block lookup, per dimension
+ *
+ * When an interaction event carries no block, the handler asks the dimension's
+ * chunk source, and clients clicking the same block again pay for it every
+ * time. This keeps the result in a small direct-mapped table per dimension, so
+ * repeat lookups never touch the chunk source.
+ *
+ * An entry is dropped when a player places or destroys a block at its position,
+ * and expires after TTL_TICKS to cover changes no event reports (pistons,
+ * explosions, villagers planting). Blocks of the volatile types, the crops the
+ * rules name, are never cached: they change growth stage without any event.
+ *
+ * Must only be touched from the server thread.
+ */
+class BlockLookupCache {
+public:
+    /// Dimensions with a table: overworld, nether and the end; others always miss
+    static constexpr int MAX_DIMENSIONS = 3;
+
+    /// Entries per dimension, a power of two
+    static constexpr std::size_t ENTRIES = 1024;
+
+    /// Server ticks an entry is served before the chunk source is asked again
+    static constexpr std::uint64_t TTL_TICKS = 20;
+
+    /**
+     * @brief Look up a position
+     * @param dimension Dimension ID
+     * @param x Block X
+     * @param y Block Y
+     * @param z Block Z
+     * @param tick Current server tick
+     * @return The cached block, or nullptr on a miss
+     */
+    [[nodiscard]] const Block* find(int dimension, int x, int y, int z, std::uint64_t tick) noexcept;
+
+    /**
+     * @brief Remember the block at a position, unless its type is volatile
+     * @param dimension Dimension ID
+     * @param x Block X
+     * @param y Block Y
+     * @param z Block Z
+     * @param block The block the chunk source returned
+     * @param tick Current server tick
+     */
+    void insert(int dimension, int x, int y, int z, const Block& block, std::uint64_t tick) noexcept;
+
+    /**
+     * @brief Drop the entry of a position whose block changed
+     * @param dimension Dimension ID
+     * @param x Block X
+     * @param y Block Y
+     * @param z Block Z
+     */
+    void invalidate(int dimension, int x, int y, int z) noexcept;
+
+    /**
+     * @brief Replace the block types that are never cached, dropping every entry
+     * @param types Block types whose permutations change without an event
+     */
+    void setVolatileTypes(std::vector<const BlockLegacy*> types);
+
+    /**
+     * @brief Drop every entry
+     */
+    void clear() noexcept;
+
+    [[nodiscard]] std::uint64_t getHitCount() const noexcept { return mHits; }
+    [[nodiscard]] std::uint64_t getMissCount() const noexcept { return mMisses; }
+    [[nodiscard]] std::uint64_t getInvalidationCount() const noexcept { return mInvalidations; }
+
+private:
+    struct Entry {
+        const Block*  block       = nullptr; ///< nullptr while empty
+        std::uint64_t expiresTick = 0;
+        int           x           = 0;
+        int           y           = 0;
+        int           z           = 0;
+    };
+
+    using Table = std::array<Entry, ENTRIES>;
+
+    /**
+     * @brief Get the slot a position maps to
+     * @return The slot, or nullptr for dimensions without a table
+     */
+    [[nodiscard]] Entry* slot(int dimension, int x, int y, int z) noexcept;
+
+    std::vector<Table>              mTables = std::vector<Table>(MAX_DIMENSIONS);
+    std::vector<const BlockLegacy*> mVolatileTypes;
+    std::uint64_t                   mHits          = 0;
+    std::uint64_t                   mMisses        = 0;
+    std::uint64_t                   mInvalidations = 0;
+};
+
+} // namespace potato_bonemeal_blocker
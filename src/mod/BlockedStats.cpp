@@ -0,0 +1,257 @@
+#include "mod/BlockedStats.h"
+
+#include <algorithm>
+#include <system_error>
+
+namespace potato_bonemeal_blocker {
+
+bool BlockedStats::start(const std::filesystem::path& path, Settings settings) {
+    if (mRunning.load()) {
+        return false;
+    }
+    mError.clear();
+    mPersisted = 0;
+
+    std::error_code ec;
+    const auto      size = std::filesystem::exists(path, ec) ? std::filesystem::file_size(path, ec) : 0;
+    if (size > 0) {
+        std::uintmax_t whole = 0;
+        {
+            StatsReader reader;
+            if (!reader.open(path)) {
+                mError = std::string(reader.getError());
+                return false;
+            }
+            mPersisted = reader.total(StatsKind::PLAYER);
+            whole      = reader.getHeader().headerSize + reader.getRecords().size() * sizeof(StatsRecord);
+        }
+        // A record cut short by a crash would misalign every later append
+        if (whole != size) {
+            std::filesystem::resize_file(path, whole, ec);
+            if (ec) {
+                mError = "cannot truncate partial record: " + ec.message();
+                return false;
+            }
+        }
+    }
+
+    mFile.open(path, std::ios::binary | std::ios::app);
+    if (!mFile) {
+        mError = "cannot open " + path.string();
+        return false;
+    }
+    if (size == 0) {
+        StatsHeader header;
+        header.headerSize     = sizeof(StatsHeader);
+        header.recordSize     = sizeof(StatsRecord);
+        header.createdEpochMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+                                    std::chrono::system_clock::now().time_since_epoch()
+        )
+                                    .count();
+        mFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        mFile.flush();
+        if (!mFile) {
+            mError = "cannot write header to " + path.string();
+            mFile.close();
+            return false;
+        }
+    }
+
+    mPath     = path;
+    mSettings = settings;
+    mWritten.store(0, std::memory_order_relaxed);
+    mEvicted.store(0, std::memory_order_relaxed);
+    mDropped.store(0, std::memory_order_relaxed);
+    mFlushRequested.store(false);
+    mRunning.store(true);
+    mThread = std::thread([this] {
+        auto nextFlush = std::chrono::steady_clock::now() + mSettings.flushInterval;
+        while (mRunning.load()) {
+            {
+                // Short waits so stop() does not wait for a whole interval; full shards wake it at once
+                std::unique_lock lock(mWakeMutex);
+                mWake.wait_for(lock, std::chrono::milliseconds(200), [this] {
+                    return mFlushRequested.load() || !mRunning.load();
+                });
+            }
+            if (mFlushRequested.exchange(false) || std::chrono::steady_clock::now() >= nextFlush) {
+                flush();
+                nextFlush = std::chrono::steady_clock::now() + mSettings.flushInterval;
+            }
+        }
+    });
+    return true;
+}
+
+void BlockedStats::stop() noexcept {
+    if (!mRunning.exchange(false)) {
+        return;
+    }
+    mWake.notify_all();
+    if (mThread.joinable()) {
+        mThread.join();
+    }
+
+    // Attempts counted after the flusher's last pass
+    flush();
+    const std::lock_guard lock(mFileMutex);
+    mFile.close();
+    for (auto& shard : mShards) {
+        const std::lock_guard shardLock(shard.mutex);
+        shard.players.clear();
+        shard.chunks.clear();
+        shard.spilled.clear();
+    }
+}
+
+void BlockedStats::add(
+    StatsKind     kind,
+    std::int64_t  key,
+    std::uint32_t hour,
+    std::int64_t  epochMs,
+    std::uint32_t count
+) noexcept {
+    auto&                 shard = mShards[shardFor(kind, key)];
+    const std::lock_guard lock(shard.mutex);
+    try {
+        auto& map   = kind == StatsKind::PLAYER ? shard.players : shard.chunks;
+        auto* entry = map.find(key);
+        if (!entry) [[unlikely]] {
+            const auto share = std::max<std::size_t>(mSettings.maxKeys / SHARD_COUNT, 1);
+            const auto keys  = shard.players.size() + shard.chunks.size();
+            if (keys >= share * 2) [[unlikely]] {
+                // The flusher has not caught up: park the attempt as a record rather than grow the shard
+                if (shard.spilled.size() >= share) {
+                    mDropped.fetch_add(count, std::memory_order_relaxed);
+                } else {
+                    StatsRecord record;
+                    record.key         = key;
+                    record.lastEpochMs = epochMs;
+                    record.hour        = hour;
+                    record.count       = count;
+                    record.kind        = kind;
+                    shard.spilled.push_back(record);
+                }
+                if (!mFlushRequested.exchange(true, std::memory_order_relaxed)) {
+                    mWake.notify_one();
+                }
+                return;
+            }
+            if (keys >= share && !mFlushRequested.exchange(true, std::memory_order_relaxed)) {
+                mWake.notify_one();
+            }
+            entry = &map[key];
+        }
+        if (entry->hour != hour && entry->pending > 0) [[unlikely]] {
+            StatsRecord record;
+            record.key         = key;
+            record.lastEpochMs = entry->lastEpochMs;
+            record.hour        = entry->hour;
+            record.count       = entry->pending;
+            record.kind        = kind;
+            shard.spilled.push_back(record);
+            entry->pending = 0;
+        }
+        entry->hour        = hour;
+        entry->lastEpochMs = epochMs;
+        entry->pending    += count;
+    } catch (...) {
+        mDropped.fetch_add(count, std::memory_order_relaxed);
+    }
+}
+
+void BlockedStats::flush() noexcept {
+    // Serializes the flusher thread with flush() calls from queries
+    const std::lock_guard fileLock(mFileMutex);
+    if (!mFile.is_open()) {
+        return;
+    }
+
+    try {
+        // Records still in mBatch after a failed collect are written with this batch
+        for (auto& shard : mShards) {
+            const std::lock_guard lock(shard.mutex);
+            collect(shard);
+            evictColdKeys(shard);
+        }
+    } catch (...) {
+        // Counts not collected stay pending in their entries until the next flush
+    }
+    writeBatch();
+}
+
+void BlockedStats::collect(Shard& shard) {
+    mBatch.insert(mBatch.end(), shard.spilled.begin(), shard.spilled.end());
+    shard.spilled.clear();
+
+    const auto gather = [&](StatsKind kind) {
+        return [&, kind](std::int64_t key, Entry& entry) {
+            if (entry.pending == 0) {
+                return;
+            }
+            StatsRecord record;
+            record.key         = key;
+            record.lastEpochMs = entry.lastEpochMs;
+            record.hour        = entry.hour;
+            record.count       = entry.pending;
+            record.kind        = kind;
+            mBatch.push_back(record);
+            entry.pending = 0;
+        };
+    };
+    shard.players.forEach(gather(StatsKind::PLAYER));
+    shard.chunks.forEach(gather(StatsKind::CHUNK));
+}
+
+void BlockedStats::writeBatch() noexcept {
+    if (mBatch.empty()) {
+        return;
+    }
+    mFile.write(
+        reinterpret_cast<const char*>(mBatch.data()),
+        static_cast<std::streamsize>(mBatch.size() * sizeof(StatsRecord))
+    );
+    mFile.flush();
+    if (mFile) {
+        mWritten.fetch_add(mBatch.size(), std::memory_order_relaxed);
+    } else {
+        mDropped.fetch_add(mBatch.size(), std::memory_order_relaxed);
+        mFile.clear();
+    }
+    mBatch.clear();
+}
+
+void BlockedStats::evictColdKeys(Shard& shard) {
+    const auto keep  = std::max<std::size_t>(mSettings.maxKeys / SHARD_COUNT, 1);
+    const auto total = shard.players.size() + shard.chunks.size();
+    if (total <= keep) {
+        return;
+    }
+
+    // Every entry was just flushed, so dropping one loses nothing; keep the most recently blocked
+    std::vector<std::int64_t> times;
+    times.reserve(total);
+    const auto gather = [&](std::int64_t, const Entry& entry) { times.push_back(entry.lastEpochMs); };
+    shard.players.forEach(gather);
+    shard.chunks.forEach(gather);
+    const auto cutoff = times.begin() + static_cast<std::ptrdiff_t>(total - keep - 1);
+    std::nth_element(times.begin(), cutoff, times.end());
+
+    const auto isCold = [threshold = *cutoff](std::int64_t, const Entry& entry) {
+        // Ties with the cutoff go too, so a burst within one millisecond cannot pin the shard
+        return entry.lastEpochMs <= threshold;
+    };
+    const auto evicted = shard.players.eraseIf(isCold) + shard.chunks.eraseIf(isCold);
+    mEvicted.fetch_add(evicted, std::memory_order_relaxed);
+}
+
+std::size_t BlockedStats::getTrackedKeys() const noexcept {
+    std::size_t keys = 0;
+    for (const auto& shard : mShards) {
+        const std::lock_guard lock(shard.mutex);
+        keys += shard.players.size() + shard.chunks.size();
+    }
+    return keys;
+}
+
+} // namespace potato_bonemeal_blocker
@@ -0,0 +1,202 @@
+#pragma once
+
+#include "FlatIdMap.h"
+#include "StatsFormat.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace potato_bonemeal_blocker {
+
+/**
+ * @brief Per-player and per-chunk blocked-attempt counts, persisted to an append-only file
+ *
+ * Counts are aggregated in memory per key and hour and spread over
+ * SHARD_COUNT shards, each with its own lock. The event path locks one shard
+ * per key for a single FlatIdMap update; the flusher thread walks the shards
+ * one at a time, so it never holds up more than a sixteenth of the keys.
+ *
+ * Every flush interval the flusher appends one StatsRecord per key with new
+ * attempts to the statistics file and resets the key's pending count. Keys
+ * whose hour changes before a flush keep their finished hour in a per-shard
+ * spill list until then. After a flush, shards over their share of
+ * Settings::maxKeys drop their least recently blocked keys; their counts are
+ * already on disk, so memory stays bounded without losing attempts.
+ *
+ * A shard reaching its share wakes the flusher early instead of waiting for
+ * the interval. A new key arriving in a shard that still holds twice its
+ * share goes to the spill list as a record instead of growing the shard, so
+ * the event path never touches the file. Only attempts beyond a spill list
+ * of one share are counted as dropped.
+ */
+class BlockedStats {
+public:
+    static constexpr std::size_t SHARD_COUNT = 16;
+
+    /// Settings::maxKeys a configuration may ask for; at least 64 keys per shard
+    static constexpr std::size_t MIN_KEYS = SHARD_COUNT * 64;
+    static constexpr std::size_t MAX_KEYS = std::size_t{1} << 24;
+
+    /**
+     * @brief Flush and memory settings
+     */
+    struct Settings {
+        std::chrono::seconds flushInterval{30}; ///< Time between appends to the statistics file
+        std::size_t          maxKeys = 65536;    ///< Player and chunk keys kept in memory after a flush
+
+        bool operator==(const Settings&) const = default;
+    };
+
+    BlockedStats() = default;
+    ~BlockedStats() { stop(); }
+
+    BlockedStats(const BlockedStats&)            = delete;
+    BlockedStats& operator=(const BlockedStats&) = delete;
+
+    /**
+     * @brief Open (or create) the statistics file and start the flusher thread
+     * @param path The statistics file
+     * @param settings Flush and memory settings
+     * @return true if the file could be opened; getError() describes failures
+     */
+    bool start(const std::filesystem::path& path, Settings settings);
+
+    /**
+     * @brief Flush all pending counts and stop the flusher thread
+     */
+    void stop() noexcept;
+
+    /**
+     * @brief Count a blocked attempt
+     * @param playerId Actor unique ID of the player
+     * @param dimension Dimension ID
+     * @param x Block X of the target
+     * @param z Block Z of the target
+     * @param epochMs Wall-clock time of the attempt
+     */
+    void record(std::int64_t playerId, int dimension, int x, int z, std::int64_t epochMs) noexcept {
+        if (!mRunning.load(std::memory_order_relaxed)) [[unlikely]] {
+            return;
+        }
+        const auto hour = epochHour(epochMs);
+        add(StatsKind::PLAYER, playerId, hour, epochMs);
+        add(StatsKind::CHUNK, packChunkKey(dimension, x >> 4, z >> 4), hour, epochMs);
+    }
+
+    /**
+     * @brief Count blocked attempts that have no player, e.g. from dispensers
+     * @param dimension Dimension ID
+     * @param chunkX Chunk X of the targets
+     * @param chunkZ Chunk Z of the targets
+     * @param count Attempts in the chunk
+     * @param epochMs Wall-clock time of the latest attempt
+     */
+    void recordChunk(int dimension, int chunkX, int chunkZ, std::uint32_t count, std::int64_t epochMs) noexcept {
+        if (!mRunning.load(std::memory_order_relaxed)) [[unlikely]] {
+            return;
+        }
+        add(StatsKind::CHUNK, packChunkKey(dimension, chunkX, chunkZ), epochHour(epochMs), epochMs, count);
+    }
+
+    /**
+     * @brief Append all pending counts to the file now, e.g. before a query
+     */
+    void flush() noexcept;
+
+    [[nodiscard]] bool                         isRunning() const noexcept { return mRunning.load(); }
+    [[nodiscard]] const std::filesystem::path& getPath() const noexcept { return mPath; }
+    [[nodiscard]] const Settings&              getSettings() const noexcept { return mSettings; }
+    [[nodiscard]] std::string_view             getError() const noexcept { return mError; }
+
+    /**
+     * @brief Get the attempts recorded in the file before start()
+     * @return Blocked attempts of earlier sessions
+     */
+    [[nodiscard]] std::uint64_t getPersistedCount() const noexcept { return mPersisted; }
+
+    /**
+     * @brief Get the number of keys currently held in memory
+     * @return Player and chunk keys over all shards
+     */
+    [[nodiscard]] std::size_t getTrackedKeys() const noexcept;
+
+    [[nodiscard]] std::uint64_t getWrittenRecords() const noexcept { return mWritten.load(std::memory_order_relaxed); }
+    [[nodiscard]] std::uint64_t getEvictedKeys() const noexcept { return mEvicted.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Get the number of player or chunk updates lost to a full spill list, a failed write or allocation
+     * @return Dropped key updates; each attempt updates one player and one chunk key
+     */
+    [[nodiscard]] std::uint64_t getDroppedCount() const noexcept { return mDropped.load(std::memory_order_relaxed); }
+
+private:
+    /**
+     * @brief In-memory aggregate of one key
+     */
+    struct Entry {
+        std::int64_t  lastEpochMs = 0;
+        std::uint32_t hour        = 0;
+        std::uint32_t pending     = 0; ///< Attempts in `hour` not yet written
+    };
+
+    /**
+     * @brief One lock and its keys, on its own cache line
+     */
+    struct alignas(64) Shard {
+        mutable std::mutex       mutex;
+        FlatIdMap<Entry>         players;
+        FlatIdMap<Entry>         chunks;
+        std::vector<StatsRecord> spilled; ///< Finished hours awaiting the next flush
+    };
+
+    [[nodiscard]] static std::size_t shardFor(StatsKind kind, std::int64_t key) noexcept {
+        // FlatIdMap slots come from the top bits of the Fibonacci product; taking the shard from the same
+        // bits would crowd each shard's keys into a sixteenth of its table, so a different multiplier is used
+        const auto mixed = (static_cast<std::uint64_t>(key) ^ static_cast<std::uint64_t>(kind)) * 0xD6E8FEB86659FD93ull;
+        return static_cast<std::size_t>(mixed >> 60);
+    }
+
+    void add(StatsKind kind, std::int64_t key, std::uint32_t hour, std::int64_t epochMs, std::uint32_t count = 1) noexcept;
+
+    /**
+     * @brief Move a shard's spill list and pending counts into mBatch; the caller holds mFileMutex and the shard
+     */
+    void collect(Shard& shard);
+
+    /**
+     * @brief Append mBatch to the file; the caller holds mFileMutex
+     */
+    void writeBatch() noexcept;
+
+    void evictColdKeys(Shard& shard);
+
+    std::array<Shard, SHARD_COUNT> mShards;
+    std::atomic<bool>              mRunning{false};
+    std::atomic<bool>              mFlushRequested{false};
+    std::atomic<std::uint64_t>     mWritten{0};
+    std::atomic<std::uint64_t>     mEvicted{0};
+    std::atomic<std::uint64_t>     mDropped{0};
+
+    // Owned by start()/stop(); the file is shared by the flusher thread and flush() callers
+    std::mutex               mFileMutex;
+    std::ofstream            mFile;
+    std::vector<StatsRecord> mBatch;
+    std::filesystem::path    mPath;
+    Settings                 mSettings;
+    std::string              mError;
+    std::uint64_t            mPersisted = 0;
+    std::thread              mThread;
+    std::mutex               mWakeMutex;
+    std::condition_variable  mWake;
+};
+
+} // namespace potato_bonemeal_blocker
@@ -0,0 +1,29 @@
+#include "mod/BypassCache.h"
+
+#include "mc/server/commands/CommandPermissionLevel.h"
+#include "mc/world/actor/player/Player.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace potato_bonemeal_blocker {
+
+void BypassCache::configure(Settings settings) {
+    mSettings = std::move(settings);
+    mEntries.clear();
+}
+
+bool BypassCache::refresh(const Player& player) {
+    bool exempt = mSettings.operators && player.getCommandPermissionLevel() >= CommandPermissionLevel::GameDirectors;
+    if (!exempt && !mSettings.players.empty()) {
+        const auto& name = player.getRealName();
+        const auto  xuid = player.getXuid();
+        exempt           = std::any_of(mSettings.players.begin(), mSettings.players.end(), [&](const auto& entry) {
+            return entry == name || entry == xuid;
+        });
+    }
+    mEntries[player.getOrCreateUniqueID().id] = exempt;
+    return exempt;
+}
+
+} // namespace potato_bonemeal_blocker
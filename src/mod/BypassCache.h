@@ -0,0 +1,74 @@
+#pragma once
+
+#include "FlatIdMap.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class Player;
+
+namespace potato_bonemeal_blocker {
+
+/**
+ * @brief Per-player cache of "exempt from the rules" decisions
+ *
+ * Whether a player may bypass the rules depends on their permission level and
+ * the configured bypass list, both too slow to check on every interaction.
+ * The decision is computed when a player joins, kept in a FlatIdMap keyed by
+ * actor unique ID, and dropped on logout; the event path costs one probe.
+ *
+ * Must only be touched from the server thread.
+ */
+class BypassCache {
+public:
+    /**
+     * @brief Who is exempt
+     */
+    struct Settings {
+        bool                     operators = true; ///< Players with GameDirectors permission or above
+        std::vector<std::string> players;          ///< Real names or XUIDs
+
+        bool operator==(const Settings&) const = default;
+    };
+
+    /**
+     * @brief Replace the settings and forget every cached decision
+     * @param settings The new settings
+     */
+    void configure(Settings settings);
+
+    /**
+     * @brief Get the cached decision for a player
+     * @param playerId Actor unique ID
+     * @return Pointer to the decision, or nullptr on a cache miss
+     */
+    [[nodiscard]] const bool* find(std::int64_t playerId) const noexcept { return mEntries.find(playerId); }
+
+    /**
+     * @brief Evaluate a player against the settings and cache the result
+     * @param player The player
+     * @return true if the player is exempt
+     */
+    bool refresh(const Player& player);
+
+    /**
+     * @brief Drop the decision for a player, e.g. on logout
+     * @param playerId Actor unique ID
+     */
+    void evict(std::int64_t playerId) noexcept { mEntries.erase(playerId); }
+
+    /**
+     * @brief Drop all cached decisions
+     */
+    void clear() noexcept { mEntries.clear(); }
+
+    [[nodiscard]] std::size_t     size() const noexcept { return mEntries.size(); }
+    [[nodiscard]] const Settings& getSettings() const noexcept { return mSettings; }
+
+private:
+    Settings        mSettings;
+    FlatIdMap<bool> mEntries; ///< Actor unique ID -> exempt
+};
+
+} // namespace potato_bonemeal_blocker
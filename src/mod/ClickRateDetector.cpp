@@ -0,0 +1,64 @@
+#include "mod/ClickRateDetector.h"
+
+#include <algorithm>
+
+namespace potato_bonemeal_blocker {
+
+void ClickRateDetector::configure(const Settings& settings) noexcept {
+    mSettings             = settings;
+    mSettings.maxAttempts = std::clamp<std::uint32_t>(settings.maxAttempts, 2, RING_CAPACITY);
+}
+
+bool ClickRateDetector::isFlagged(std::int64_t playerId, std::int64_t nowMs) noexcept {
+    auto* state = mStates.find(playerId);
+    if (!state || state->flaggedUntilMs == 0) {
+        return false;
+    }
+    if (state->flaggedUntilMs <= nowMs) {
+        // Cool-down over: start from an empty window so the flag is not renewed by old attempts
+        state->flaggedUntilMs = 0;
+        state->dropped        = 0;
+        state->size           = 0;
+        mFlaggedPlayers -= mFlaggedPlayers > 0 ? 1 : 0;
+        return false;
+    }
+    ++state->dropped;
+    mDropped.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool ClickRateDetector::record(std::int64_t playerId, std::int64_t nowMs) {
+    if (!mSettings.enabled) {
+        return false;
+    }
+    auto& state = mStates[playerId];
+    if (state.flaggedUntilMs != 0) {
+        return false;
+    }
+
+    state.times[state.next] = nowMs;
+    state.next              = static_cast<std::uint8_t>((state.next + 1) % RING_CAPACITY);
+    state.size              = static_cast<std::uint8_t>(std::min<std::uint32_t>(state.size + 1u, RING_CAPACITY));
+    if (state.size < mSettings.maxAttempts) {
+        return false;
+    }
+
+    // The attempt maxAttempts - 1 before this one bounds the window
+    const auto oldest = state.times[(state.next + RING_CAPACITY - mSettings.maxAttempts) % RING_CAPACITY];
+    if (nowMs - oldest >= mSettings.window.count()) {
+        return false;
+    }
+    state.flaggedUntilMs = nowMs + std::max<std::int64_t>(mSettings.cooldown.count(), 1);
+    ++mFlaggedPlayers;
+    mFlags.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+void ClickRateDetector::evict(std::int64_t playerId) noexcept {
+    if (const auto* state = mStates.find(playerId); state && state->flaggedUntilMs != 0) {
+        mFlaggedPlayers -= mFlaggedPlayers > 0 ? 1 : 0;
+    }
+    mStates.erase(playerId);
+}
+
+} // namespace potato_bonemeal_blocker
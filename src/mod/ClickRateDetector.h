@@ -0,0 +1,130 @@
+#pragma once
+
+#include "FlatIdMap.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace potato_bonemeal_blocker {
+
+/**
+ * @brief Per-player sliding-window detector for auto-clicker bone meal spam
+ *
+ * Every player keeps the times of their most recent blocked attempts in a
+ * fixed ring of RING_CAPACITY slots, so memory per player is bounded no
+ * matter how fast a macro client clicks. When the ring's last
+ * Settings::maxAttempts entries fall within Settings::window, the player is
+ * flagged until Settings::cooldown has passed; the handler then cancels their
+ * covered-item interactions before any block lookup, feedback or logging.
+ *
+ * State is kept in a FlatIdMap keyed by actor unique ID and must only be
+ * touched from the game thread.
+ */
+class ClickRateDetector {
+public:
+    /// Largest supported Settings::maxAttempts; the ring never grows beyond this
+    static constexpr std::uint32_t RING_CAPACITY = 32;
+
+    /**
+     * @brief Detection thresholds
+     */
+    struct Settings {
+        bool enabled = true;
+        /// Blocked attempts within one window that flag the player (2..RING_CAPACITY)
+        std::uint32_t             maxAttempts = 12;
+        std::chrono::milliseconds window{1000};    ///< Sliding window the attempts are counted in
+        std::chrono::milliseconds cooldown{10000}; ///< Time a flagged player's interactions are dropped
+
+        bool operator==(const Settings&) const = default;
+    };
+
+    /**
+     * @brief Replace the thresholds; flagged players keep their current cool-down
+     * @param settings The new settings
+     */
+    void configure(const Settings& settings) noexcept;
+
+    /**
+     * @brief Check cheaply whether any player may currently be flagged
+     * @return false if isFlagged() would return false for every player
+     */
+    [[nodiscard]] bool hasFlagged() const noexcept { return mFlaggedPlayers > 0; }
+
+    /**
+     * @brief Check whether a player's interactions are being dropped, counting the drop
+     * @param playerId Actor unique ID of the player
+     * @param nowMs Monotonic time in milliseconds
+     * @return true while the player's cool-down lasts
+     */
+    bool isFlagged(std::int64_t playerId, std::int64_t nowMs) noexcept;
+
+    /**
+     * @brief Record a blocked attempt
+     * @param playerId Actor unique ID of the player
+     * @param nowMs Monotonic time in milliseconds
+     * @return true if this attempt got the player flagged
+     */
+    bool record(std::int64_t playerId, std::int64_t nowMs);
+
+    /**
+     * @brief Call a function for every player whose cool-down has not expired yet
+     * @param nowMs Monotonic time in milliseconds
+     * @param fn Called as fn(playerId, remainingMs, droppedCount)
+     */
+    template <typename Fn>
+    void forEachFlagged(std::int64_t nowMs, Fn&& fn) const {
+        mStates.forEach([&](std::int64_t playerId, const State& state) {
+            if (state.flaggedUntilMs > nowMs) {
+                fn(playerId, state.flaggedUntilMs - nowMs, state.dropped);
+            }
+        });
+    }
+
+    /**
+     * @brief Drop the state of a player, e.g. on logout
+     * @param playerId Actor unique ID of the player
+     */
+    void evict(std::int64_t playerId) noexcept;
+
+    /**
+     * @brief Drop all player state
+     */
+    void clear() noexcept {
+        mStates.clear();
+        mFlaggedPlayers = 0;
+    }
+
+    [[nodiscard]] const Settings& getSettings() const noexcept { return mSettings; }
+    [[nodiscard]] std::size_t     getTrackedPlayers() const noexcept { return mStates.size(); }
+
+    /**
+     * @brief Get the number of times a player was flagged
+     * @return Flags since start
+     */
+    [[nodiscard]] std::uint64_t getFlagCount() const noexcept { return mFlags.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Get the number of interactions dropped for flagged players
+     * @return Dropped interactions since start
+     */
+    [[nodiscard]] std::uint64_t getDroppedCount() const noexcept { return mDropped.load(std::memory_order_relaxed); }
+
+private:
+    struct State {
+        std::array<std::int64_t, RING_CAPACITY> times{}; ///< Attempt times, oldest overwritten first
+        std::int64_t                            flaggedUntilMs = 0;
+        std::uint32_t                           dropped        = 0; ///< Interactions dropped in the current flag
+        std::uint8_t                            next           = 0; ///< Ring slot the next attempt goes to
+        std::uint8_t                            size           = 0;
+    };
+
+    Settings                   mSettings;
+    FlatIdMap<State>           mStates;
+    std::size_t                mFlaggedPlayers = 0; ///< Flags not yet seen to expire; may overcount
+    std::atomic<std::uint64_t> mFlags{0};
+    std::atomic<std::uint64_t> mDropped{0};
+};
+
+} // namespace potato_bonemeal_blocker
@@ -0,0 +1,517 @@
+#include "mod/Commands.h"
+#include "mod/GrowthGovernor.h"
+#include "mod/Metrics.h"
+#include "mod/StatsFormat.h"
+#include "mod/TextFormat.h"
+#include "mod/PotatoBoneMealBlocker.h"
+
+#include "ll/api/command/CommandHandle.h"
+#include "ll/api/command/CommandRegistrar.h"
+#include "ll/api/service/Bedrock.h"
+#include "mc/world/actor/player/Player.h"
+#include "mc/world/level/Level.h"
+#include "mc/server/commands/CommandOrigin.h"
+#include "mc/server/commands/CommandOutput.h"
+#include "mc/server/commands/CommandPermissionLevel.h"
+
+#include <charconv>
+#include <chrono>
+#include <string>
+#include <string_view>
+
+namespace potato_bonemeal_blocker {
+
+namespace {
+
+/**
+ * @brief Send multi-line text as one success line per text line
+ */
+void outputLines(CommandOutput& output, std::string_view text) {
+    while (!text.empty()) {
+        const auto end = text.find('\n');
+        output.success(std::string(text.substr(0, end)));
+        if (end == std::string_view::npos) {
+            break;
+        }
+        text.remove_prefix(end + 1);
+    }
+}
+
+/// Hours covered by /potatoblocker top, including the current one
+constexpr std::uint32_t TOP_HOURS = 24;
+
+/// Keys listed by /potatoblocker top
+constexpr std::size_t TOP_LIMIT = 10;
+
+/**
+ * @brief Render the keys with the most blocked attempts over the last TOP_HOURS hours
+ */
+bool renderTop(StatsKind kind, std::string& text) {
+    auto& stats = PotatoBoneMealBlocker::getInstance().getBlockedStats();
+    if (!stats.isRunning()) {
+        text = "Blocked-attempt statistics are not being recorded";
+        return false;
+    }
+
+    // Pending counts are appended first so the mapped file is current
+    stats.flush();
+    StatsReader reader;
+    if (!reader.open(stats.getPath())) {
+        text = "Cannot read " + stats.getPath().string() + ": " + std::string(reader.getError());
+        return false;
+    }
+
+    const auto nowMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+                           std::chrono::system_clock::now().time_since_epoch()
+    )
+                           .count();
+    // Only the tail of the file written within the window and one flush interval is scanned
+    const auto interval = stats.getSettings().flushInterval.count();
+    const auto lagHours = static_cast<std::uint32_t>((interval + 3599) / 3600);
+    const auto hour     = epochHour(nowMs);
+    const auto totals   = reader.top(kind, hour >= TOP_HOURS ? hour - TOP_HOURS + 1 : 0, TOP_LIMIT, lagHours);
+    appendFormatted(
+        text,
+        "Most blocked {} over the last {} hours:",
+        {kind == StatsKind::PLAYER ? "players" : "chunks", TOP_HOURS}
+    );
+    if (totals.empty()) {
+        text += "\n  none";
+    }
+
+    auto level = ll::service::getLevel();
+    for (const auto& total : totals) {
+        if (kind == StatsKind::CHUNK) {
+            const auto chunkX = chunkKeyX(total.key);
+            const auto chunkZ = chunkKeyZ(total.key);
+            appendFormatted(
+                text,
+                "\n  dimension {} chunk {} {} (x {}, z {}): {}",
+                {chunkKeyDimension(total.key), chunkX, chunkZ, chunkX * 16, chunkZ * 16, total.count}
+            );
+            continue;
+        }
+        // Offline players are only known by their actor unique ID
+        const auto* player = level ? level->getPlayer(ActorUniqueID(total.key)) : nullptr;
+        if (player) {
+            const auto& name = player->getRealName();
+            appendFormatted(text, "\n  {} ({}): {}", {std::string_view(name), total.key, total.count});
+        } else {
+            appendFormatted(text, "\n  player {}: {}", {total.key, total.count});
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Render the players whose interactions the auto-clicker detector is dropping
+ */
+void renderFlagged(std::string& text) {
+    const auto& detector = PotatoBoneMealBlocker::getInstance().getClickRateDetector();
+    const auto& settings = detector.getSettings();
+    appendFormatted(
+        text,
+        "Auto-clicker detection {}: {} blocked attempts within {} ms, {} ms cool-down",
+        {std::string_view(settings.enabled ? "on" : "off"),
+         settings.maxAttempts,
+         settings.window.count(),
+         settings.cooldown.count()}
+    );
+
+    // Same clock as the handler's cool-down deadlines
+    const auto nowMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+                           std::chrono::steady_clock::now().time_since_epoch()
+    )
+                           .count();
+    auto        level   = ll::service::getLevel();
+    std::size_t flagged = 0;
+    detector.forEachFlagged(nowMs, [&](std::int64_t playerId, std::int64_t remainingMs, std::uint32_t dropped) {
+        ++flagged;
+        const auto* player = level ? level->getPlayer(ActorUniqueID(playerId)) : nullptr;
+        if (player) {
+            appendFormatted(text, "\n  {}", {std::string_view(player->getRealName())});
+        } else {
+            appendFormatted(text, "\n  player {}", {playerId});
+        }
+        appendFormatted(text, ": {} interactions dropped, {} ms left", {dropped, remainingMs});
+    });
+    if (flagged == 0) {
+        text += "\n  no players flagged";
+    }
+}
+
+/// Disagreements listed by /potatoblocker shadow
+constexpr std::size_t SHADOW_LIMIT = 8;
+
+/**
+ * @brief Append a fraction as a percentage with two decimals
+ */
+void appendPercent(std::string& text, double fraction) {
+    char       buffer[32];
+    const auto result = std::to_chars(buffer, buffer + sizeof(buffer), fraction * 100.0, std::chars_format::fixed, 2);
+    text.append(buffer, static_cast<std::size_t>(result.ptr - buffer));
+    text += '%';
+}
+
+/**
+ * @brief Render the shadow-mode comparison of the candidate rules with the live rules
+ */
+void renderShadow(std::string& text) {
+    const auto& shadow = PotatoBoneMealBlocker::getInstance().getShadowEvaluator();
+    if (!shadow.isEnabled()) {
+        text = "Shadow mode is off; set shadow.enabled and the candidate rules in the configuration";
+        return;
+    }
+    const auto summary = shadow.summarize(SHADOW_LIMIT);
+    appendFormatted(
+        text,
+        "Shadow mode: {} of {} interactions sampled (1 in {}), {} without a block reference; overhead ",
+        {summary.samples, summary.events, summary.interval, summary.skipped}
+    );
+    appendPercent(text, summary.overhead);
+    text += " of handler time, limit ";
+    appendPercent(text, shadow.getSettings().maxOverhead);
+    appendFormatted(
+        text,
+        "\n  {} agree, {} blocked only by the live rules, {} blocked only by the candidate",
+        {summary.agreed, summary.liveOnly, summary.candidateOnly}
+    );
+    appendFormatted(
+        text,
+        "\n  candidate cost over the last {} samples: p50 {} ns, p99 {} ns, max {} ns",
+        {summary.ringSamples, summary.costP50Ns, summary.costP99Ns, summary.costMaxNs}
+    );
+
+    // Same clock as the samples
+    const auto nowMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+                           std::chrono::steady_clock::now().time_since_epoch()
+    )
+                           .count();
+    for (const auto& sample : summary.disagreements) {
+        appendFormatted(
+            text,
+            "\n  {} s ago, dimension {} at {} {} {}: item {} on block state {}, live {}, candidate {}",
+            {(nowMs - sample.timeMs) / 1000,
+             sample.dimension,
+             sample.x,
+             sample.y,
+             sample.z,
+             sample.itemId,
+             sample.runtimeId,
+             std::string_view(sample.live ? "blocks" : "allows"),
+             std::string_view(sample.candidate ? "blocks" : "allows")}
+        );
+    }
+}
+
+/**
+ * @brief Render a finished crop census
+ */
+void renderCensus(const CropCensus::Report& report, std::string& text) {
+    if (!report.error.empty()) {
+        appendFormatted(text, "Crop census failed: {}", {std::string_view(report.error)});
+        return;
+    }
+    appendFormatted(
+        text,
+        "Crop census: {} crops in {} of {} chunks ({} subchunks copied over {} ticks, {} skipped by palette; "
+        "counted by {} workers in {} us)",
+        {report.total,
+         report.chunksWithCrops,
+         report.chunks,
+         report.subchunks,
+         report.snapshotTicks,
+         report.skippedSubchunks,
+         report.workers,
+         report.countTime.count()}
+    );
+    for (std::size_t stage = 0; stage < report.byStage.size(); ++stage) {
+        if (report.byStage[stage] > 0) {
+            appendFormatted(text, "\n  growth stage {}: {}", {stage, report.byStage[stage]});
+        }
+    }
+    for (const auto& chunk : report.topChunks) {
+        appendFormatted(
+            text,
+            "\n  dimension {} chunk {} {} (x {}, z {}): {}",
+            {chunk.dimension, chunk.chunkX, chunk.chunkZ, chunk.chunkX * 16, chunk.chunkZ * 16, chunk.crops}
+        );
+    }
+}
+
+/**
+ * @brief Deliver a census report to the server log and every online game director
+ *
+ * The command's output is gone by the time the report is ready, so whoever
+ * could have run the command gets it in chat.
+ */
+void deliverCensus(const CropCensus::Report& report) {
+    std::string text;
+    renderCensus(report, text);
+    auto& plugin = PotatoBoneMealBlocker::getInstance();
+    for (std::string_view rest = text; !rest.empty();) {
+        const auto end = rest.find('\n');
+        plugin.getSelf().getLogger().info(rest.substr(0, end));
+        rest.remove_prefix(end == std::string_view::npos ? rest.size() : end + 1);
+    }
+    if (auto level = ll::service::getLevel()) {
+        level->forEachPlayer([&](Player& player) {
+            if (player.getCommandPermissionLevel() >= CommandPermissionLevel::GameDirectors) {
+                player.sendMessage(text);
+            }
+            return true;
+        });
+    }
+}
+
+} // namespace
+
+void registerCommands() {
+    static bool registered = false;
+    if (registered) {
+        return;
+    }
+    registered = true;
+
+    auto& command = ll::command::CommandRegistrar::getInstance().getOrCreateCommand(
+        "potatoblocker",
+        "Potato Bone Meal Blocker administration",
+        CommandPermissionLevel::GameDirectors
+    );
+
+    // /potatoblocker stats - handler counters and latency quantiles
+    command.overload().text("stats").execute([](CommandOrigin const&, CommandOutput& output) {
+        std::string text;
+        auto&       plugin   = PotatoBoneMealBlocker::getInstance();
+        const auto& governor = plugin.getGrowthGovernor();
+        const auto& stats    = plugin.getBlockedStats();
+        appendFormatted(
+            text,
+            "blocked: {} (lifetime {})\n",
+            {plugin.getBlockedCount(), plugin.getLifetimeBlockedCount()}
+        );
+        appendFormatted(
+            text,
+            "stats: {} keys in memory, {} records written, {} keys evicted, {} updates dropped\n",
+            {stats.getTrackedKeys(), stats.getWrittenRecords(), stats.getEvictedKeys(), stats.getDroppedCount()}
+        );
+        appendFormatted(
+            text,
+            "config: {} rules, snapshot generation {}, {} retired\n",
+            {plugin.getRules().size(),
+             plugin.getRuleSnapshots().getGeneration(),
+             plugin.getRuleSnapshots().getRetiredCount()}
+        );
+        appendFormatted(text, "bypass: {} players cached\n", {plugin.getBypassCache().size()});
+        appendFormatted(
+            text,
+            "interaction listener: {}, {} players holding bone meal, {} subscriptions\n",
+            {std::string_view(plugin.isInteractListenerRegistered() ? "registered" : "unregistered"),
+             plugin.getHeldItemTracker().getHolderCount(),
+             plugin.getInteractSubscriptions()}
+        );
+        appendFormatted(
+            text,
+            "click rate: {} players tracked, {} flagged, {} interactions dropped\n",
+            {plugin.getClickRateDetector().getTrackedPlayers(),
+             plugin.getClickRateDetector().getFlagCount(),
+             plugin.getClickRateDetector().getDroppedCount()}
+        );
+        appendFormatted(
+            text,
+            "growth: {}, {} crops tracked in {} chunks, {} ticks suppressed, {} allowed\n",
+            {GrowthGovernor::modeName(governor.getMode()),
+             governor.getTrackedCrops(),
+             governor.getTrackedChunks(),
+             governor.getSuppressedTicks(),
+             governor.getAllowedTicks()}
+        );
+        const auto& breaker = plugin.getFaultBreaker();
+        appendFormatted(
+            text,
+            "faults: {} block lookup, {} feedback, {} out of memory, {} exceptions; breaker {}, tripped {} times\n",
+            {breaker.getCount(HandlerFault::BLOCK_LOOKUP),
+             breaker.getCount(HandlerFault::FEEDBACK),
+             breaker.getCount(HandlerFault::OUT_OF_MEMORY),
+             breaker.getCount(HandlerFault::EXCEPTION),
+             std::string_view(breaker.isOpen() ? "open" : "closed"),
+             breaker.getTripCount()}
+        );
+        const auto& pipeline = plugin.getGrowthPipeline();
+        appendFormatted(
+            text,
+            "fertilizer hook {}: {} non-player attempts blocked, {} allowed\n",
+            {std::string_view(pipeline.isAttached() ? "on" : "off"),
+             pipeline.getBlockedCount(),
+             pipeline.getAllowedCount()}
+        );
+        const auto& blockCache = plugin.getBlockLookupCache();
+        appendFormatted(
+            text,
+            "block lookup cache: {} hits, {} misses, {} entries dropped by block changes\n",
+            {blockCache.getHitCount(), blockCache.getMissCount(), blockCache.getInvalidationCount()}
+        );
+        const auto& schedule = plugin.getSchedule();
+        if (!schedule.getPolicies().empty()) {
+            const auto* active = schedule.getActive();
+            appendFormatted(
+                text,
+                "schedule in force: {}; {} configured, {} switches",
+                {std::string_view(active ? active->name : "none, top-level rules apply"),
+                 schedule.getPolicies().size(),
+                 schedule.getChangeCount()}
+            );
+            if (const auto next = schedule.secondsUntilNextCheck(plugin.getScheduleClock())) {
+                appendFormatted(text, ", next check in {} s", {*next});
+            }
+            text += '\n';
+        }
+        const auto& share = plugin.getHostShare();
+        if (share.isOpen()) {
+            const auto totals = share.getTotals(
+                std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::system_clock::now().time_since_epoch()
+                )
+                    .count()
+            );
+            appendFormatted(
+                text,
+                "host share {}: {} instances, {} attempts blocked host-wide ({} non-player), config generation {}\n",
+                {std::string_view(share.getName()),
+                 totals.instances,
+                 totals.blocked,
+                 totals.fertilizerBlocked,
+                 share.getConfigGeneration()}
+            );
+        }
+        metrics::renderSummary(text);
+        outputLines(output, text);
+    });
+
+    // /potatoblocker reload - re-read the config file now instead of waiting for the watcher
+    command.overload().text("reload").execute([](CommandOrigin const&, CommandOutput& output) {
+        auto& plugin = PotatoBoneMealBlocker::getInstance();
+        if (!plugin.reloadConfig()) {
+            output.error("Configuration not reloaded, see the server log");
+            return;
+        }
+        std::string text;
+        appendFormatted(text, "Configuration reloaded: {} rules", {plugin.getRules().size()});
+        output.success(text);
+    });
+
+    // /potatoblocker top players|chunks - where bone meal is blocked most, from the statistics file
+    for (const auto kind : {StatsKind::PLAYER, StatsKind::CHUNK}) {
+        command.overload()
+            .text("top")
+            .text(kind == StatsKind::PLAYER ? "players" : "chunks")
+            .execute([kind](CommandOrigin const&, CommandOutput& output) {
+                std::string text;
+                if (!renderTop(kind, text)) {
+                    output.error(text);
+                    return;
+                }
+                outputLines(output, text);
+            });
+    }
+
+    // /potatoblocker flagged - players whose interactions are dropped by the auto-clicker detector
+    command.overload().text("flagged").execute([](CommandOrigin const&, CommandOutput& output) {
+        std::string text;
+        renderFlagged(text);
+        outputLines(output, text);
+    });
+
+    // /potatoblocker shadow - how the shadow-mode candidate rules would have decided
+    command.overload().text("shadow").execute([](CommandOrigin const&, CommandOutput& output) {
+        std::string text;
+        renderShadow(text);
+        outputLines(output, text);
+    });
+
+    // /potatoblocker breaker reset - evaluate interactions again after the fault breaker tripped
+    command.overload().text("breaker").text("reset").execute([](CommandOrigin const&, CommandOutput& output) {
+        if (!PotatoBoneMealBlocker::getInstance().resetFaultBreaker()) {
+            output.error("The fault breaker is not open");
+            return;
+        }
+        output.success("Fault breaker reset, bone meal interactions are evaluated again");
+    });
+
+    // /potatoblocker census - count the rules' crops around the players; the report follows a few ticks later
+    command.overload().text("census").execute([](CommandOrigin const&, CommandOutput& output) {
+        auto& plugin = PotatoBoneMealBlocker::getInstance();
+        if (plugin.getCropCensus().isRunning()) {
+            const auto [copied, total] = plugin.getCropCensus().getProgress();
+            std::string text;
+            appendFormatted(text, "A census is already running: {} of {} subchunks copied", {copied, total});
+            output.error(text);
+            return;
+        }
+        const auto chunks = plugin.startCensus([](const CropCensus::Report& report) { deliverCensus(report); });
+        if (chunks == 0) {
+            output.error("No census started: no players online or no crop in the rules could be resolved");
+            return;
+        }
+        std::string text;
+        appendFormatted(text, "Counting crops in {} chunks around the online players, the report follows", {chunks});
+        output.success(text);
+    });
+
+    // /potatoblocker growth off|block|throttle - random-tick growth of the rules' crops
+    for (const auto mode : {GrowthGovernor::Mode::OFF, GrowthGovernor::Mode::BLOCK, GrowthGovernor::Mode::THROTTLE}) {
+        command.overload()
+            .text("growth")
+            .text(GrowthGovernor::modeName(mode))
+            .execute([mode](CommandOrigin const&, CommandOutput& output) {
+                if (!PotatoBoneMealBlocker::getInstance().setGrowthMode(mode)) {
+                    output.error("Could not change the growth mode, see the server log");
+                    return;
+                }
+                output.success("Crop growth mode: " + std::string(GrowthGovernor::modeName(mode)));
+            });
+    }
+
+    // /potatoblocker trace start|stop - capture interactions for offline replay
+    command.overload().text("trace").text("start").execute([](CommandOrigin const&, CommandOutput& output) {
+        auto& plugin = PotatoBoneMealBlocker::getInstance();
+        if (plugin.getTraceWriter().isCapturing()) {
+            output.error("A capture is already running: " + plugin.getTraceWriter().getPath().string());
+            return;
+        }
+
+        const auto epochMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+                                 std::chrono::system_clock::now().time_since_epoch()
+        )
+                                 .count();
+        std::string fileName;
+        appendFormatted(fileName, "trace-{}.pbbt", {epochMs});
+        const auto path = plugin.getSelf().getDataDir() / "traces" / fileName;
+        if (!plugin.startCapture(path)) {
+            output.error("Could not start the capture, see the server log");
+            return;
+        }
+        output.success("Capturing interactions to " + path.string());
+    });
+
+    command.overload().text("trace").text("stop").execute([](CommandOrigin const&, CommandOutput& output) {
+        auto& plugin = PotatoBoneMealBlocker::getInstance();
+        if (!plugin.getTraceWriter().isCapturing()) {
+            output.error("No capture is running");
+            return;
+        }
+        plugin.stopCapture();
+
+        const auto& writer = plugin.getTraceWriter();
+        const auto  path   = writer.getPath().string();
+        std::string text;
+        appendFormatted(
+            text,
+            "Trace {}: {} records written, {} dropped",
+            {std::string_view(path), writer.getWrittenCount(), writer.getDroppedCount()}
+        );
+        output.success(text);
+    });
+}
+
+} // namespace potato_bonemeal_blocker
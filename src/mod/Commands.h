@@ -0,0 +1,13 @@
+#pragma once
+
+namespace potato_bonemeal_blocker {
+
+/**
+ * @brief Register the /potatoblocker admin command and its subcommands
+ *
+ * Commands cannot be unregistered, so this only registers them the first
+ * time it is called; later calls after a disable/enable cycle are no-ops.
+ */
+void registerCommands();
+
+} // namespace potato_bonemeal_blocker
@@ -0,0 +1,471 @@
+#include "mod/Config.h"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <optional>
+
+namespace potato_bonemeal_blocker {
+
+namespace {
+
+using nlohmann::json;
+
+std::optional<GrowthGovernor::Mode> parseGrowthMode(std::string_view name) noexcept {
+    for (const auto mode : {GrowthGovernor::Mode::OFF, GrowthGovernor::Mode::BLOCK, GrowthGovernor::Mode::THROTTLE}) {
+        if (GrowthGovernor::modeName(mode) == name) {
+            return mode;
+        }
+    }
+    return std::nullopt;
+}
+
+std::optional<AsyncLogSink::OverflowPolicy> parseOverflowPolicy(std::string_view name) noexcept {
+    for (const auto policy : {AsyncLogSink::OverflowPolicy::DROP, AsyncLogSink::OverflowPolicy::SAMPLE}) {
+        if (AsyncLogSink::policyName(policy) == name) {
+            return policy;
+        }
+    }
+    return std::nullopt;
+}
+
+/**
+ * @brief Copy an optional member into a value, leaving the value as is if the key is absent
+ */
+template <typename T>
+void readOptional(const json& object, const char* key, T& value) {
+    if (const auto it = object.find(key); it != object.end()) {
+        value = it->get<T>();
+    }
+}
+
+/**
+ * @brief Parse a rule array into rules
+ * @return false with error set if a rule is invalid
+ */
+bool parseRules(const json& array, std::vector<GrowthRule>& rules, std::string& error) {
+    rules.clear();
+    for (const auto& entry : array.get_ref<const json::array_t&>()) {
+        GrowthRule rule;
+        rule.itemName    = entry.at("item").get<std::string>();
+        rule.blockName   = entry.at("block").get<std::string>();
+        const auto stage = entry.value("min_growth_stage", 0u);
+        if (stage > RuleMatcher::MAX_GROWTH_STAGE) {
+            error = "min_growth_stage of " + rule.blockName + " is above 15";
+            return false;
+        }
+        rule.minGrowthStage = static_cast<std::uint8_t>(stage);
+        rules.push_back(std::move(rule));
+    }
+    return true;
+}
+
+json renderRules(const std::vector<GrowthRule>& rules) {
+    auto array = json::array();
+    for (const auto& rule : rules) {
+        array.push_back({
+            {"item",             rule.itemName      },
+            {"block",            rule.blockName     },
+            {"min_growth_stage", rule.minGrowthStage}
+        });
+    }
+    return array;
+}
+
+/**
+ * @brief Parse one region; corners may be given in any order
+ */
+bool parseRegion(const json& entry, RegionConfig& region, std::string& error) {
+    region.name          = entry.value("name", std::string());
+    region.box.dimension = entry.value("dimension", 0);
+    region.priority      = entry.value("priority", 0);
+
+    const auto from = entry.at("from").get<std::array<int, 3>>();
+    const auto to   = entry.at("to").get<std::array<int, 3>>();
+    region.box.minX = std::min(from[0], to[0]);
+    region.box.minY = std::min(from[1], to[1]);
+    region.box.minZ = std::min(from[2], to[2]);
+    region.box.maxX = std::max(from[0], to[0]);
+    region.box.maxY = std::max(from[1], to[1]);
+    region.box.maxZ = std::max(from[2], to[2]);
+
+    if (const auto it = entry.find("rules"); it != entry.end()) {
+        if (!parseRules(*it, region.rules, error)) {
+            error = "region " + region.name + ": " + error;
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Parse a region array into regions
+ */
+bool parseRegions(const json& array, std::vector<RegionConfig>& regions, std::string& error) {
+    regions.clear();
+    for (const auto& entry : array.get_ref<const json::array_t&>()) {
+        RegionConfig region;
+        if (!parseRegion(entry, region, error)) {
+            return false;
+        }
+        regions.push_back(std::move(region));
+    }
+    return true;
+}
+
+json renderRegions(const std::vector<RegionConfig>& regions) {
+    auto array = json::array();
+    for (const auto& region : regions) {
+        const auto& box = region.box;
+        array.push_back({
+            {"name",      region.name                   },
+            {"dimension", box.dimension                 },
+            {"from",      {box.minX, box.minY, box.minZ}},
+            {"to",        {box.maxX, box.maxY, box.maxZ}},
+            {"priority",  region.priority               },
+            {"rules",     renderRules(region.rules)     }
+        });
+    }
+    return array;
+}
+
+/**
+ * @brief Parse one scheduled policy
+ */
+bool parsePolicy(const json& entry, PolicySchedule::Policy& policy, std::string& error) {
+    policy.name = entry.value("name", std::string());
+    readOptional(entry, "minutes", policy.minutes);
+    if (policy.minutes < 1 || policy.minutes > PolicySchedule::WEEK_SECONDS / 60) {
+        error = "schedule " + policy.name + ": minutes must be between 1 and 10080";
+        return false;
+    }
+
+    const auto start      = entry.find("start");
+    const auto afterStart = entry.find("after_start_minutes");
+    if ((start == entry.end()) == (afterStart == entry.end())) {
+        error = "schedule " + policy.name + ": set either start or after_start_minutes";
+        return false;
+    }
+    if (afterStart != entry.end()) {
+        policy.afterStartMinutes = afterStart->get<std::int32_t>();
+        if (policy.afterStartMinutes < 0) {
+            error = "schedule " + policy.name + ": after_start_minutes must not be negative";
+            return false;
+        }
+    } else {
+        const auto text   = start->get<std::string>();
+        int        hour   = -1;
+        int        minute = -1;
+        if (text.size() == 5 && text[2] == ':') {
+            std::from_chars(text.data(), text.data() + 2, hour);
+            std::from_chars(text.data() + 3, text.data() + 5, minute);
+        }
+        if (hour < 0 || hour > 23 || minute < 0 || minute > 59) {
+            error = "schedule " + policy.name + ": start must be HH:MM";
+            return false;
+        }
+        policy.startMinute = hour * 60 + minute;
+        for (const auto& day : entry.value("days", std::vector<std::string>())) {
+            const auto parsed = PolicySchedule::parseDay(day);
+            if (!parsed) {
+                error = "schedule " + policy.name + ": unknown day " + day;
+                return false;
+            }
+            policy.days.push_back(*parsed);
+        }
+    }
+
+    if (const auto it = entry.find("rules"); it != entry.end()) {
+        if (!parseRules(*it, policy.rules, error)) {
+            error = "schedule " + policy.name + ": " + error;
+            return false;
+        }
+    }
+    return true;
+}
+
+json renderPolicies(const std::vector<PolicySchedule::Policy>& policies) {
+    auto array = json::array();
+    for (const auto& policy : policies) {
+        json entry = {
+            {"name",    policy.name              },
+            {"minutes", policy.minutes           },
+            {"rules",   renderRules(policy.rules)}
+        };
+        if (policy.afterStartMinutes >= 0) {
+            entry["after_start_minutes"] = policy.afterStartMinutes;
+        } else {
+            char start[16];
+            std::snprintf(start, sizeof(start), "%02d:%02d", policy.startMinute / 60, policy.startMinute % 60);
+            entry["start"] = start;
+            entry["days"]  = json::array();
+            for (const auto day : policy.days) {
+                entry["days"].push_back(PolicySchedule::dayName(day));
+            }
+        }
+        array.push_back(std::move(entry));
+    }
+    return array;
+}
+
+} // namespace
+
+bool parseConfig(std::string_view text, PluginConfig& config, std::string& error) {
+    try {
+        const auto document = json::parse(text);
+        if (!document.is_object()) {
+            error = "top level is not an object";
+            return false;
+        }
+
+        // Parse into a copy so a broken document leaves the current configuration untouched
+        PluginConfig parsed = config;
+        readOptional(document, "version", parsed.version);
+        if (parsed.version > PluginConfig::CURRENT_VERSION) {
+            error = "unsupported config version " + std::to_string(parsed.version);
+            return false;
+        }
+
+        if (const auto it = document.find("language"); it != document.end()) {
+            readOptional(*it, "code", parsed.language);
+        }
+        if (const auto it = document.find("messages"); it != document.end()) {
+            readOptional(*it, "show_info_message", parsed.showInfoMessage);
+        }
+        if (const auto it = document.find("logging"); it != document.end()) {
+            readOptional(*it, "log_blocked_attempts", parsed.logBlockedAttempts);
+            if (const auto policyIt = it->find("overflow_policy"); policyIt != it->end()) {
+                const auto policy = parseOverflowPolicy(policyIt->get<std::string>());
+                if (!policy) {
+                    error = "logging.overflow_policy must be drop or sample";
+                    return false;
+                }
+                parsed.logSink.policy = *policy;
+            }
+            readOptional(*it, "sample_rate", parsed.logSink.sampleRate);
+            const auto rate = parsed.logSink.sampleRate;
+            if (rate < 1 || rate > AsyncLogSink::MAX_SAMPLE_RATE) {
+                error = "logging.sample_rate must be between 1 and 65536";
+                return false;
+            }
+            readOptional(*it, "queue_capacity", parsed.logSink.capacity);
+            const auto capacity = parsed.logSink.capacity;
+            if (capacity < AsyncLogSink::MIN_CAPACITY || capacity > AsyncLogSink::MAX_CAPACITY) {
+                error = "logging.queue_capacity must be between 16 and 1048576";
+                return false;
+            }
+        }
+
+        if (const auto it = document.find("rules"); it != document.end()) {
+            if (!parseRules(*it, parsed.rules, error)) {
+                return false;
+            }
+        }
+        if (const auto it = document.find("regions"); it != document.end()) {
+            if (!parseRegions(*it, parsed.regions, error)) {
+                return false;
+            }
+        }
+
+        if (const auto it = document.find("schedules"); it != document.end()) {
+            parsed.schedules.clear();
+            for (const auto& entry : it->get_ref<const json::array_t&>()) {
+                if (parsed.schedules.size() == PolicySchedule::MAX_POLICIES) {
+                    error = "at most 64 schedules are supported";
+                    return false;
+                }
+                PolicySchedule::Policy policy;
+                if (!parsePolicy(entry, policy, error)) {
+                    return false;
+                }
+                parsed.schedules.push_back(std::move(policy));
+            }
+        }
+
+        if (const auto it = document.find("bypass"); it != document.end()) {
+            readOptional(*it, "operators", parsed.bypass.operators);
+            readOptional(*it, "players", parsed.bypass.players);
+        }
+
+        if (const auto it = document.find("feedback"); it != document.end()) {
+            readOptional(*it, "burst", parsed.feedback.burst);
+            readOptional(*it, "refill_per_second", parsed.feedback.refillPerSecond);
+            if (const auto window = it->find("summary_window_ms"); window != it->end()) {
+                parsed.feedback.summaryWindow = std::chrono::milliseconds(window->get<std::int64_t>());
+            }
+        }
+
+        if (const auto it = document.find("stats"); it != document.end()) {
+            if (const auto interval = it->find("flush_interval_seconds"); interval != it->end()) {
+                const auto seconds         = std::max<std::int64_t>(interval->get<std::int64_t>(), 1);
+                parsed.stats.flushInterval = std::chrono::seconds(seconds);
+            }
+            readOptional(*it, "max_keys", parsed.stats.maxKeys);
+            const auto keys = parsed.stats.maxKeys;
+            if (keys < BlockedStats::MIN_KEYS || keys > BlockedStats::MAX_KEYS) {
+                error = "stats.max_keys must be between 1024 and 16777216";
+                return false;
+            }
+        }
+
+        if (const auto it = document.find("click_rate"); it != document.end()) {
+            readOptional(*it, "enabled", parsed.clickRate.enabled);
+            readOptional(*it, "max_attempts", parsed.clickRate.maxAttempts);
+            const auto attempts = parsed.clickRate.maxAttempts;
+            if (attempts < 2 || attempts > ClickRateDetector::RING_CAPACITY) {
+                error = "click_rate.max_attempts must be between 2 and 32";
+                return false;
+            }
+            if (const auto window = it->find("window_ms"); window != it->end()) {
+                parsed.clickRate.window = std::chrono::milliseconds(window->get<std::int64_t>());
+            }
+            if (const auto cooldown = it->find("cooldown_ms"); cooldown != it->end()) {
+                parsed.clickRate.cooldown = std::chrono::milliseconds(cooldown->get<std::int64_t>());
+            }
+        }
+
+        if (const auto it = document.find("fault_breaker"); it != document.end()) {
+            readOptional(*it, "enabled", parsed.faultBreaker.enabled);
+            readOptional(*it, "budget", parsed.faultBreaker.budget);
+            const auto budget = parsed.faultBreaker.budget;
+            if (budget < 1 || budget > FaultBreaker::MAX_BUDGET) {
+                error = "fault_breaker.budget must be between 1 and 256";
+                return false;
+            }
+            if (const auto window = it->find("window_ms"); window != it->end()) {
+                parsed.faultBreaker.window = std::chrono::milliseconds(window->get<std::int64_t>());
+            }
+        }
+
+        if (const auto it = document.find("shadow"); it != document.end()) {
+            readOptional(*it, "enabled", parsed.shadow.enabled);
+            readOptional(*it, "sample_interval", parsed.shadow.sampleInterval);
+            readOptional(*it, "max_overhead", parsed.shadow.maxOverhead);
+            const auto interval = parsed.shadow.sampleInterval;
+            if (interval < 1 || interval > ShadowEvaluator::MAX_SAMPLE_INTERVAL) {
+                error = "shadow.sample_interval must be between 1 and 65536";
+                return false;
+            }
+            if (!(parsed.shadow.maxOverhead > 0.0 && parsed.shadow.maxOverhead <= 1.0)) {
+                error = "shadow.max_overhead must be greater than 0 and at most 1";
+                return false;
+            }
+            if (const auto rules = it->find("rules"); rules != it->end()) {
+                if (!parseRules(*rules, parsed.shadowRules, error)) {
+                    error = "shadow: " + error;
+                    return false;
+                }
+            }
+            if (const auto regions = it->find("regions"); regions != it->end()) {
+                if (!parseRegions(*regions, parsed.shadowRegions, error)) {
+                    error = "shadow: " + error;
+                    return false;
+                }
+            }
+        }
+
+        if (const auto it = document.find("host_share"); it != document.end()) {
+            readOptional(*it, "enabled", parsed.hostShare.enabled);
+            readOptional(*it, "name", parsed.hostShare.name);
+            if (!SharedMemory::isValidName(parsed.hostShare.name)) {
+                error = "host_share.name must be 1 to 64 letters, digits, '-' or '_'";
+                return false;
+            }
+        }
+
+        if (const auto it = document.find("growth"); it != document.end()) {
+            if (const auto modeIt = it->find("mode"); modeIt != it->end()) {
+                const auto mode = parseGrowthMode(modeIt->get<std::string>());
+                if (!mode) {
+                    error = "growth.mode must be off, block or throttle";
+                    return false;
+                }
+                parsed.growthMode = *mode;
+            }
+            readOptional(*it, "throttle_factor", parsed.growthThrottleFactor);
+        }
+
+        config = std::move(parsed);
+        return true;
+    } catch (const std::exception& e) {
+        error = e.what();
+        return false;
+    }
+}
+
+std::string renderConfig(const PluginConfig& config) {
+    json document;
+    document["version"]                         = config.version;
+    document["language"]["code"]                = config.language;
+    document["messages"]["show_info_message"]   = config.showInfoMessage;
+    document["logging"]["log_blocked_attempts"] = config.logBlockedAttempts;
+    document["logging"]["overflow_policy"]      = AsyncLogSink::policyName(config.logSink.policy);
+    document["logging"]["sample_rate"]          = config.logSink.sampleRate;
+    document["logging"]["queue_capacity"]       = config.logSink.capacity;
+    document["rules"]                           = renderRules(config.rules);
+    document["bypass"]["operators"]             = config.bypass.operators;
+    document["bypass"]["players"]               = config.bypass.players;
+    document["feedback"]["burst"]               = config.feedback.burst;
+    document["feedback"]["refill_per_second"]   = config.feedback.refillPerSecond;
+    document["feedback"]["summary_window_ms"]   = config.feedback.summaryWindow.count();
+    document["stats"]["flush_interval_seconds"] = config.stats.flushInterval.count();
+    document["stats"]["max_keys"]               = config.stats.maxKeys;
+    document["click_rate"]["enabled"]           = config.clickRate.enabled;
+    document["click_rate"]["max_attempts"]      = config.clickRate.maxAttempts;
+    document["click_rate"]["window_ms"]         = config.clickRate.window.count();
+    document["click_rate"]["cooldown_ms"]       = config.clickRate.cooldown.count();
+    document["fault_breaker"]["enabled"]        = config.faultBreaker.enabled;
+    document["fault_breaker"]["budget"]         = config.faultBreaker.budget;
+    document["fault_breaker"]["window_ms"]      = config.faultBreaker.window.count();
+    document["shadow"]["enabled"]               = config.shadow.enabled;
+    document["shadow"]["sample_interval"]       = config.shadow.sampleInterval;
+    document["shadow"]["max_overhead"]          = config.shadow.maxOverhead;
+    document["shadow"]["rules"]                 = renderRules(config.shadowRules);
+    document["shadow"]["regions"]               = renderRegions(config.shadowRegions);
+    document["host_share"]["enabled"]           = config.hostShare.enabled;
+    document["host_share"]["name"]              = config.hostShare.name;
+    document["growth"]["mode"]                  = GrowthGovernor::modeName(config.growthMode);
+    document["growth"]["throttle_factor"]       = config.growthThrottleFactor;
+    document["regions"]                         = renderRegions(config.regions);
+    document["schedules"]                       = renderPolicies(config.schedules);
+    return document.dump(4) + '\n';
+}
+
+bool loadConfig(const std::filesystem::path& path, PluginConfig& config, std::string& error) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        std::error_code ec;
+        if (std::filesystem::exists(path, ec)) {
+            error = "cannot read " + path.string();
+            return false;
+        }
+        // First start: write the defaults as a template for operators
+        if (!saveConfig(path, config)) {
+            error = "cannot create " + path.string();
+            return false;
+        }
+        return true;
+    }
+
+    const std::string text{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+    return parseConfig(text, config, error);
+}
+
+bool saveConfig(const std::filesystem::path& path, const PluginConfig& config) {
+    try {
+        std::filesystem::create_directories(path.parent_path());
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file << renderConfig(config);
+        return static_cast<bool>(file);
+    } catch (...) {
+        return false;
+    }
+}
+
+} // namespace potato_bonemeal_blocker
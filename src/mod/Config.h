@@ -0,0 +1,138 @@
+#pragma once
+
+#include "AsyncLogSink.h"
+#include "BlockedStats.h"
+#include "BypassCache.h"
+#include "ClickRateDetector.h"
+#include "FaultBreaker.h"
+#include "FeedbackLimiter.h"
+#include "GrowthGovernor.h"
+#include "HostShare.h"
+#include "Language.h"
+#include "PolicySchedule.h"
+#include "RegionIndex.h"
+#include "RuleMatcher.h"
+#include "ShadowEvaluator.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace potato_bonemeal_blocker {
+
+/**
+ * @brief An area whose rule list replaces the global rules, e.g. spawn or a market
+ */
+struct RegionConfig {
+    std::string             name;
+    RegionBox               box;          ///< Dimension and inclusive block bounds
+    std::int32_t            priority = 0; ///< Higher wins where regions overlap
+    std::vector<GrowthRule> rules;        ///< Empty: nothing is blocked inside the region
+
+    bool operator==(const RegionConfig&) const = default;
+};
+
+/**
+ * @brief Contents of `potato-bonemeal-blocker.json` in the plugin config directory
+ *
+ * Every key is optional; missing keys keep the defaults below.
+ */
+struct PluginConfig {
+    static constexpr int CURRENT_VERSION = 1;
+
+    int                                 version            = CURRENT_VERSION;
+    std::string                         language           = "zh_CN"; ///< Locale tag of a loaded .lang file
+    bool                                showInfoMessage    = true;    ///< Send the info line after the blocked message
+    bool                                logBlockedAttempts = true;    ///< Queue blocked attempts for the log sink
+    AsyncLogSink::Settings              logSink;                      ///< Queue size and overflow policy of the sink
+    std::vector<GrowthRule>             rules{GrowthRule{"minecraft:bone_meal", "minecraft:potatoes", 0}};
+    std::vector<RegionConfig>           regions;
+    std::vector<PolicySchedule::Policy> schedules; ///< Time-boxed replacements for `rules`, first open one wins
+    BypassCache::Settings               bypass;
+    FeedbackLimiter::Settings           feedback;
+    BlockedStats::Settings              stats;
+    ClickRateDetector::Settings         clickRate;
+    FaultBreaker::Settings              faultBreaker;
+    ShadowEvaluator::Settings           shadow;
+    std::vector<GrowthRule>             shadowRules;   ///< Candidate rules evaluated in shadow mode, never enforced
+    std::vector<RegionConfig>           shadowRegions; ///< Candidate regions, same semantics as `regions`
+    HostShare::Settings                 hostShare;     ///< Local only: never taken from a shared configuration
+    GrowthGovernor::Mode                growthMode           = GrowthGovernor::Mode::OFF;
+    std::uint32_t                       growthThrottleFactor = GrowthGovernor::DEFAULT_THROTTLE_FACTOR;
+};
+
+/**
+ * @brief Immutable, compiled form of a PluginConfig read by the event handler
+ *
+ * Built on the server thread whenever the configuration is (re)loaded and
+ * published through a SnapshotCell; never modified afterwards.
+ */
+struct RuleSnapshot {
+    RuleMatcher              matcher;     ///< Global rules resolved to numeric IDs
+    RuleMatcher              itemFilter;  ///< Global and region rules together; only built when regions exist
+    std::vector<RuleMatcher> regionRules; ///< Distinct region rule lists, shared by regions with equal rules
+    RegionIndex              regions;     ///< Position -> index into regionRules
+    Language::LanguageCode   language = Language::LanguageCode::CHINESE_SIMPLIFIED;
+    bool                     showInfoMessage    = true;
+    bool                     logBlockedAttempts = true;
+    std::optional<std::int16_t> fertilizerItemId; ///< Bone meal; the item judged for dispensers and other sources
+    std::unique_ptr<const RuleSnapshot> shadow;   ///< Candidate rules compiled for shadow mode; nullptr when off
+
+    /**
+     * @brief Check whether any rule, global or regional, uses an item
+     * @param itemId The numeric item ID
+     * @return true if the interaction needs a closer look
+     */
+    [[nodiscard]] bool coversItem(std::int16_t itemId) const noexcept {
+        return regions.empty() ? matcher.matchesItem(itemId) : itemFilter.matchesItem(itemId);
+    }
+
+    /**
+     * @brief Get the rules in force at a block position
+     * @param dimension Dimension ID
+     * @return The winning region's rules, or the global rules outside every region
+     */
+    [[nodiscard]] const RuleMatcher& matcherAt(int dimension, int x, int y, int z) const noexcept {
+        const auto region = regions.find(dimension, x, y, z);
+        return region == RegionIndex::NO_REGION ? matcher : regionRules[region];
+    }
+};
+
+/**
+ * @brief Parse a configuration document
+ * @param text The JSON text
+ * @param config Receives the values present in the document; untouched on failure
+ * @param error Receives a description of the first problem on failure
+ * @return true if the document is valid
+ */
+bool parseConfig(std::string_view text, PluginConfig& config, std::string& error);
+
+/**
+ * @brief Render a configuration as a JSON document
+ * @param config The configuration
+ * @return Indented JSON text
+ */
+[[nodiscard]] std::string renderConfig(const PluginConfig& config);
+
+/**
+ * @brief Load the configuration file, writing the defaults if it does not exist yet
+ * @param path The configuration file
+ * @param config Receives the loaded values; untouched on failure
+ * @param error Receives a description of the problem on failure
+ * @return true if the configuration was loaded or created
+ */
+bool loadConfig(const std::filesystem::path& path, PluginConfig& config, std::string& error);
+
+/**
+ * @brief Write a configuration file
+ * @param path The configuration file
+ * @param config The configuration to write
+ * @return true if the file was written
+ */
+bool saveConfig(const std::filesystem::path& path, const PluginConfig& config);
+
+} // namespace potato_bonemeal_blocker
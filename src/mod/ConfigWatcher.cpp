@@ -0,0 +1,100 @@
+#include "mod/ConfigWatcher.h"
+
+#include <fstream>
+#include <iterator>
+#include <utility>
+
+namespace potato_bonemeal_blocker {
+
+void ConfigWatcher::start(std::filesystem::path path, std::chrono::milliseconds interval) {
+    if (mRunning.load()) {
+        return;
+    }
+    mPath     = std::move(path);
+    mInterval = interval;
+    markCurrent();
+
+    mRunning.store(true);
+    mThread = std::thread([this] {
+        auto nextCheck = std::chrono::steady_clock::now() + mInterval;
+        while (mRunning.load()) {
+            // Sleep in short steps so stop() does not wait for a whole interval
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            if (std::chrono::steady_clock::now() >= nextCheck) {
+                check();
+                nextCheck = std::chrono::steady_clock::now() + mInterval;
+            }
+        }
+    });
+}
+
+void ConfigWatcher::stop() noexcept {
+    if (!mRunning.exchange(false)) {
+        return;
+    }
+    if (mThread.joinable()) {
+        mThread.join();
+    }
+    std::lock_guard lock(mUpdateMutex);
+    mUpdate.reset();
+    mHasUpdate.store(false, std::memory_order_relaxed);
+}
+
+std::optional<ConfigWatcher::Update> ConfigWatcher::takeUpdate() {
+    if (!mHasUpdate.load(std::memory_order_relaxed)) [[likely]] {
+        return std::nullopt;
+    }
+    std::lock_guard lock(mUpdateMutex);
+    mHasUpdate.store(false, std::memory_order_relaxed);
+    return std::exchange(mUpdate, std::nullopt);
+}
+
+void ConfigWatcher::markCurrent() noexcept {
+    const auto stamp = readStamp();
+    std::lock_guard lock(mStampMutex);
+    mLoadedStamp = stamp;
+}
+
+ConfigWatcher::Stamp ConfigWatcher::readStamp() const noexcept {
+    Stamp           stamp;
+    std::error_code ec;
+    stamp.time = std::filesystem::last_write_time(mPath, ec);
+    stamp.size = ec ? 0 : std::filesystem::file_size(mPath, ec);
+    return stamp;
+}
+
+void ConfigWatcher::check() {
+    const auto stamp = readStamp();
+    {
+        std::lock_guard lock(mStampMutex);
+        if (stamp == mLoadedStamp) {
+            return;
+        }
+        // A rejected file is not parsed again until it changes once more
+        mLoadedStamp = stamp;
+    }
+
+    Update update;
+    try {
+        std::ifstream file(mPath, std::ios::binary);
+        if (!file) {
+            // Deleted or being replaced; keep the running configuration
+            return;
+        }
+        const std::string text{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+
+        // Keys missing from the file fall back to their defaults
+        PluginConfig config;
+        if (parseConfig(text, config, update.error)) {
+            update.config = std::move(config);
+        }
+    } catch (const std::exception& e) {
+        update.error = e.what();
+    }
+
+    std::lock_guard lock(mUpdateMutex);
+    mUpdate = std::move(update);
+    mHasUpdate.store(true, std::memory_order_relaxed);
+}
+
+} // namespace potato_bonemeal_blocker
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "Config.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+
+namespace potato_bonemeal_blocker {
+
+/**
+ * @brief Watches the configuration file and parses it off the server thread
+ *
+ * A background thread polls the file's modification time and size. When
+ * either changes the file is read and parsed there, and the result is left
+ * for the server thread to pick up with takeUpdate(). Compiling the rules
+ * needs the game registries, so it stays on the server thread; only the
+ * I/O and the JSON parsing are moved off it.
+ */
+class ConfigWatcher {
+public:
+    /**
+     * @brief A parsed configuration, or the reason the changed file was rejected
+     */
+    struct Update {
+        std::optional<PluginConfig> config;
+        std::string                 error;
+    };
+
+    ConfigWatcher() = default;
+    ~ConfigWatcher() { stop(); }
+
+    ConfigWatcher(const ConfigWatcher&)            = delete;
+    ConfigWatcher& operator=(const ConfigWatcher&) = delete;
+
+    /**
+     * @brief Start watching; the file's current contents count as already loaded
+     * @param path The configuration file
+     * @param interval Time between modification checks
+     */
+    void start(std::filesystem::path path, std::chrono::milliseconds interval);
+
+    /**
+     * @brief Stop the watcher thread
+     */
+    void stop() noexcept;
+
+    /**
+     * @brief Take the result of the last change, if any
+     *
+     * Cheap when nothing changed: one relaxed atomic load, no lock.
+     *
+     * @return The update, or std::nullopt if the file did not change since the last call
+     */
+    [[nodiscard]] std::optional<Update> takeUpdate();
+
+    /**
+     * @brief Treat the file's current contents as loaded, e.g. after a manual reload
+     */
+    void markCurrent() noexcept;
+
+private:
+    struct Stamp {
+        std::filesystem::file_time_type time{};
+        std::uintmax_t                  size = 0;
+
+        bool operator==(const Stamp&) const = default;
+    };
+
+    [[nodiscard]] Stamp readStamp() const noexcept;
+    void                check();
+
+    std::filesystem::path     mPath;
+    std::chrono::milliseconds mInterval{1000};
+    std::thread               mThread;
+    std::atomic<bool>         mRunning{false};
+
+    std::mutex            mStampMutex;
+    Stamp                 mLoadedStamp; ///< Stamp of the contents last parsed or loaded
+    std::mutex            mUpdateMutex;
+    std::optional<Update> mUpdate;
+    std::atomic<bool>     mHasUpdate{false};
+};
+
+} // namespace potato_bonemeal_blocker
@@ -0,0 +1,319 @@
+#include "mod/CropCensus.h"
+
+#include "mc/world/level/BlockPos.h"
+#include "mc/world/level/BlockSource.h"
+#include "mc/world/level/block/Block.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace potato_bonemeal_blocker {
+
+namespace {
+
+/// Blocks compared per inner loop; index arrays hold 256 entries per block layer, so there is no tail
+constexpr std::size_t COUNT_BLOCK = 128;
+
+/**
+ * @brief Count the blocks of a subchunk that use one palette entry
+ *
+ * The inner loop has a fixed trip count and accumulates in the index type
+ * itself, which is what compilers need to turn it into vector compares and
+ * adds at their default optimization level.
+ */
+template <typename Index>
+std::uint32_t countEqual(const std::vector<Index>& indices, Index value) noexcept {
+    static_assert(COUNT_BLOCK <= std::numeric_limits<Index>::max());
+    std::uint32_t count = 0;
+    for (std::size_t begin = 0; begin + COUNT_BLOCK <= indices.size(); begin += COUNT_BLOCK) {
+        const Index* block   = indices.data() + begin;
+        Index        partial = 0;
+        for (std::size_t i = 0; i < COUNT_BLOCK; ++i) {
+            partial += static_cast<Index>(block[i] == value);
+        }
+        count += partial;
+    }
+    return count;
+}
+
+template <typename Index>
+std::uint64_t countTargets(
+    const std::vector<Index>&                                      indices,
+    const std::vector<std::uint8_t>&                               stages,
+    std::array<std::uint64_t, RuleMatcher::MAX_GROWTH_STAGE + 1>& byStage
+) noexcept {
+    std::uint64_t crops = 0;
+    for (std::size_t entry = 0; entry < stages.size(); ++entry) {
+        if (stages[entry] > RuleMatcher::MAX_GROWTH_STAGE) {
+            continue;
+        }
+        const auto count        = countEqual(indices, static_cast<Index>(entry));
+        byStage[stages[entry]] += count;
+        crops                  += count;
+    }
+    return crops;
+}
+
+} // namespace
+
+bool CropCensus::start(
+    std::vector<Column> columns,
+    std::vector<Target> targets,
+    const Settings&     settings,
+    Callback            done
+) {
+    if (mPhase != Phase::IDLE) {
+        return false;
+    }
+    std::erase_if(columns, [](const Column& column) { return !column.region || column.minY >= column.maxY; });
+
+    mSettings                  = settings;
+    mSettings.subchunksPerTick = std::max<std::uint32_t>(settings.subchunksPerTick, 1);
+    mSettings.maxWorkers       = std::max<std::uint32_t>(settings.maxWorkers, 1);
+    mDone                      = std::move(done);
+    mColumns                   = std::move(columns);
+    mTargetIds.clear();
+    mTargetStages.clear();
+    for (const auto& target : targets) {
+        mTargetIds.push_back(target.runtimeId);
+        mTargetStages.push_back(std::min(target.growthStage, RuleMatcher::MAX_GROWTH_STAGE));
+    }
+
+    mTotalSubchunks = 0;
+    for (const auto& column : mColumns) {
+        mTotalSubchunks += static_cast<std::size_t>((column.maxY - column.minY + SUBCHUNK_SIZE - 1) / SUBCHUNK_SIZE);
+    }
+    mSnapshots.clear();
+    mSnapshots.reserve(mTotalSubchunks);
+    mNextColumn    = 0;
+    mNextY         = mColumns.empty() ? 0 : mColumns.front().minY;
+    mSnapshotTicks = 0;
+    mPhase         = Phase::SNAPSHOT;
+    return true;
+}
+
+void CropCensus::tick() noexcept {
+    try {
+        if (mPhase == Phase::SNAPSHOT) {
+            ++mSnapshotTicks;
+            for (auto budget = mSettings.subchunksPerTick; budget > 0 && mNextColumn < mColumns.size(); --budget) {
+                copySubchunk(static_cast<std::uint32_t>(mNextColumn), mNextY);
+                mNextY += SUBCHUNK_SIZE;
+                if (mNextY >= mColumns[mNextColumn].maxY && ++mNextColumn < mColumns.size()) {
+                    mNextY = mColumns[mNextColumn].minY;
+                }
+            }
+            if (mNextColumn == mColumns.size()) {
+                launchWorkers();
+            }
+        } else if (mPhase == Phase::COUNTING && mFinishedWorkers.load(std::memory_order_acquire) == mWorkers.size()) {
+            finish();
+        }
+    } catch (const std::exception& e) {
+        // Out of memory or threads: report what went wrong instead of leaving the caller waiting
+        auto done = std::move(mDone);
+        cancel();
+        Report report;
+        report.error = e.what();
+        try {
+            if (done) {
+                done(report);
+            }
+        } catch (...) {}
+    }
+}
+
+void CropCensus::cancel() noexcept {
+    // Workers stop at the next snapshot they would claim
+    mNextSnapshot.store(mSnapshots.size(), std::memory_order_relaxed);
+    for (auto& worker : mWorkers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+    reset();
+}
+
+void CropCensus::copySubchunk(std::uint32_t columnIndex, int minY) {
+    const auto& column = mColumns[columnIndex];
+    const int   baseX  = column.chunkX * SUBCHUNK_SIZE;
+    const int   baseZ  = column.chunkZ * SUBCHUNK_SIZE;
+    const int   height = std::min(SUBCHUNK_SIZE, column.maxY - minY);
+
+    Snapshot snapshot;
+    snapshot.column = columnIndex;
+    snapshot.blocks = static_cast<std::uint16_t>(SUBCHUNK_SIZE * SUBCHUNK_SIZE * height);
+    mPaletteIndex.clear();
+    mIndices.resize(snapshot.blocks);
+
+    // Neighbouring blocks are mostly the same permutation, so the palette map is only probed on a change
+    const Block*  last      = nullptr;
+    std::uint16_t lastIndex = 0;
+    std::size_t   next      = 0;
+    for (int x = 0; x < SUBCHUNK_SIZE; ++x) {
+        for (int z = 0; z < SUBCHUNK_SIZE; ++z) {
+            for (int y = 0; y < height; ++y) {
+                const auto& block = column.region->getBlock(BlockPos{baseX + x, minY + y, baseZ + z});
+                if (&block != last) {
+                    last                 = &block;
+                    const auto runtimeId = block.getRuntimeId();
+                    auto*      index     = mPaletteIndex.find(runtimeId);
+                    if (!index) {
+                        index  = &mPaletteIndex[runtimeId];
+                        *index = static_cast<std::uint16_t>(snapshot.palette.size());
+                        snapshot.palette.push_back(runtimeId);
+                    }
+                    lastIndex = *index;
+                }
+                mIndices[next++] = lastIndex;
+            }
+        }
+    }
+
+    if (snapshot.palette.size() > 1) {
+        if (snapshot.palette.size() <= 256) {
+            snapshot.narrow.assign(mIndices.begin(), mIndices.end());
+        } else {
+            snapshot.wide = mIndices;
+        }
+    }
+    mSnapshots.push_back(std::move(snapshot));
+}
+
+void CropCensus::launchWorkers() {
+    mPhase = Phase::COUNTING;
+    mSnapshotCrops.assign(mSnapshots.size(), 0);
+    mNextSnapshot.store(0, std::memory_order_relaxed);
+    mFinishedWorkers.store(0, std::memory_order_relaxed);
+    mCountStart = std::chrono::steady_clock::now();
+
+    const auto hardware = std::max(std::thread::hardware_concurrency(), 1u);
+    const auto workers  = std::max<std::size_t>(
+        std::min<std::size_t>({mSettings.maxWorkers, hardware, mSnapshots.size()}),
+        1
+    );
+    mTallies.assign(workers, Tally{});
+    mWorkers.reserve(workers);
+    try {
+        for (std::size_t worker = 0; worker < workers; ++worker) {
+            mWorkers.emplace_back([this, worker] {
+                try {
+                    countSnapshots(mTallies[worker]);
+                } catch (...) {
+                    // Out of memory: the other workers carry on without this one
+                }
+                mFinishedWorkers.fetch_add(1, std::memory_order_release);
+            });
+        }
+    } catch (...) {
+        // The workers that did start claim every snapshot between them
+        if (mWorkers.empty()) {
+            throw;
+        }
+        mTallies.resize(mWorkers.size());
+    }
+}
+
+void CropCensus::countSnapshots(Tally& tally) {
+    std::vector<std::uint8_t> stages;
+    for (;;) {
+        const auto next = mNextSnapshot.fetch_add(1, std::memory_order_relaxed);
+        if (next >= mSnapshots.size()) {
+            break;
+        }
+        const auto& snapshot = mSnapshots[next];
+
+        // The palette is a handful of entries; without a crop among them the blocks are never read
+        bool any = false;
+        stages.resize(snapshot.palette.size());
+        for (std::size_t entry = 0; entry < snapshot.palette.size(); ++entry) {
+            const auto it = std::find(mTargetIds.begin(), mTargetIds.end(), snapshot.palette[entry]);
+            stages[entry] = it == mTargetIds.end() ? NO_TARGET : mTargetStages[it - mTargetIds.begin()];
+            any          |= stages[entry] != NO_TARGET;
+        }
+        if (!any) {
+            ++tally.skipped;
+            continue;
+        }
+
+        std::uint64_t crops = 0;
+        if (snapshot.palette.size() == 1) {
+            crops                     = snapshot.blocks;
+            tally.byStage[stages[0]] += snapshot.blocks;
+        } else if (!snapshot.narrow.empty()) {
+            crops = countTargets(snapshot.narrow, stages, tally.byStage);
+        } else {
+            crops = countTargets(snapshot.wide, stages, tally.byStage);
+        }
+        mSnapshotCrops[next] = crops;
+    }
+    tally.finishedAt = std::chrono::steady_clock::now();
+}
+
+void CropCensus::finish() noexcept {
+    for (auto& worker : mWorkers) {
+        worker.join();
+    }
+
+    Report report;
+    report.chunks        = mColumns.size();
+    report.subchunks     = mSnapshots.size();
+    report.snapshotTicks = mSnapshotTicks;
+    report.workers       = mWorkers.size();
+    auto finishedAt      = mCountStart;
+    for (const auto& tally : mTallies) {
+        for (std::size_t stage = 0; stage < tally.byStage.size(); ++stage) {
+            report.byStage[stage] += tally.byStage[stage];
+            report.total          += tally.byStage[stage];
+        }
+        report.skippedSubchunks += tally.skipped;
+        finishedAt               = std::max(finishedAt, tally.finishedAt);
+    }
+    report.countTime = std::chrono::duration_cast<std::chrono::microseconds>(finishedAt - mCountStart);
+
+    auto done = std::move(mDone);
+    try {
+        std::vector<ChunkCount> chunks(mColumns.size());
+        for (std::size_t index = 0; index < mColumns.size(); ++index) {
+            chunks[index] = {mColumns[index].dimension, mColumns[index].chunkX, mColumns[index].chunkZ, 0};
+        }
+        for (std::size_t index = 0; index < mSnapshots.size(); ++index) {
+            chunks[mSnapshots[index].column].crops += mSnapshotCrops[index];
+        }
+        std::erase_if(chunks, [](const ChunkCount& chunk) { return chunk.crops == 0; });
+        report.chunksWithCrops = chunks.size();
+
+        const auto top = std::min(chunks.size(), TOP_CHUNKS);
+        std::partial_sort(chunks.begin(), chunks.begin() + top, chunks.end(), [](const auto& a, const auto& b) {
+            return a.crops > b.crops;
+        });
+        chunks.resize(top);
+        report.topChunks = std::move(chunks);
+    } catch (...) {
+        // Only the chunk ranking is lost
+    }
+
+    reset();
+    try {
+        if (done) {
+            done(report);
+        }
+    } catch (...) {}
+}
+
+void CropCensus::reset() noexcept {
+    // Snapshots can take tens of megabytes, so the memory is released rather than kept for the next census
+    mWorkers.clear();
+    mTallies.clear();
+    mColumns       = {};
+    mSnapshots     = {};
+    mSnapshotCrops = {};
+    mIndices       = {};
+    mPaletteIndex.clear();
+    mTotalSubchunks = 0;
+    mNextColumn     = 0;
+    mDone           = nullptr;
+    mPhase          = Phase::IDLE;
+}
+
+} // namespace potato_bonemeal_blocker
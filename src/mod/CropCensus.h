@@ -0,0 +1,191 @@
+#pragma once
+
+#include "FlatIdMap.h"
+#include "RuleMatcher.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+class BlockSource;
+
+namespace potato_bonemeal_blocker {
+
+/**
+ * @brief Counts the rules' crops, by growth stage and chunk, around the online players
+ *
+ * A census runs in two phases. On the game thread, tick() copies up to
+ * Settings::subchunksPerTick 16x16x16 subchunks per tick into compact
+ * snapshots: the distinct runtime IDs of the subchunk (its palette) and one
+ * 8- or 16-bit palette index per block. Every subchunk is copied within a
+ * single tick, so each snapshot is consistent even though the census as a
+ * whole spans several ticks.
+ *
+ * Worker threads then count the snapshots. A subchunk whose palette holds no
+ * crop permutation is skipped without touching its blocks; otherwise the
+ * index array is compared against every matching palette index in tight
+ * loops the compiler vectorizes. The report is handed to the callback on the
+ * game thread by a later tick(), so the tick never waits for the workers.
+ *
+ * start(), tick() and cancel() must only be called from the game thread.
+ */
+class CropCensus {
+public:
+    static constexpr int         SUBCHUNK_SIZE   = 16;
+    static constexpr std::size_t SUBCHUNK_BLOCKS = SUBCHUNK_SIZE * SUBCHUNK_SIZE * SUBCHUNK_SIZE;
+
+    /// Chunks listed in Report::topChunks
+    static constexpr std::size_t TOP_CHUNKS = 10;
+
+    /**
+     * @brief Snapshot budget and worker count
+     */
+    struct Settings {
+        std::uint32_t subchunksPerTick = 8; ///< 4096 block reads each
+        std::uint32_t maxWorkers       = 4; ///< Counting threads, further limited by the hardware
+    };
+
+    /**
+     * @brief One chunk column to count
+     *
+     * The block source must outlive the census; dimensions are never unloaded
+     * while the server runs.
+     */
+    struct Column {
+        BlockSource* region    = nullptr;
+        int          dimension = 0;
+        int          chunkX    = 0;
+        int          chunkZ    = 0;
+        int          minY      = 0; ///< Lowest block of the dimension, a multiple of SUBCHUNK_SIZE
+        int          maxY      = 0; ///< One above the highest block of the dimension
+    };
+
+    /**
+     * @brief A block permutation counted as a crop
+     */
+    struct Target {
+        std::uint32_t runtimeId   = 0;
+        std::uint8_t  growthStage = 0;
+    };
+
+    /**
+     * @brief Crops found in one chunk column
+     */
+    struct ChunkCount {
+        int           dimension = 0;
+        int           chunkX    = 0;
+        int           chunkZ    = 0;
+        std::uint64_t crops     = 0;
+    };
+
+    /**
+     * @brief Result of a finished census
+     */
+    struct Report {
+        std::array<std::uint64_t, RuleMatcher::MAX_GROWTH_STAGE + 1> byStage{};
+        std::uint64_t             total            = 0;
+        std::size_t               chunks           = 0; ///< Columns counted
+        std::size_t               chunksWithCrops  = 0;
+        std::size_t               subchunks        = 0; ///< Subchunks copied
+        std::size_t               skippedSubchunks = 0; ///< Subchunks whose palette held no crop
+        std::uint64_t             snapshotTicks    = 0; ///< Ticks spent copying
+        std::size_t               workers          = 0;
+        std::chrono::microseconds countTime{0};         ///< Wall time of the counting phase
+        std::vector<ChunkCount>   topChunks;            ///< Most crops first, at most TOP_CHUNKS
+        std::string               error;                ///< Empty unless the census failed
+    };
+
+    using Callback = std::function<void(const Report&)>;
+
+    CropCensus() = default;
+    ~CropCensus() { cancel(); }
+
+    CropCensus(const CropCensus&)            = delete;
+    CropCensus& operator=(const CropCensus&) = delete;
+
+    /**
+     * @brief Start a census; tick() must then be called every game tick
+     * @param columns The chunk columns to count, without duplicates
+     * @param targets The crop permutations to count
+     * @param settings Snapshot budget and worker count
+     * @param done Called on the game thread with the report
+     * @return false if a census is already running
+     */
+    bool start(std::vector<Column> columns, std::vector<Target> targets, const Settings& settings, Callback done);
+
+    /**
+     * @brief Copy this tick's share of subchunks, or deliver the report once the workers are done
+     */
+    void tick() noexcept;
+
+    /**
+     * @brief Abandon the running census without calling its callback; waits for the workers
+     */
+    void cancel() noexcept;
+
+    [[nodiscard]] bool isRunning() const noexcept { return mPhase != Phase::IDLE; }
+
+    /**
+     * @brief Get the progress of the snapshot phase
+     * @return Subchunks copied so far and the total to copy
+     */
+    [[nodiscard]] std::pair<std::size_t, std::size_t> getProgress() const noexcept {
+        return {mSnapshots.size(), mTotalSubchunks};
+    }
+
+private:
+    enum class Phase : std::uint8_t { IDLE, SNAPSHOT, COUNTING };
+
+    /// Growth stage marking palette entries that are not a target
+    static constexpr std::uint8_t NO_TARGET = 0xFF;
+
+    struct Snapshot {
+        std::uint32_t              column = 0;
+        std::uint16_t              blocks = 0; ///< Blocks copied, fewer than SUBCHUNK_BLOCKS at a clipped top
+        std::vector<std::uint32_t> palette;    ///< Runtime IDs in order of first appearance
+        std::vector<std::uint8_t>  narrow;     ///< Palette indices while the palette fits in a byte
+        std::vector<std::uint16_t> wide;       ///< Palette indices otherwise; both empty for uniform subchunks
+    };
+
+    struct Tally {
+        std::array<std::uint64_t, RuleMatcher::MAX_GROWTH_STAGE + 1> byStage{};
+        std::size_t                                                   skipped = 0;
+        std::chrono::steady_clock::time_point                         finishedAt;
+    };
+
+    void copySubchunk(std::uint32_t columnIndex, int minY);
+    void launchWorkers();
+    void countSnapshots(Tally& tally);
+    void finish() noexcept;
+    void reset() noexcept;
+
+    Settings                   mSettings;
+    Callback                   mDone;
+    Phase                      mPhase = Phase::IDLE;
+    std::vector<Column>        mColumns;
+    std::vector<std::uint32_t> mTargetIds;    ///< Runtime IDs of the crop permutations
+    std::vector<std::uint8_t>  mTargetStages; ///< Growth stage of each mTargetIds entry
+    std::size_t                mTotalSubchunks = 0;
+    std::size_t                mNextColumn     = 0;
+    int                        mNextY          = 0;
+    std::uint64_t              mSnapshotTicks  = 0;
+    std::vector<Snapshot>      mSnapshots;
+    FlatIdMap<std::uint16_t>   mPaletteIndex; ///< Runtime ID to palette index, reused for every subchunk
+    std::vector<std::uint16_t> mIndices;      ///< Palette indices of the subchunk being copied
+
+    // Counting phase: workers claim snapshots by index and write only their own tally and crop counts
+    std::vector<std::thread>              mWorkers;
+    std::vector<Tally>                    mTallies;       ///< One per worker
+    std::vector<std::uint64_t>            mSnapshotCrops; ///< Indexed like mSnapshots
+    std::atomic<std::size_t>              mNextSnapshot{0};
+    std::atomic<std::size_t>              mFinishedWorkers{0};
+    std::chrono::steady_clock::time_point mCountStart;
+};
+
+} // namespace potato_bonemeal_blocker
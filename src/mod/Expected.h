@@ -0,0 +1,86 @@
+#pragma once
+
+#include <type_traits>
+#include <utility>
+
+namespace potato_bonemeal_blocker {
+
+/**
+ * @brief Marks an error as the failure alternative of an Expected, like C++23 std::unexpected
+ */
+template <typename E>
+struct Unexpected {
+    E error;
+};
+
+/**
+ * @brief Wrap an error for returning from a function that returns Expected
+ * @param error The error code
+ */
+template <typename E>
+[[nodiscard]] constexpr Unexpected<E> unexpected(E error) noexcept {
+    return Unexpected<E>{error};
+}
+
+/**
+ * @brief A value or an error code, the subset of C++23 std::expected the plugin uses
+ *
+ * The plugin builds as C++20, so this stands in until std::expected is
+ * available; member names follow the standard type so call sites carry over.
+ * Errors must be trivially copyable (enums), values default-constructible;
+ * nothing here throws or allocates.
+ */
+template <typename T, typename E>
+class Expected {
+    static_assert(std::is_trivially_copyable_v<E>);
+
+public:
+    constexpr Expected(T value) noexcept(std::is_nothrow_move_constructible_v<T>) // NOLINT(google-explicit-constructor)
+    : mValue(std::move(value)),
+      mHasValue(true) {}
+    constexpr Expected(Unexpected<E> error) noexcept // NOLINT(google-explicit-constructor)
+    : mError(error.error),
+      mHasValue(false) {}
+
+    [[nodiscard]] constexpr bool has_value() const noexcept { return mHasValue; }
+    constexpr explicit           operator bool() const noexcept { return mHasValue; }
+
+    [[nodiscard]] constexpr T&       value() noexcept { return mValue; }
+    [[nodiscard]] constexpr const T& value() const noexcept { return mValue; }
+    [[nodiscard]] constexpr T&       operator*() noexcept { return mValue; }
+    [[nodiscard]] constexpr const T& operator*() const noexcept { return mValue; }
+
+    /// Only meaningful when has_value() is false
+    [[nodiscard]] constexpr E error() const noexcept { return mError; }
+
+private:
+    T    mValue{};
+    E    mError{};
+    bool mHasValue;
+};
+
+/**
+ * @brief Success or an error code
+ */
+template <typename E>
+class Expected<void, E> {
+    static_assert(std::is_trivially_copyable_v<E>);
+
+public:
+    constexpr Expected() noexcept : mHasValue(true) {}
+    constexpr Expected(Unexpected<E> error) noexcept // NOLINT(google-explicit-constructor)
+    : mError(error.error),
+      mHasValue(false) {}
+
+    [[nodiscard]] constexpr bool has_value() const noexcept { return mHasValue; }
+    constexpr explicit           operator bool() const noexcept { return mHasValue; }
+
+    /// Only meaningful when has_value() is false
+    [[nodiscard]] constexpr E error() const noexcept { return mError; }
+
+private:
+    E    mError{};
+    bool mHasValue;
+};
+
+} // namespace potato_bonemeal_blocker
@@ -0,0 +1,56 @@
+#include "mod/FaultBreaker.h"
+
+#include <algorithm>
+
+namespace potato_bonemeal_blocker {
+
+std::string_view FaultBreaker::faultName(HandlerFault fault) noexcept {
+    switch (fault) {
+    case HandlerFault::BLOCK_LOOKUP:
+        return "block_lookup";
+    case HandlerFault::FEEDBACK:
+        return "feedback";
+    case HandlerFault::OUT_OF_MEMORY:
+        return "out_of_memory";
+    default:
+        return "exception";
+    }
+}
+
+void FaultBreaker::configure(const Settings& settings) noexcept {
+    auto clamped   = settings;
+    clamped.budget = std::clamp<std::uint32_t>(settings.budget, 1, MAX_BUDGET);
+    if (clamped == mSettings) {
+        return;
+    }
+    mSettings = clamped;
+    mNext     = 0;
+    mFilled   = 0;
+}
+
+bool FaultBreaker::record(HandlerFault fault, std::int64_t nowMs) noexcept {
+    ++mCounts[static_cast<std::size_t>(fault)];
+    if (!mSettings.enabled || mOpen) {
+        return false;
+    }
+
+    mTimes[mNext] = nowMs;
+    mNext         = (mNext + 1) % mSettings.budget;
+    mFilled       = std::min(mFilled + 1, mSettings.budget);
+
+    // With the ring full, mNext is the oldest of the last `budget` faults
+    if (mFilled < mSettings.budget || nowMs - mTimes[mNext % mSettings.budget] >= mSettings.window.count()) {
+        return false;
+    }
+    mOpen = true;
+    ++mTrips;
+    return true;
+}
+
+void FaultBreaker::reset() noexcept {
+    mOpen   = false;
+    mNext   = 0;
+    mFilled = 0;
+}
+
+} // namespace potato_bonemeal_blocker
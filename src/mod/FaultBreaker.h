@@ -0,0 +1,105 @@
+#pragma once
+
+#include "Expected.h"
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <string_view>
+
+namespace potato_bonemeal_blocker {
+
+/**
+ * @brief Why the interaction handler could not finish an event
+ */
+enum class HandlerFault : std::uint8_t {
+    BLOCK_LOOKUP,  // The fallback block lookup failed
+    FEEDBACK,      // The blocked message could not be sent
+    OUT_OF_MEMORY, // std::bad_alloc reached the handler boundary
+    EXCEPTION,     // Any other exception reached the handler boundary
+    COUNT
+};
+
+/// Result of the handler's steps: success or the fault that stopped them
+using HandlerResult = Expected<void, HandlerFault>;
+
+/**
+ * @brief Counts handler faults by kind and opens once a budget of them falls within a time window
+ *
+ * The times of the last Settings::budget faults are kept in a fixed ring.
+ * When the ring is full and its oldest entry is younger than
+ * Settings::window, the breaker opens: the plugin then stops evaluating
+ * interactions and unregisters its listener, so a game update that breaks an
+ * API the handler depends on costs one alert instead of an error per click.
+ * It stays open until reset().
+ *
+ * Only touched from the server thread.
+ */
+class FaultBreaker {
+public:
+    /// Largest supported Settings::budget
+    static constexpr std::uint32_t MAX_BUDGET = 256;
+
+    static constexpr std::size_t FAULT_KINDS = static_cast<std::size_t>(HandlerFault::COUNT);
+
+    /**
+     * @brief Trip thresholds
+     */
+    struct Settings {
+        bool                      enabled = true;
+        std::uint32_t             budget  = 20; ///< Faults within one window that open the breaker (1..MAX_BUDGET)
+        std::chrono::milliseconds window{10000};
+
+        bool operator==(const Settings&) const = default;
+    };
+
+    /**
+     * @brief Get a fault kind's log name
+     * @param fault The fault kind
+     * @return e.g. "block_lookup"
+     */
+    [[nodiscard]] static std::string_view faultName(HandlerFault fault) noexcept;
+
+    /**
+     * @brief Replace the thresholds; changed thresholds restart the window, an open breaker stays open
+     * @param settings The new settings
+     */
+    void configure(const Settings& settings) noexcept;
+
+    /**
+     * @brief Count a fault
+     * @param fault The fault kind
+     * @param nowMs Monotonic time in milliseconds
+     * @return true if this fault opened the breaker
+     */
+    bool record(HandlerFault fault, std::int64_t nowMs) noexcept;
+
+    /**
+     * @brief Close the breaker and restart the window; fault totals are kept
+     */
+    void reset() noexcept;
+
+    [[nodiscard]] bool            isOpen() const noexcept { return mOpen; }
+    [[nodiscard]] const Settings& getSettings() const noexcept { return mSettings; }
+    [[nodiscard]] std::uint64_t   getTripCount() const noexcept { return mTrips; }
+
+    /**
+     * @brief Get the number of faults of one kind since the plugin loaded
+     * @param fault The fault kind
+     * @return Fault count
+     */
+    [[nodiscard]] std::uint64_t getCount(HandlerFault fault) const noexcept {
+        return mCounts[static_cast<std::size_t>(fault)];
+    }
+
+private:
+    Settings                               mSettings;
+    std::array<std::int64_t, MAX_BUDGET>   mTimes{}; ///< Ring of fault times, first mSettings.budget slots used
+    std::uint32_t                          mNext   = 0;
+    std::uint32_t                          mFilled = 0;
+    bool                                   mOpen   = false;
+    std::uint64_t                          mTrips  = 0;
+    std::array<std::uint64_t, FAULT_KINDS> mCounts{};
+};
+
+} // namespace potato_bonemeal_blocker
@@ -0,0 +1,49 @@
+#include "mod/FeedbackLimiter.h"
+
+#include <algorithm>
+
+namespace potato_bonemeal_blocker {
+
+bool FeedbackLimiter::tryConsume(std::int64_t playerId, std::int64_t nowMs, std::uint32_t packets) {
+    auto& state = mStates[playerId];
+    if (!state.initialized) {
+        state.tokens       = mSettings.burst;
+        state.lastRefillMs = nowMs;
+        state.initialized  = true;
+    }
+
+    // Refill lazily from the elapsed time, no per-tick work for idle players
+    const auto elapsedMs = std::max<std::int64_t>(nowMs - state.lastRefillMs, 0);
+    state.tokens =
+        std::min(mSettings.burst, state.tokens + static_cast<double>(elapsedMs) * mSettings.refillPerSecond / 1000.0);
+    state.lastRefillMs = nowMs;
+
+    if (state.tokens >= 1.0) {
+        state.tokens -= 1.0;
+        return true;
+    }
+
+    if (state.suppressed == 0) {
+        state.windowStartMs = nowMs;
+    }
+    ++state.suppressed;
+    mSuppressedPackets.fetch_add(packets, std::memory_order_relaxed);
+    return false;
+}
+
+void FeedbackLimiter::flushSummaries(
+    std::int64_t                                              nowMs,
+    const std::function<void(std::int64_t, std::uint32_t)>& emit
+) {
+    const auto windowMs = mSettings.summaryWindow.count();
+    mStates.forEach([&](std::int64_t playerId, State& state) {
+        if (state.suppressed == 0 || nowMs - state.windowStartMs < windowMs) {
+            return;
+        }
+        emit(playerId, state.suppressed);
+        state.suppressed = 0;
+        mSummaries.fetch_add(1, std::memory_order_relaxed);
+    });
+}
+
+} // namespace potato_bonemeal_blocker
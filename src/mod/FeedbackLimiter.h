@@ -0,0 +1,98 @@
+#pragma once
+
+#include "FlatIdMap.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+
+namespace potato_bonemeal_blocker {
+
+/**
+ * @brief Per-player token bucket that coalesces repeated blocked-attempt feedback
+ *
+ * Every player gets a small bucket of feedback tokens. While tokens are left
+ * the normal blocked/info messages are sent; once the bucket is empty further
+ * attempts are only counted, and at the end of the window the player receives
+ * one "blocked N times" summary instead.
+ *
+ * State is kept in a FlatIdMap keyed by actor unique ID and must only be
+ * touched from the game thread.
+ */
+class FeedbackLimiter {
+public:
+    /**
+     * @brief Token bucket configuration
+     */
+    struct Settings {
+        double                    burst           = 3.0; ///< Bucket capacity: messages sent back to back
+        double                    refillPerSecond = 0.5; ///< Tokens regained per second
+        std::chrono::milliseconds summaryWindow   = std::chrono::milliseconds(3000); ///< Delay before a summary
+    };
+
+    /**
+     * @brief Replace the bucket configuration; existing buckets keep their current tokens
+     * @param settings The new settings
+     */
+    void configure(const Settings& settings) noexcept { mSettings = settings; }
+
+    /**
+     * @brief Record a blocked attempt and decide whether feedback should be sent now
+     * @param playerId Actor unique ID of the player
+     * @param nowMs Monotonic time in milliseconds
+     * @param packets Chat packets the feedback costs: the blocked message, plus the info message if shown
+     * @return true if the caller should send the full feedback, false if it was coalesced
+     */
+    bool tryConsume(std::int64_t playerId, std::int64_t nowMs, std::uint32_t packets);
+
+    /**
+     * @brief Emit summaries for every player whose coalescing window has ended
+     * @param nowMs Monotonic time in milliseconds
+     * @param emit Called as emit(playerId, suppressedCount) for each due summary
+     */
+    void flushSummaries(std::int64_t nowMs, const std::function<void(std::int64_t, std::uint32_t)>& emit);
+
+    /**
+     * @brief Drop the state of a player, e.g. on logout
+     * @param playerId Actor unique ID of the player
+     */
+    void evict(std::int64_t playerId) noexcept { mStates.erase(playerId); }
+
+    /**
+     * @brief Drop all player state
+     */
+    void clear() noexcept { mStates.clear(); }
+
+    /**
+     * @brief Get the number of chat packets not sent thanks to coalescing
+     * @return Suppressed feedback packets minus the summaries sent in their place
+     */
+    [[nodiscard]] std::uint64_t getPacketsSaved() const noexcept {
+        const auto suppressed = mSuppressedPackets.load(std::memory_order_relaxed);
+        const auto summaries  = mSummaries.load(std::memory_order_relaxed);
+        return suppressed > summaries ? suppressed - summaries : 0;
+    }
+
+    /**
+     * @brief Get the number of players with live feedback state
+     * @return Tracked player count
+     */
+    [[nodiscard]] std::size_t getTrackedPlayers() const noexcept { return mStates.size(); }
+
+private:
+    struct State {
+        double        tokens        = 0.0;
+        std::int64_t  lastRefillMs  = 0;
+        std::int64_t  windowStartMs = 0; ///< Time of the first coalesced attempt
+        std::uint32_t suppressed    = 0;
+        bool          initialized   = false;
+    };
+
+    Settings                   mSettings;
+    FlatIdMap<State>           mStates;
+    std::atomic<std::uint64_t> mSuppressedPackets{0}; ///< Packets of the feedback coalesced into summaries
+    std::atomic<std::uint64_t> mSummaries{0};
+};
+
+} // namespace potato_bonemeal_blocker
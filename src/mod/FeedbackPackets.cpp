@@ -0,0 +1,33 @@
+#include "mod/FeedbackPackets.h"
+
+#include "mc/world/actor/player/Player.h"
+
+namespace potato_bonemeal_blocker {
+
+void FeedbackPackets::build(const Language& language) {
+    std::vector<Entry> entries;
+    entries.reserve(language.getLanguageCount());
+    for (std::size_t i = 0; i < language.getLanguageCount(); ++i) {
+        const auto code = static_cast<Language::LanguageCode>(i);
+        entries.push_back(Entry{
+            TextPacket::createRawMessage(language.getMessage(Language::MessageKey::BLOCKED_MESSAGE, code)),
+            TextPacket::createRawMessage(language.getMessage(Language::MessageKey::INFO_MESSAGE, code))
+        });
+    }
+    mEntries = std::move(entries);
+}
+
+bool FeedbackPackets::send(Player& player, Language::LanguageCode language, bool withInfo) const {
+    const auto index = static_cast<std::size_t>(language);
+    if (index >= mEntries.size()) [[unlikely]] {
+        return false;
+    }
+    auto& entry = mEntries[index];
+    player.sendNetworkPacket(entry.blocked);
+    if (withInfo) {
+        player.sendNetworkPacket(entry.info);
+    }
+    return true;
+}
+
+} // namespace potato_bonemeal_blocker
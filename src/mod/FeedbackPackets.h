@@ -0,0 +1,56 @@
+#pragma once
+
+#include "Language.h"
+
+#include "mc/network/packet/TextPacket.h"
+
+#include <vector>
+
+class Player;
+
+namespace potato_bonemeal_blocker {
+
+/**
+ * @brief Blocked-feedback text packets, built once per loaded language
+ *
+ * Player::sendMessage() builds a fresh TextPacket, copying the message into
+ * it, for every line sent. The blocked and info lines never change within a
+ * language, so their packets are built when the configuration is applied and
+ * the event path only hands the cached packets to the network layer.
+ *
+ * Must only be touched from the server thread.
+ */
+class FeedbackPackets {
+public:
+    /**
+     * @brief Rebuild the packets of every loaded language from the message table
+     * @param language The language table
+     */
+    void build(const Language& language);
+
+    /**
+     * @brief Send the cached blocked feedback to a player
+     * @param player The player
+     * @param language Language of the messages
+     * @param withInfo Also send the info line
+     * @return false if no packets were built for the language; nothing was sent then
+     */
+    bool send(Player& player, Language::LanguageCode language, bool withInfo) const;
+
+    /**
+     * @brief Get the number of languages with cached packets
+     * @return Cached language count
+     */
+    [[nodiscard]] std::size_t size() const noexcept { return mEntries.size(); }
+
+private:
+    struct Entry {
+        TextPacket blocked;
+        TextPacket info;
+    };
+
+    // Sending takes a non-const Packet&; the network layer only reads it
+    mutable std::vector<Entry> mEntries; ///< Indexed by LanguageCode
+};
+
+} // namespace potato_bonemeal_blocker
@@ -0,0 +1,196 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace potato_bonemeal_blocker {
+
+/**
+ * @brief Compact open-addressing hash map keyed by 64-bit IDs (actor unique IDs, packed positions)
+ *
+ * Keys and values are stored inline in one flat array with linear probing and
+ * backward-shift deletion, so there are no tombstones and no per-entry
+ * allocations. A lookup is a multiply-shift hash and, at the configured load
+ * factor, usually a single probe.
+ *
+ * INT64_MIN is reserved as the empty marker and cannot be used as a key.
+ *
+ * @tparam V Value type, must be default constructible and movable
+ */
+template <class V>
+class FlatIdMap {
+public:
+    using Key = std::int64_t;
+
+    static constexpr Key EMPTY_KEY = std::numeric_limits<Key>::min();
+
+    explicit FlatIdMap(std::size_t initialCapacity = 16) {
+        rehash(std::bit_ceil(std::max<std::size_t>(initialCapacity, 8)));
+    }
+
+    /**
+     * @brief Find the value stored for a key
+     * @param key The key to look up
+     * @return Pointer to the value, or nullptr if the key is absent
+     */
+    [[nodiscard]] V* find(Key key) noexcept {
+        for (auto index = slotFor(key);; index = (index + 1) & mMask) {
+            auto& slot = mSlots[index];
+            if (slot.key == key) {
+                return &slot.value;
+            }
+            if (slot.key == EMPTY_KEY) {
+                return nullptr;
+            }
+        }
+    }
+
+    [[nodiscard]] const V* find(Key key) const noexcept { return const_cast<FlatIdMap*>(this)->find(key); }
+
+    /**
+     * @brief Check whether a key is present
+     * @param key The key to look up
+     * @return true if the key is present
+     */
+    [[nodiscard]] bool contains(Key key) const noexcept { return find(key) != nullptr; }
+
+    /**
+     * @brief Get the value for a key, inserting a default-constructed value if absent
+     * @param key The key, must not be EMPTY_KEY
+     * @return Reference to the stored value
+     */
+    V& operator[](Key key) {
+        if ((mSize + 1) * 10 > mSlots.size() * 7) {
+            rehash(mSlots.size() * 2);
+        }
+        for (auto index = slotFor(key);; index = (index + 1) & mMask) {
+            auto& slot = mSlots[index];
+            if (slot.key == key) {
+                return slot.value;
+            }
+            if (slot.key == EMPTY_KEY) {
+                slot.key = key;
+                ++mSize;
+                return slot.value;
+            }
+        }
+    }
+
+    /**
+     * @brief Remove a key
+     * @param key The key to remove
+     * @return true if the key was present
+     */
+    bool erase(Key key) noexcept {
+        auto index = slotFor(key);
+        for (;; index = (index + 1) & mMask) {
+            if (mSlots[index].key == key) {
+                break;
+            }
+            if (mSlots[index].key == EMPTY_KEY) {
+                return false;
+            }
+        }
+
+        // Shift following entries of the probe chain back so no tombstone is needed
+        auto hole = index;
+        for (auto next = (hole + 1) & mMask; mSlots[next].key != EMPTY_KEY; next = (next + 1) & mMask) {
+            const auto home = slotFor(mSlots[next].key);
+            if (((next - home) & mMask) >= ((next - hole) & mMask)) {
+                mSlots[hole] = std::move(mSlots[next]);
+                hole         = next;
+            }
+        }
+        mSlots[hole] = Slot{};
+        --mSize;
+        return true;
+    }
+
+    /**
+     * @brief Remove every entry for which the predicate returns true
+     * @param predicate Called as predicate(key, value)
+     * @return Number of removed entries
+     */
+    template <class Predicate>
+    std::size_t eraseIf(Predicate&& predicate) {
+        std::vector<Key> doomed;
+        forEach([&](Key key, V& value) {
+            if (predicate(key, value)) {
+                doomed.push_back(key);
+            }
+        });
+        for (const auto key : doomed) {
+            erase(key);
+        }
+        return doomed.size();
+    }
+
+    /**
+     * @brief Visit every entry
+     * @param visitor Called as visitor(key, value)
+     */
+    template <class Visitor>
+    void forEach(Visitor&& visitor) {
+        for (auto& slot : mSlots) {
+            if (slot.key != EMPTY_KEY) {
+                visitor(slot.key, slot.value);
+            }
+        }
+    }
+
+    template <class Visitor>
+    void forEach(Visitor&& visitor) const {
+        for (const auto& slot : mSlots) {
+            if (slot.key != EMPTY_KEY) {
+                visitor(slot.key, slot.value);
+            }
+        }
+    }
+
+    /**
+     * @brief Remove all entries, keeping the allocated capacity
+     */
+    void clear() noexcept {
+        for (auto& slot : mSlots) {
+            slot = Slot{};
+        }
+        mSize = 0;
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept { return mSize; }
+    [[nodiscard]] bool        empty() const noexcept { return mSize == 0; }
+
+private:
+    struct Slot {
+        Key key = EMPTY_KEY;
+        V   value{};
+    };
+
+    [[nodiscard]] std::size_t slotFor(Key key) const noexcept {
+        // Fibonacci hashing spreads sequential IDs across the table
+        return static_cast<std::size_t>((static_cast<std::uint64_t>(key) * 0x9E3779B97F4A7C15ull) >> mShift);
+    }
+
+    void rehash(std::size_t capacity) {
+        std::vector<Slot> old = std::exchange(mSlots, std::vector<Slot>(capacity));
+        mMask  = capacity - 1;
+        mShift = 64 - std::countr_zero(capacity);
+        mSize  = 0;
+        for (auto& slot : old) {
+            if (slot.key != EMPTY_KEY) {
+                (*this)[slot.key] = std::move(slot.value);
+            }
+        }
+    }
+
+    std::vector<Slot> mSlots;
+    std::size_t       mMask  = 0;
+    int               mShift = 64;
+    std::size_t       mSize  = 0;
+};
+
+} // namespace potato_bonemeal_blocker
@@ -0,0 +1,42 @@
+#include "mod/FrameArena.h"
+
+#include <algorithm>
+#include <bit>
+
+namespace potato_bonemeal_blocker {
+
+FrameArena& FrameArena::current() noexcept {
+    thread_local FrameArena arena;
+    return arena;
+}
+
+void* FrameArena::allocateSlow(std::size_t size, std::size_t alignment) {
+    // Default-initialized: the memory is overwritten by its user anyway
+    const auto chunkSize = std::max(size + alignment, mCapacity);
+    mOverflow.emplace_back(new std::byte[chunkSize]);
+    ++mHeapAllocations;
+    mCursor = mOverflow.back().get();
+    mEnd    = mCursor + chunkSize;
+    return allocate(size, alignment);
+}
+
+void FrameArena::reset() noexcept {
+    if (!mOverflow.empty()) {
+        // One buffer large enough for the frame that overflowed, so the next such frame fits
+        try {
+            const auto capacity = std::bit_ceil(std::max(mFrameBytes, mCapacity * 2));
+            mBuffer.reset(new std::byte[capacity]);
+            ++mHeapAllocations;
+            mBegin    = mBuffer.get();
+            mCapacity = capacity;
+        } catch (...) {
+            // Keep the current buffer; the next large frame overflows again
+        }
+        mOverflow.clear();
+    }
+    mCursor     = mBegin;
+    mEnd        = mBegin + mCapacity;
+    mFrameBytes = 0;
+}
+
+} // namespace potato_bonemeal_blocker
@@ -0,0 +1,161 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace potato_bonemeal_blocker {
+
+/**
+ * @brief Per-thread bump allocator for temporaries that live for one handled event or task
+ *
+ * Allocation is a pointer bump into the current buffer; nothing is freed
+ * individually. When the outermost FrameScope of a thread ends, the arena
+ * rewinds to the start of its buffer. A frame that ran out of room is served
+ * from extra heap chunks, and the next reset replaces the buffer with one
+ * large enough for that frame, so after the first few frames a thread's
+ * temporaries make no heap allocations at all.
+ *
+ * Memory handed out must not outlive the frame it was allocated in.
+ */
+class FrameArena {
+public:
+    /// Bytes available before the first heap allocation
+    static constexpr std::size_t INLINE_BYTES = 4096;
+
+    FrameArena() noexcept : mBegin(mInline), mCursor(mInline), mEnd(mInline + INLINE_BYTES) {}
+    ~FrameArena() = default;
+
+    FrameArena(const FrameArena&)            = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    /**
+     * @brief Get the arena of the calling thread
+     * @return The thread's arena
+     */
+    [[nodiscard]] static FrameArena& current() noexcept;
+
+    /**
+     * @brief Allocate uninitialized memory for the rest of the frame
+     * @param size Number of bytes
+     * @param alignment Power-of-two alignment
+     * @return The memory
+     */
+    [[nodiscard]] void* allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t)) {
+        const auto cursor  = reinterpret_cast<std::uintptr_t>(mCursor);
+        const auto padding = ((cursor + alignment - 1) & ~(alignment - 1)) - cursor;
+        if (padding + size <= static_cast<std::size_t>(mEnd - mCursor)) [[likely]] {
+            auto* start  = mCursor + padding;
+            mCursor      = start + size;
+            mFrameBytes += padding + size;
+            return start;
+        }
+        return allocateSlow(size, alignment);
+    }
+
+    /**
+     * @brief Give back memory; only the most recent allocation is actually reclaimed
+     * @param ptr Memory from allocate()
+     * @param size Its size
+     */
+    void deallocate(void* ptr, std::size_t size) noexcept {
+        // E.g. a string destroyed right after it grew; anything older waits for the end of the frame
+        if (static_cast<std::byte*>(ptr) + size == mCursor) {
+            mCursor = static_cast<std::byte*>(ptr);
+        }
+    }
+
+    /**
+     * @brief Check whether a FrameScope is open on this arena
+     * @return true inside a frame
+     */
+    [[nodiscard]] bool inFrame() const noexcept { return mDepth > 0; }
+
+    /**
+     * @brief Get the size of the buffer served without heap allocation
+     * @return Bytes
+     */
+    [[nodiscard]] std::size_t getCapacity() const noexcept { return mCapacity; }
+
+    /**
+     * @brief Get the number of heap chunks allocated because a frame outgrew the buffer
+     * @return Heap allocations since the arena was created
+     */
+    [[nodiscard]] std::uint64_t getHeapAllocations() const noexcept { return mHeapAllocations; }
+
+private:
+    friend class FrameScope;
+
+    void* allocateSlow(std::size_t size, std::size_t alignment);
+    void  reset() noexcept;
+
+    alignas(std::max_align_t) std::byte mInline[INLINE_BYTES];
+    std::unique_ptr<std::byte[]>              mBuffer;                    ///< Replaces mInline once a frame needed more
+    std::vector<std::unique_ptr<std::byte[]>> mOverflow;                  ///< Chunks of a frame that outgrew the buffer
+    std::byte*                                mBegin;                     ///< Start of mInline or mBuffer
+    std::byte*                                mCursor;                    ///< Next free byte of buffer or last chunk
+    std::byte*                                mEnd;                       ///< End of the buffer or last chunk
+    std::size_t                               mCapacity   = INLINE_BYTES; ///< Size of the buffer
+    std::size_t                               mFrameBytes = 0;            ///< Bytes handed out in the current frame
+    std::uint32_t                             mDepth      = 0;            ///< Open FrameScopes
+    std::uint64_t                             mHeapAllocations = 0;
+};
+
+/**
+ * @brief Marks one handled event or task; the thread's arena is rewound when the outermost scope ends
+ */
+class FrameScope {
+public:
+    FrameScope() noexcept : mArena(FrameArena::current()) { ++mArena.mDepth; }
+    ~FrameScope() {
+        if (--mArena.mDepth == 0) {
+            mArena.reset();
+        }
+    }
+
+    FrameScope(const FrameScope&)            = delete;
+    FrameScope& operator=(const FrameScope&) = delete;
+
+private:
+    FrameArena& mArena;
+};
+
+/**
+ * @brief Standard allocator over the calling thread's FrameArena
+ *
+ * Only for containers created and destroyed inside one FrameScope.
+ */
+template <typename T>
+class ArenaAllocator {
+public:
+    using value_type = T;
+
+    ArenaAllocator() noexcept : mArena(&FrameArena::current()) {}
+
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) noexcept // NOLINT(google-explicit-constructor)
+    : mArena(other.mArena) {}
+
+    [[nodiscard]] T* allocate(std::size_t count) {
+        return static_cast<T*>(mArena->allocate(count * sizeof(T), alignof(T)));
+    }
+    void deallocate(T* ptr, std::size_t count) noexcept { mArena->deallocate(ptr, count * sizeof(T)); }
+
+    template <typename U>
+    bool operator==(const ArenaAllocator<U>& other) const noexcept {
+        return mArena == other.mArena;
+    }
+
+private:
+    template <typename U>
+    friend class ArenaAllocator;
+
+    FrameArena* mArena;
+};
+
+/// String for text built while handling one event; must not be kept past the enclosing FrameScope
+using ArenaString = std::basic_string<char, std::char_traits<char>, ArenaAllocator<char>>;
+
+} // namespace potato_bonemeal_blocker
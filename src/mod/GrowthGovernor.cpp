@@ -0,0 +1,128 @@
+#include "mod/GrowthGovernor.h"
+
+#include "ll/api/memory/Hook.h"
+#include "mc/util/Random.h"
+#include "mc/world/level/BlockPos.h"
+#include "mc/world/level/BlockSource.h"
+#include "mc/world/level/block/CropBlock.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace potato_bonemeal_blocker {
+
+namespace {
+
+/// Governor the random-tick hook reports to; set by attach()
+GrowthGovernor* gActiveGovernor = nullptr;
+
+LL_TYPE_INSTANCE_HOOK(
+    CropRandomTickHook,
+    ll::memory::HookPriority::Normal,
+    CropBlock,
+    &CropBlock::$randomTick,
+    void,
+    BlockSource&    region,
+    BlockPos const& pos,
+    Random&         random
+) {
+    auto* governor = gActiveGovernor;
+    if (governor && !governor->allowGrowth(region.getDimensionId().id, pos.x, pos.y, pos.z, *this)) {
+        return;
+    }
+    origin(region, pos, random);
+}
+
+} // namespace
+
+std::string_view GrowthGovernor::modeName(Mode mode) noexcept {
+    switch (mode) {
+    case Mode::BLOCK:
+        return "block";
+    case Mode::THROTTLE:
+        return "throttle";
+    default:
+        return "off";
+    }
+}
+
+bool GrowthGovernor::attach() {
+    if (mAttached) {
+        return true;
+    }
+    gActiveGovernor = this;
+    mAttached       = CropRandomTickHook::hook();
+    if (!mAttached) {
+        gActiveGovernor = nullptr;
+    }
+    return mAttached;
+}
+
+void GrowthGovernor::detach() noexcept {
+    if (!mAttached) {
+        return;
+    }
+    CropRandomTickHook::unhook();
+    gActiveGovernor = nullptr;
+    mAttached       = false;
+}
+
+void GrowthGovernor::setMode(Mode mode, std::uint32_t throttleFactor) noexcept {
+    mMode           = mode;
+    mThrottleFactor = std::max<std::uint32_t>(throttleFactor, 1);
+}
+
+void GrowthGovernor::setGovernedTypes(std::vector<const BlockLegacy*> types) {
+    mGovernedTypes = std::move(types);
+    mCropTicks.clear();
+    mChunkCounts.clear();
+}
+
+void GrowthGovernor::onPlaced(int dimension, int x, int y, int z, const BlockLegacy& type) {
+    const auto key = packPosition(dimension, x, y, z);
+    if (isGoverned(type)) {
+        track(key) = 0;
+    } else {
+        untrack(key);
+    }
+}
+
+void GrowthGovernor::onRemoved(int dimension, int x, int y, int z) noexcept {
+    untrack(packPosition(dimension, x, y, z));
+}
+
+void GrowthGovernor::clear() noexcept {
+    mCropTicks.clear();
+    mChunkCounts.clear();
+    mSuppressedTicks = 0;
+    mAllowedTicks    = 0;
+}
+
+std::uint32_t* GrowthGovernor::trackOnTick(std::int64_t key) noexcept {
+    try {
+        return &track(key);
+    } catch (...) {
+        // Out of memory: let the crop grow rather than failing the tick
+        return nullptr;
+    }
+}
+
+std::uint32_t& GrowthGovernor::track(std::int64_t key) {
+    if (auto* ticks = mCropTicks.find(key)) {
+        return *ticks;
+    }
+    ++mChunkCounts[chunkOf(key)];
+    return mCropTicks[key];
+}
+
+void GrowthGovernor::untrack(std::int64_t key) noexcept {
+    if (!mCropTicks.erase(key)) {
+        return;
+    }
+    const auto chunk = chunkOf(key);
+    if (auto* count = mChunkCounts.find(chunk); count && --*count == 0) {
+        mChunkCounts.erase(chunk);
+    }
+}
+
+} // namespace potato_bonemeal_blocker
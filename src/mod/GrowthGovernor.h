@@ -0,0 +1,193 @@
+#pragma once
+
+#include "FlatIdMap.h"
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+class BlockLegacy;
+
+namespace potato_bonemeal_blocker {
+
+/**
+ * @brief Blocks or throttles random-tick growth of governed crop types
+ *
+ * The random-tick hook runs on the crop's block type (one BlockLegacy per
+ * crop), so the filter is a pointer compare against the few governed types;
+ * block names are never looked up on tick and ungoverned crops never touch
+ * the index.
+ *
+ * THROTTLE keeps a tick counter per governed crop in one flat map keyed by a
+ * chunk-major packed position (dimension, chunk, local column, height), so a
+ * governed tick costs a single hash probe. Entries are added when a governed
+ * crop is placed, removed when it is broken, and crops that were already in
+ * the world when their chunk loaded are registered on their first random tick.
+ *
+ * Random ticks, placement and breaking all happen on the server thread, so
+ * the governor is not synchronized.
+ */
+class GrowthGovernor {
+public:
+    /**
+     * @brief What happens to random-tick growth of governed crops
+     */
+    enum class Mode : std::uint8_t {
+        OFF,     // Crops grow normally; the growth hook is not installed
+        BLOCK,   // Governed crops never grow from random ticks
+        THROTTLE // Governed crops grow on every Nth random tick only
+    };
+
+    static constexpr std::uint32_t DEFAULT_THROTTLE_FACTOR = 4;
+
+    /**
+     * @brief Get a mode's command/config name
+     * @param mode The mode
+     * @return "off", "block" or "throttle"
+     */
+    [[nodiscard]] static std::string_view modeName(Mode mode) noexcept;
+
+    /**
+     * @brief Pack a block position into the chunk-major tracking key
+     *
+     * Layout from the top: 1 zero bit, 2 bits dimension, 22 bits chunk x,
+     * 22 bits chunk z, 4 bits local x, 4 bits local z, 9 bits y + 64.
+     * The top bit stays clear, so a key never collides with FlatIdMap's empty marker.
+     */
+    [[nodiscard]] static constexpr std::int64_t packPosition(int dimension, int x, int y, int z) noexcept {
+        const auto chunkX = static_cast<std::uint64_t>(static_cast<std::uint32_t>(x >> 4) & 0x3FFFFF);
+        const auto chunkZ = static_cast<std::uint64_t>(static_cast<std::uint32_t>(z >> 4) & 0x3FFFFF);
+        return static_cast<std::int64_t>(
+            (static_cast<std::uint64_t>(dimension & 3) << 61) | (chunkX << 39) | (chunkZ << 17)
+            | (static_cast<std::uint64_t>(x & 15) << 13) | (static_cast<std::uint64_t>(z & 15) << 9)
+            | static_cast<std::uint64_t>((y + 64) & 0x1FF)
+        );
+    }
+
+    /**
+     * @brief Get the chunk part of a packed position
+     * @param positionKey A key from packPosition()
+     * @return Key identifying the (dimension, chunk) pair
+     */
+    [[nodiscard]] static constexpr std::int64_t chunkOf(std::int64_t positionKey) noexcept { return positionKey >> 17; }
+
+    GrowthGovernor() = default;
+    ~GrowthGovernor() { detach(); }
+
+    GrowthGovernor(const GrowthGovernor&)            = delete;
+    GrowthGovernor& operator=(const GrowthGovernor&) = delete;
+
+    /**
+     * @brief Install the CropBlock random-tick hook and route it through this governor
+     * @return true if the hook is installed
+     */
+    bool attach();
+
+    /**
+     * @brief Remove the random-tick hook; crops grow normally afterwards
+     */
+    void detach() noexcept;
+
+    [[nodiscard]] bool isAttached() const noexcept { return mAttached; }
+
+    /**
+     * @brief Set the growth mode
+     * @param mode The new mode
+     * @param throttleFactor In THROTTLE mode, grow on every this many random ticks (at least 1)
+     */
+    void setMode(Mode mode, std::uint32_t throttleFactor = DEFAULT_THROTTLE_FACTOR) noexcept;
+
+    [[nodiscard]] Mode getMode() const noexcept { return mMode; }
+
+    /**
+     * @brief Replace the governed crop types and forget all tracked positions
+     * @param types Block types (one BlockLegacy per crop) whose growth is governed
+     */
+    void setGovernedTypes(std::vector<const BlockLegacy*> types);
+
+    /**
+     * @brief Record a block placed by a player; only governed types are tracked
+     * @param dimension Dimension ID
+     * @param type Type of the placed block
+     */
+    void onPlaced(int dimension, int x, int y, int z, const BlockLegacy& type);
+
+    /**
+     * @brief Forget a position whose block was broken
+     * @param dimension Dimension ID
+     */
+    void onRemoved(int dimension, int x, int y, int z) noexcept;
+
+    /**
+     * @brief Decide whether a random tick may grow the crop at a position
+     * @param dimension Dimension ID
+     * @param type The ticking crop type
+     * @return true if the vanilla random tick should run
+     */
+    [[nodiscard]] bool allowGrowth(int dimension, int x, int y, int z, const BlockLegacy& type) noexcept {
+        if (mMode == Mode::OFF || !isGoverned(type)) {
+            return true;
+        }
+        if (mMode == Mode::BLOCK) {
+            ++mSuppressedTicks;
+            return false;
+        }
+
+        const auto key   = packPosition(dimension, x, y, z);
+        auto*      ticks = mCropTicks.find(key);
+        if (!ticks) [[unlikely]] {
+            ticks = trackOnTick(key);
+            if (!ticks) {
+                return true;
+            }
+        }
+        if (++*ticks % mThrottleFactor == 0) {
+            ++mAllowedTicks;
+            return true;
+        }
+        ++mSuppressedTicks;
+        return false;
+    }
+
+    /**
+     * @brief Forget all tracked positions and reset the counters
+     */
+    void clear() noexcept;
+
+    [[nodiscard]] std::size_t   getTrackedCrops() const noexcept { return mCropTicks.size(); }
+    [[nodiscard]] std::size_t   getTrackedChunks() const noexcept { return mChunkCounts.size(); }
+    [[nodiscard]] std::uint64_t getSuppressedTicks() const noexcept { return mSuppressedTicks; }
+    [[nodiscard]] std::uint64_t getAllowedTicks() const noexcept { return mAllowedTicks; }
+
+private:
+    [[nodiscard]] bool isGoverned(const BlockLegacy& type) const noexcept {
+        // A handful of crop types at most; a linear scan beats any hashing here
+        for (const auto* governed : mGovernedTypes) {
+            if (governed == &type) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Register a crop first seen on a random tick
+     * @param key The packed position
+     * @return The crop's tick counter, or nullptr if it could not be tracked
+     */
+    std::uint32_t* trackOnTick(std::int64_t key) noexcept;
+
+    std::uint32_t& track(std::int64_t key);
+    void           untrack(std::int64_t key) noexcept;
+
+    bool                            mAttached       = false;
+    Mode                            mMode           = Mode::OFF;
+    std::uint32_t                   mThrottleFactor = DEFAULT_THROTTLE_FACTOR;
+    std::vector<const BlockLegacy*> mGovernedTypes;
+    FlatIdMap<std::uint32_t>        mCropTicks;   ///< Packed position -> random ticks seen
+    FlatIdMap<std::uint32_t>        mChunkCounts; ///< Chunk key -> number of tracked crops
+    std::uint64_t                   mSuppressedTicks = 0;
+    std::uint64_t                   mAllowedTicks    = 0;
+};
+
+} // namespace potato_bonemeal_blocker
@@ -0,0 +1,111 @@
+#include "mod/GrowthPipeline.h"
+
+#include "ll/api/memory/Hook.h"
+#include "mc/world/actor/Actor.h"
+#include "mc/world/item/FertilizerType.h"
+#include "mc/world/level/BlockPos.h"
+#include "mc/world/level/BlockSource.h"
+#include "mc/world/level/block/Block.h"
+#include "mc/world/level/block/CropBlock.h"
+
+namespace potato_bonemeal_blocker {
+
+namespace {
+
+/// Pipeline the fertilization hook reports to; set by attach()
+GrowthPipeline* gActivePipeline = nullptr;
+
+LL_TYPE_INSTANCE_HOOK(
+    CropFertilizedHook,
+    ll::memory::HookPriority::Normal,
+    CropBlock,
+    &CropBlock::$onFertilized,
+    bool,
+    BlockSource&    region,
+    BlockPos const& pos,
+    Actor*          actor,
+    FertilizerType  type
+) {
+    // Players were already judged by the interaction handler, which lets exempt staff through
+    auto* pipeline = gActivePipeline;
+    if (pipeline && type != FertilizerType::None && !(actor && actor->isPlayer())) {
+        GrowthAttempt attempt;
+        attempt.source    = actor ? GrowthSource::OTHER : GrowthSource::DISPENSER;
+        attempt.dimension = region.getDimensionId().id;
+        attempt.x         = pos.x;
+        attempt.y         = pos.y;
+        attempt.z         = pos.z;
+        attempt.runtimeId = region.getBlock(pos).getRuntimeId();
+        if (!pipeline->allowFertilization(attempt)) {
+            return false;
+        }
+    }
+    return origin(region, pos, actor, type);
+}
+
+} // namespace
+
+std::string_view GrowthPipeline::sourceName(GrowthSource source) noexcept {
+    switch (source) {
+    case GrowthSource::PLAYER:
+        return "player";
+    case GrowthSource::DISPENSER:
+        return "dispenser";
+    default:
+        return "other";
+    }
+}
+
+bool GrowthPipeline::attach(const SnapshotCell<RuleSnapshot>& rules) {
+    if (mRules) {
+        return true;
+    }
+    mRules          = &rules;
+    gActivePipeline = this;
+    if (!CropFertilizedHook::hook()) {
+        gActivePipeline = nullptr;
+        mRules          = nullptr;
+        return false;
+    }
+    return true;
+}
+
+void GrowthPipeline::detach() noexcept {
+    if (!mRules) {
+        return;
+    }
+    CropFertilizedHook::unhook();
+    gActivePipeline = nullptr;
+    mRules          = nullptr;
+}
+
+bool GrowthPipeline::allowFertilization(const GrowthAttempt& attempt) noexcept {
+    PBB_METRIC_SCOPE(FERTILIZER);
+    PBB_METRIC_COUNT(FERTILIZED);
+
+    // Fertilizer types carry no item, so every source is judged as bone meal
+    const auto* rules = mRules->load();
+    if (!rules || !rules->fertilizerItemId) [[unlikely]] {
+        return true;
+    }
+    auto judged   = attempt;
+    judged.itemId = *rules->fertilizerItemId;
+    if (!isBlocked(*rules, judged)) {
+        ++mAllowed;
+        return true;
+    }
+
+    PBB_METRIC_COUNT(FERTILIZER_BLOCKED);
+    ++mBlocked;
+    const auto key = (static_cast<std::int64_t>(attempt.source) << SOURCE_SHIFT)
+                   | packChunkKey(attempt.dimension, attempt.x >> 4, attempt.z >> 4);
+    try {
+        ++mPending[key];
+    } catch (...) {
+        // Out of memory: the crop is still protected, only the count is lost
+        ++mUncounted;
+    }
+    return false;
+}
+
+} // namespace potato_bonemeal_blocker
@@ -0,0 +1,167 @@
+#pragma once
+
+#include "Config.h"
+#include "FlatIdMap.h"
+#include "Metrics.h"
+#include "SnapshotCell.h"
+#include "StatsFormat.h"
+
+#include <cstdint>
+#include <string_view>
+
+namespace potato_bonemeal_blocker {
+
+/**
+ * @brief Where a growth attempt came from
+ */
+enum class GrowthSource : std::uint8_t {
+    PLAYER,    // Bone meal used by a player, decided by the interaction handler
+    DISPENSER, // Fertilization without an actor, i.e. a dispenser firing bone meal
+    OTHER      // Fertilization by a non-player actor
+};
+
+/**
+ * @brief One attempt to grow a block with an item, as seen by the decision pipeline
+ */
+struct GrowthAttempt {
+    GrowthSource  source    = GrowthSource::PLAYER;
+    std::int16_t  itemId    = 0; ///< Numeric ID of the fertilizer item
+    std::uint32_t runtimeId = 0; ///< Runtime ID of the target block permutation
+    int           dimension = 0;
+    int           x         = 0;
+    int           y         = 0;
+    int           z         = 0;
+};
+
+/**
+ * @brief The single decision path for bone meal, shared by players, dispensers and other sources
+ *
+ * Every source is judged by isBlocked() against the same compiled rule
+ * snapshot: a flat item-table lookup, the region index when regions exist,
+ * and one bit test on the block's runtime ID.
+ *
+ * Player interactions enter through the PlayerInteractBlockEvent handler,
+ * which needs per-player feedback and so handles its own side effects.
+ * Everything else reaches the game through CropBlock::onFertilized, which
+ * this pipeline hooks: the hook evaluates the attempt and refuses the
+ * fertilization, and the blocked attempt is only added to a per-chunk count.
+ * The server ticker calls flush() to turn those counts into statistics and
+ * log lines, so a dispenser farm firing on every redstone pulse costs one
+ * hash probe per shot and a few lines per flush, regardless of its rate.
+ *
+ * onFertilized and flush() run on the server thread, so the pending counts
+ * are not synchronized.
+ */
+class GrowthPipeline {
+public:
+    /**
+     * @brief Blocked attempts of one source in one chunk since the last flush
+     */
+    struct Batch {
+        GrowthSource  source    = GrowthSource::DISPENSER;
+        int           dimension = 0;
+        int           chunkX    = 0;
+        int           chunkZ    = 0;
+        std::uint32_t count     = 0;
+    };
+
+    /**
+     * @brief Get a source's log name
+     * @param source The source
+     * @return "player", "dispenser" or "other"
+     */
+    [[nodiscard]] static std::string_view sourceName(GrowthSource source) noexcept;
+
+    /**
+     * @brief Decide whether a growth attempt is forbidden
+     * @param rules The current rule snapshot
+     * @param attempt The attempt
+     * @return true if a rule in force at the target forbids the item on the block
+     */
+    [[nodiscard]] static bool isBlocked(const RuleSnapshot& rules, const GrowthAttempt& attempt) noexcept {
+        if (!rules.coversItem(attempt.itemId)) [[likely]] {
+            return false;
+        }
+        if (rules.regions.empty()) [[likely]] {
+            return rules.matcher.matches(attempt.itemId, attempt.runtimeId);
+        }
+        // One hash probe into the chunk grid, independent of the number of regions
+        PBB_METRIC_COUNT(REGION_LOOKUP);
+        return rules.matcherAt(attempt.dimension, attempt.x, attempt.y, attempt.z)
+            .matches(attempt.itemId, attempt.runtimeId);
+    }
+
+    GrowthPipeline() = default;
+    ~GrowthPipeline() { detach(); }
+
+    GrowthPipeline(const GrowthPipeline&)            = delete;
+    GrowthPipeline& operator=(const GrowthPipeline&) = delete;
+
+    /**
+     * @brief Install the CropBlock fertilization hook and judge non-player sources against the rules
+     * @param rules The published rule snapshots; must outlive the attachment
+     * @return true if the hook is installed
+     */
+    bool attach(const SnapshotCell<RuleSnapshot>& rules);
+
+    /**
+     * @brief Remove the fertilization hook; pending counts stay until the next flush()
+     */
+    void detach() noexcept;
+
+    [[nodiscard]] bool isAttached() const noexcept { return mRules != nullptr; }
+
+    /**
+     * @brief Judge a non-player fertilization and count it when blocked
+     * @param attempt The attempt; its source must not be PLAYER
+     * @return true if the fertilization may go ahead
+     */
+    [[nodiscard]] bool allowFertilization(const GrowthAttempt& attempt) noexcept;
+
+    /**
+     * @brief Hand out and clear the pending per-chunk counts
+     * @param visit Called with every Batch
+     * @return Number of blocked attempts handed out
+     */
+    template <typename Visitor>
+    std::uint64_t flush(Visitor&& visit) {
+        if (mPending.empty()) [[likely]] {
+            return 0;
+        }
+        std::uint64_t total = 0;
+        mPending.forEach([&](std::int64_t key, std::uint32_t count) {
+            Batch batch;
+            batch.source    = static_cast<GrowthSource>(key >> SOURCE_SHIFT);
+            batch.dimension = chunkKeyDimension(key & CHUNK_MASK);
+            batch.chunkX    = chunkKeyX(key & CHUNK_MASK);
+            batch.chunkZ    = chunkKeyZ(key & CHUNK_MASK);
+            batch.count     = count;
+            total          += count;
+            visit(batch);
+        });
+        mPending.clear();
+        return total;
+    }
+
+    [[nodiscard]] std::uint64_t getBlockedCount() const noexcept { return mBlocked; }
+    [[nodiscard]] std::uint64_t getAllowedCount() const noexcept { return mAllowed; }
+
+    /**
+     * @brief Get the number of blocked attempts lost because no count could be allocated
+     * @return Attempts blocked but missing from statistics and logs
+     */
+    [[nodiscard]] std::uint64_t getUncountedCount() const noexcept { return mUncounted; }
+
+private:
+    /// Pending keys are a packChunkKey() with the source above its 56 bits
+    static constexpr int          SOURCE_SHIFT = 56;
+    static constexpr std::int64_t CHUNK_MASK   = (std::int64_t{1} << SOURCE_SHIFT) - 1;
+
+    const SnapshotCell<RuleSnapshot>* mRules = nullptr;
+    FlatIdMap<std::uint32_t>          mPending; ///< Source and chunk -> blocked attempts since the last flush
+    std::uint64_t                     mBlocked   = 0;
+    std::uint64_t                     mAllowed   = 0;
+    std::uint64_t                     mUncounted = 0;
+};
+
+} // namespace potato_bonemeal_blocker
@@ -0,0 +1,113 @@
+#include "mod/HeldItemTracker.h"
+
+#include "ll/api/memory/Hook.h"
+#include "mc/world/Container.h"
+#include "mc/world/actor/player/Player.h"
+#include "mc/world/item/ItemStack.h"
+
+#include <utility>
+
+namespace potato_bonemeal_blocker {
+
+namespace {
+
+/// Tracker the hooks report to; set by attach()
+HeldItemTracker* gActiveTracker = nullptr;
+
+// Hotbar selection: hotbar packets and scripted slot changes
+LL_TYPE_INSTANCE_HOOK(
+    SelectSlotHook,
+    ll::memory::HookPriority::Normal,
+    Player,
+    &Player::setSelectedSlot,
+    ItemStack const&,
+    int slot
+) {
+    const auto& item = origin(slot);
+    if (auto* tracker = gActiveTracker) {
+        try {
+            tracker->onSelectedItem(getOrCreateUniqueID().id, item);
+        } catch (...) {
+            // Corrected by the next periodic refresh
+        }
+    }
+    return item;
+}
+
+// Inventory slot changes: pickups, crafting, /give and using up the last item of a stack
+LL_TYPE_INSTANCE_HOOK(
+    InventoryChangedHook,
+    ll::memory::HookPriority::Normal,
+    Player,
+    &Player::$inventoryChanged,
+    void,
+    Container&       container,
+    int              slot,
+    ItemStack const& oldItem,
+    ItemStack const& newItem,
+    bool             forceBalanced
+) {
+    origin(container, slot, oldItem, newItem, forceBalanced);
+    auto* tracker = gActiveTracker;
+    if (!tracker || slot != getSelectedItemSlot()) {
+        return;
+    }
+    try {
+        tracker->onSelectedItem(getOrCreateUniqueID().id, newItem);
+    } catch (...) {
+        // Corrected by the next periodic refresh
+    }
+}
+
+} // namespace
+
+bool HeldItemTracker::attach(CoversItem coversItem, std::function<void()> onFirstHolder) {
+    if (mAttached) {
+        return true;
+    }
+    mCoversItem    = std::move(coversItem);
+    mOnFirstHolder = std::move(onFirstHolder);
+    mChanges       = 0;
+    gActiveTracker = this;
+    if (!SelectSlotHook::hook()) {
+        gActiveTracker = nullptr;
+        return false;
+    }
+    if (!InventoryChangedHook::hook()) {
+        SelectSlotHook::unhook();
+        gActiveTracker = nullptr;
+        return false;
+    }
+    mAttached = true;
+    return true;
+}
+
+void HeldItemTracker::detach() noexcept {
+    if (!mAttached) {
+        return;
+    }
+    InventoryChangedHook::unhook();
+    SelectSlotHook::unhook();
+    gActiveTracker = nullptr;
+    mAttached      = false;
+    mHolders.clear();
+}
+
+void HeldItemTracker::refresh(const Player& player) {
+    onSelectedItem(player.getOrCreateUniqueID().id, player.getSelectedItem());
+}
+
+void HeldItemTracker::onSelectedItem(std::int64_t playerId, const ItemStack& item) {
+    ++mChanges;
+    if (!mCoversItem || item.isNull() || !mCoversItem(item.getId())) {
+        mHolders.erase(playerId);
+        return;
+    }
+    const auto before = mHolders.size();
+    mHolders[playerId] = 1;
+    if (before == 0 && mOnFirstHolder) {
+        mOnFirstHolder();
+    }
+}
+
+} // namespace potato_bonemeal_blocker
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "FlatIdMap.h"
+
+#include <cstdint>
+#include <functional>
+
+class ItemStack;
+class Player;
+
+namespace potato_bonemeal_blocker {
+
+/**
+ * @brief Tracks which players have a rule-covered item (bone meal) in their selected hotbar slot
+ *
+ * Hooks on hotbar slot selection and on inventory slot changes keep a set of
+ * "holders" up to date, so the plugin can keep its PlayerInteractBlockEvent
+ * listener registered only while someone could actually trigger a rule. The
+ * first holder is reported synchronously from the hook, before the player can
+ * use the item; the last holder going away is only visible through
+ * getHolderCount(), so the listener is released from a ticker task rather
+ * than from inside an event that may be dispatching it.
+ *
+ * Hooks and all methods run on the server thread, so the tracker is not
+ * synchronized.
+ */
+class HeldItemTracker {
+public:
+    /// Tells whether an item ID is covered by any rule
+    using CoversItem = std::function<bool(std::int16_t itemId)>;
+
+    HeldItemTracker() = default;
+    ~HeldItemTracker() { detach(); }
+
+    HeldItemTracker(const HeldItemTracker&)            = delete;
+    HeldItemTracker& operator=(const HeldItemTracker&) = delete;
+
+    /**
+     * @brief Install the hotbar and inventory hooks
+     * @param coversItem Rule coverage test for held items
+     * @param onFirstHolder Called from a hook when the holder count leaves zero
+     * @return true if both hooks are installed
+     */
+    bool attach(CoversItem coversItem, std::function<void()> onFirstHolder);
+
+    /**
+     * @brief Remove the hooks and forget all holders
+     */
+    void detach() noexcept;
+
+    [[nodiscard]] bool isAttached() const noexcept { return mAttached; }
+
+    /**
+     * @brief Re-evaluate a player's selected item, e.g. on join or after the rules changed
+     * @param player The player
+     */
+    void refresh(const Player& player);
+
+    /**
+     * @brief Record the item now in a player's selected slot
+     * @param playerId Actor unique ID
+     * @param item The selected item
+     */
+    void onSelectedItem(std::int64_t playerId, const ItemStack& item);
+
+    /**
+     * @brief Forget a player, e.g. on logout
+     * @param playerId Actor unique ID
+     */
+    void evict(std::int64_t playerId) noexcept { mHolders.erase(playerId); }
+
+    /**
+     * @brief Get the number of players holding a covered item
+     * @return Holder count
+     */
+    [[nodiscard]] std::size_t getHolderCount() const noexcept { return mHolders.size(); }
+
+    /**
+     * @brief Get the number of selected-item updates from hooks and refreshes
+     * @return Updates since attach()
+     */
+    [[nodiscard]] std::uint64_t getChangeCount() const noexcept { return mChanges; }
+
+private:
+    CoversItem              mCoversItem;
+    std::function<void()>   mOnFirstHolder;
+    FlatIdMap<std::uint8_t> mHolders; ///< Actor unique IDs of players holding a covered item
+    std::uint64_t           mChanges  = 0;
+    bool                    mAttached = false;
+};
+
+} // namespace potato_bonemeal_blocker
@@ -0,0 +1,253 @@
+#include "mod/HostShare.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace potato_bonemeal_blocker {
+
+namespace {
+
+// Zero-filled memory must be a valid atomic 0 in every process mapping the segment
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free && std::atomic<std::int64_t>::is_always_lock_free);
+static_assert(sizeof(std::atomic<std::uint64_t>) == sizeof(std::uint64_t));
+
+constexpr std::uint32_t MAGIC   = 0x48424250; // "PBBH"
+constexpr std::uint32_t VERSION = 1;
+
+/// Values of Segment::state
+constexpr std::uint32_t UNINITIALIZED = 0;
+constexpr std::uint32_t INITIALIZING  = 1;
+constexpr std::uint32_t READY         = 2;
+
+/// How long a segment may stay INITIALIZING, or the configuration lock stay taken, before giving up
+constexpr std::chrono::milliseconds LOCK_TIMEOUT{1000};
+
+constexpr std::size_t CONFIG_WORDS = HostShare::MAX_CONFIG_BYTES / sizeof(std::uint64_t);
+
+/**
+ * @brief One instance's share of the segment, on its own cache line
+ */
+struct alignas(64) InstanceSlot {
+    std::atomic<std::int64_t>  heartbeatMs;       ///< 0 while free; claimed by a compare-exchange on it
+    std::atomic<std::uint64_t> processId;
+    std::atomic<std::uint64_t> blocked;
+    std::atomic<std::uint64_t> fertilizerBlocked;
+};
+
+std::uint64_t currentProcessId() noexcept {
+#if defined(_WIN32)
+    return GetCurrentProcessId();
+#else
+    return static_cast<std::uint64_t>(::getpid());
+#endif
+}
+
+} // namespace
+
+/**
+ * @brief Layout of the shared segment; never constructed, the zero-filled mapping is its initial state
+ */
+struct HostShare::Segment {
+    std::atomic<std::uint32_t> state; ///< UNINITIALIZED, INITIALIZING or READY
+    std::uint32_t              magic;
+    std::uint32_t              version;
+    std::uint32_t              size;
+
+    alignas(64) std::atomic<std::uint64_t> blocked;
+    std::atomic<std::uint64_t> fertilizerBlocked;
+
+    alignas(64) std::atomic<std::uint64_t> configSequence; ///< Odd while a writer copies the document
+    std::atomic<std::uint64_t> configGeneration;
+    std::atomic<std::uint64_t> configBytes;
+
+    InstanceSlot instances[MAX_INSTANCES];
+
+    std::atomic<std::uint64_t> config[CONFIG_WORDS]; ///< The document, packed into words
+};
+
+bool HostShare::open(std::string_view name, std::int64_t nowMs, std::string& error) noexcept {
+    close();
+    if (!mMemory.open(name, sizeof(Segment), error)) {
+        return false;
+    }
+    auto& segment = *static_cast<Segment*>(mMemory.data());
+
+    // The first process to see the zeroed segment lays it out; the others wait until it is ready
+    auto state = UNINITIALIZED;
+    if (segment.state.compare_exchange_strong(state, INITIALIZING, std::memory_order_acquire)) {
+        segment.magic   = MAGIC;
+        segment.version = VERSION;
+        segment.size    = static_cast<std::uint32_t>(sizeof(Segment));
+        segment.state.store(READY, std::memory_order_release);
+    } else {
+        const auto deadline = std::chrono::steady_clock::now() + LOCK_TIMEOUT;
+        while (segment.state.load(std::memory_order_acquire) != READY) {
+            if (std::chrono::steady_clock::now() > deadline) {
+                error = "the segment was never initialized; remove it and restart";
+                mMemory.close();
+                return false;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+    if (segment.magic != MAGIC || segment.version != VERSION || segment.size != sizeof(Segment)) {
+        error = "the segment was created by an incompatible plugin version";
+        mMemory.close();
+        return false;
+    }
+
+    // A free slot has no heartbeat; a stale one belongs to an instance that did not close
+    for (std::uint32_t i = 0; i < MAX_INSTANCES; ++i) {
+        auto& slot      = segment.instances[i];
+        auto  heartbeat = slot.heartbeatMs.load(std::memory_order_relaxed);
+        if (heartbeat != 0 && nowMs - heartbeat < STALE_INSTANCE_MS) {
+            continue;
+        }
+        if (!slot.heartbeatMs.compare_exchange_strong(heartbeat, nowMs, std::memory_order_acq_rel)) {
+            continue;
+        }
+        slot.processId.store(currentProcessId(), std::memory_order_relaxed);
+        slot.blocked.store(0, std::memory_order_relaxed);
+        slot.fertilizerBlocked.store(0, std::memory_order_relaxed);
+        mSegment = &segment;
+        mSlot    = i;
+        try {
+            mName = name;
+        } catch (...) {
+            // Only used for display
+        }
+        return true;
+    }
+    error = "all " + std::to_string(MAX_INSTANCES) + " instance slots are in use";
+    mMemory.close();
+    return false;
+}
+
+void HostShare::close() noexcept {
+    if (mSegment != nullptr) {
+        auto& slot = mSegment->instances[mSlot];
+        slot.processId.store(0, std::memory_order_relaxed);
+        slot.heartbeatMs.store(0, std::memory_order_release);
+    }
+    mSegment = nullptr;
+    mMemory.close();
+}
+
+void HostShare::publish(std::uint64_t blocked, std::uint64_t fertilizerBlocked, std::int64_t nowMs) noexcept {
+    if (mSegment == nullptr) {
+        return;
+    }
+    auto& slot = mSegment->instances[mSlot];
+    if (blocked > 0) {
+        mSegment->blocked.fetch_add(blocked, std::memory_order_relaxed);
+        slot.blocked.fetch_add(blocked, std::memory_order_relaxed);
+    }
+    if (fertilizerBlocked > 0) {
+        mSegment->fertilizerBlocked.fetch_add(fertilizerBlocked, std::memory_order_relaxed);
+        slot.fertilizerBlocked.fetch_add(fertilizerBlocked, std::memory_order_relaxed);
+    }
+    slot.heartbeatMs.store(nowMs, std::memory_order_relaxed);
+}
+
+std::uint64_t HostShare::getConfigGeneration() const noexcept {
+    return mSegment ? mSegment->configGeneration.load(std::memory_order_acquire) : 0;
+}
+
+std::uint64_t HostShare::publishConfig(std::string_view text) noexcept {
+    if (mSegment == nullptr || text.size() > MAX_CONFIG_BYTES) {
+        return 0;
+    }
+    auto& segment = *mSegment;
+
+    // Take the lock by making the sequence odd; a writer that died holding it is overtaken after LOCK_TIMEOUT
+    auto sequence = segment.configSequence.load(std::memory_order_relaxed);
+    auto observed = sequence;
+    auto since    = std::chrono::steady_clock::now();
+    for (;;) {
+        const auto locked = (sequence & 1) == 0 ? sequence + 1 : sequence + 2;
+        if ((sequence & 1) == 0 || std::chrono::steady_clock::now() - since > LOCK_TIMEOUT) {
+            if (segment.configSequence.compare_exchange_weak(sequence, locked, std::memory_order_acquire)) {
+                sequence = locked;
+                break;
+            }
+            continue;
+        }
+        std::this_thread::yield();
+        sequence = segment.configSequence.load(std::memory_order_relaxed);
+        if (sequence != observed) {
+            observed = sequence;
+            since    = std::chrono::steady_clock::now();
+        }
+    }
+    std::atomic_thread_fence(std::memory_order_release);
+
+    for (std::size_t offset = 0; offset < text.size(); offset += sizeof(std::uint64_t)) {
+        std::uint64_t word = 0;
+        std::memcpy(&word, text.data() + offset, std::min(sizeof(word), text.size() - offset));
+        segment.config[offset / sizeof(word)].store(word, std::memory_order_relaxed);
+    }
+    segment.configBytes.store(text.size(), std::memory_order_relaxed);
+    const auto generation = segment.configGeneration.load(std::memory_order_relaxed) + 1;
+    segment.configGeneration.store(generation, std::memory_order_relaxed);
+    segment.configSequence.store(sequence + 1, std::memory_order_release);
+    return generation;
+}
+
+std::uint64_t HostShare::readConfig(std::string& text) const {
+    if (mSegment == nullptr) {
+        return 0;
+    }
+    const auto& segment  = *mSegment;
+    const auto  deadline = std::chrono::steady_clock::now() + LOCK_TIMEOUT;
+    for (;;) {
+        const auto before = segment.configSequence.load(std::memory_order_acquire);
+        if ((before & 1) != 0) {
+            if (std::chrono::steady_clock::now() > deadline) {
+                return 0;
+            }
+            std::this_thread::yield();
+            continue;
+        }
+
+        const auto generation = segment.configGeneration.load(std::memory_order_relaxed);
+        const auto bytes      = segment.configBytes.load(std::memory_order_relaxed);
+        text.resize(static_cast<std::size_t>(std::min<std::uint64_t>(bytes, MAX_CONFIG_BYTES)));
+        for (std::size_t offset = 0; offset < text.size(); offset += sizeof(std::uint64_t)) {
+            const auto word = segment.config[offset / sizeof(std::uint64_t)].load(std::memory_order_relaxed);
+            std::memcpy(text.data() + offset, &word, std::min(sizeof(word), text.size() - offset));
+        }
+
+        // Retried if a writer started or finished while the document was copied
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (segment.configSequence.load(std::memory_order_relaxed) == before) {
+            return generation;
+        }
+    }
+}
+
+HostShare::Totals HostShare::getTotals(std::int64_t nowMs) const noexcept {
+    Totals totals;
+    if (mSegment == nullptr) {
+        return totals;
+    }
+    totals.blocked           = mSegment->blocked.load(std::memory_order_relaxed);
+    totals.fertilizerBlocked = mSegment->fertilizerBlocked.load(std::memory_order_relaxed);
+    for (const auto& slot : mSegment->instances) {
+        const auto heartbeat = slot.heartbeatMs.load(std::memory_order_relaxed);
+        if (heartbeat != 0 && nowMs - heartbeat < STALE_INSTANCE_MS) {
+            ++totals.instances;
+        }
+    }
+    return totals;
+}
+
+} // namespace potato_bonemeal_blocker
@@ -0,0 +1,127 @@
+#pragma once
+
+#include "SharedMemory.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace potato_bonemeal_blocker {
+
+/**
+ * @brief Configuration and blocked-attempt totals shared by the server instances of one host
+ *
+ * All instances that open the same name map one SharedMemory segment:
+ * - the configuration document last published by any instance, with a
+ *   generation number; readers copy it under a sequence lock, so a reader
+ *   never blocks a writer and a torn copy is retried, not used
+ * - host-wide blocked-attempt totals as lock-free atomics
+ * - one slot per instance with its own totals and a heartbeat
+ *
+ * Each instance compiles the shared document into its own rule snapshot: a
+ * snapshot holds process-local containers and runtime IDs resolved against
+ * that process's registries, so it cannot live in the segment itself.
+ *
+ * Nothing here runs on the event path. The plugin publishes its counters and
+ * checks the configuration generation from a ticker task, which costs a few
+ * atomic operations on memory every instance already has mapped.
+ */
+class HostShare {
+public:
+    /// Instances that can use one segment at a time
+    static constexpr std::uint32_t MAX_INSTANCES = 16;
+
+    /// Largest shareable configuration document
+    static constexpr std::size_t MAX_CONFIG_BYTES = std::size_t{1} << 20;
+
+    /// An instance whose heartbeat is older than this is gone and its slot may be reused
+    static constexpr std::int64_t STALE_INSTANCE_MS = 60'000;
+
+    /**
+     * @brief Whether to share and under which segment name
+     */
+    struct Settings {
+        bool        enabled = false;
+        std::string name    = "potato-bonemeal-blocker"; ///< Instances with equal names share one segment
+
+        bool operator==(const Settings&) const = default;
+    };
+
+    /**
+     * @brief Host-wide blocked-attempt totals
+     */
+    struct Totals {
+        std::uint64_t blocked           = 0; ///< Attempts blocked by all instances, every source
+        std::uint64_t fertilizerBlocked = 0; ///< Of those, attempts by dispensers and other non-player sources
+        std::uint32_t instances         = 0; ///< Instances with a recent heartbeat
+    };
+
+    HostShare() = default;
+    ~HostShare() { close(); }
+
+    HostShare(const HostShare&)            = delete;
+    HostShare& operator=(const HostShare&) = delete;
+
+    /**
+     * @brief Map the segment, initializing it if this is the first instance, and claim an instance slot
+     * @param name Segment name
+     * @param nowMs Wall-clock time in milliseconds, comparable across processes
+     * @param error Receives a description of the problem on failure
+     * @return true if the segment is open
+     */
+    bool open(std::string_view name, std::int64_t nowMs, std::string& error) noexcept;
+
+    /**
+     * @brief Release the instance slot and unmap the segment
+     */
+    void close() noexcept;
+
+    [[nodiscard]] bool               isOpen() const noexcept { return mSegment != nullptr; }
+    [[nodiscard]] const std::string& getName() const noexcept { return mName; }
+
+    /**
+     * @brief Add this instance's newly blocked attempts to the shared totals and refresh its heartbeat
+     * @param blocked Attempts blocked since the last call
+     * @param fertilizerBlocked Of those, attempts by non-player sources
+     * @param nowMs Wall-clock time in milliseconds
+     */
+    void publish(std::uint64_t blocked, std::uint64_t fertilizerBlocked, std::int64_t nowMs) noexcept;
+
+    /**
+     * @brief Get the generation of the shared configuration document
+     * @return 0 if no instance has published one yet
+     */
+    [[nodiscard]] std::uint64_t getConfigGeneration() const noexcept;
+
+    /**
+     * @brief Replace the shared configuration document
+     * @param text The document
+     * @return Its generation, or 0 if it is larger than MAX_CONFIG_BYTES or the segment is closed
+     */
+    std::uint64_t publishConfig(std::string_view text) noexcept;
+
+    /**
+     * @brief Copy the shared configuration document
+     * @param text Receives the document
+     * @return Its generation, or 0 if there is none or a writer held the lock for too long
+     */
+    std::uint64_t readConfig(std::string& text) const;
+
+    /**
+     * @brief Read the host-wide totals
+     * @param nowMs Wall-clock time in milliseconds
+     * @return The totals
+     */
+    [[nodiscard]] Totals getTotals(std::int64_t nowMs) const noexcept;
+
+private:
+    struct Segment;
+
+    SharedMemory  mMemory;
+    Segment*      mSegment = nullptr;
+    std::uint32_t mSlot    = 0; ///< This instance's slot
+    std::string   mName;
+};
+
+} // namespace potato_bonemeal_blocker
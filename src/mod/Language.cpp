@@ -1,8 +1,51 @@
 #include "Language.h"
-#include <sstream>
+
+#include <fstream>
+#include <limits>
 
 namespace potato_bonemeal_blocker {
 
+namespace {
+
+std::string_view trim(std::string_view text) noexcept {
+    constexpr std::string_view whitespace = " \t\r\n";
+    const auto                 first      = text.find_first_not_of(whitespace);
+    if (first == std::string_view::npos) {
+        return {};
+    }
+    const auto last = text.find_last_not_of(whitespace);
+    return text.substr(first, last - first + 1);
+}
+
+std::string unescape(std::string_view value) {
+    std::string result;
+    result.reserve(value.size());
+    for (std::size_t i = 0; i < value.size(); ++i) {
+        if (value[i] == '\\' && i + 1 < value.size() && value[i + 1] == 'n') {
+            result.push_back('\n');
+            ++i;
+        } else {
+            result.push_back(value[i]);
+        }
+    }
+    return result;
+}
+
+std::string escape(std::string_view value) {
+    std::string result;
+    result.reserve(value.size());
+    for (const auto c : value) {
+        if (c == '\n') {
+            result += "\\n";
+        } else {
+            result.push_back(c);
+        }
+    }
+    return result;
+}
+
+} // namespace
+
 Language& Language::getInstance() noexcept {
     static Language instance;
     return instance;
@@ -13,116 +56,156 @@ Language::Language() noexcept : mCurrentLanguage(LanguageCode::CHINESE_SIMPLIFIE
 }
 
 void Language::setLanguage(LanguageCode language) noexcept {
-    mCurrentLanguage = language;
+    if (static_cast<std::size_t>(language) < mLocales.size()) {
+        mCurrentLanguage = language;
+    }
 }
 
 Language::LanguageCode Language::getCurrentLanguage() const noexcept {
     return mCurrentLanguage;
 }
 
+std::optional<Language::LanguageCode> Language::findLanguage(std::string_view locale) const noexcept {
+    for (std::size_t i = 0; i < mLocales.size(); ++i) {
+        if (mLocales[i] == locale) {
+            return static_cast<LanguageCode>(i);
+        }
+    }
+    return std::nullopt;
+}
+
+std::string_view Language::getLocale(LanguageCode language) const noexcept {
+    const auto index = static_cast<std::size_t>(language);
+    return index < mLocales.size() ? std::string_view{mLocales[index]} : std::string_view{};
+}
+
+std::optional<Language::LanguageCode> Language::addLanguage(std::string_view locale) {
+    if (const auto existing = findLanguage(locale)) {
+        return existing;
+    }
+    if (mLocales.size() > std::numeric_limits<std::uint8_t>::max()) {
+        return std::nullopt;
+    }
+
+    // New locales start as a copy of English so that untranslated keys fall back to it
+    const auto language = static_cast<LanguageCode>(mLocales.size());
+    mLocales.emplace_back(locale);
+
+    const auto englishRow = static_cast<std::size_t>(LanguageCode::ENGLISH) * KEY_COUNT;
+    for (std::size_t key = 0; key < KEY_COUNT; ++key) {
+        mTable.push_back(mTable[englishRow + key]);
+    }
+    return language;
+}
+
+void Language::setMessage(LanguageCode language, MessageKey key, std::string_view message) {
+    mTable[static_cast<std::size_t>(language) * KEY_COUNT + static_cast<std::size_t>(key)] = message;
+}
+
 void Language::initializeMessages() noexcept {
+    // Built-in languages occupy the fixed LanguageCode indices; disk locales are appended later
+    mLocales = {"zh_CN", "en_US"};
+    mTable.assign(mLocales.size() * KEY_COUNT, std::string{});
+
+    constexpr auto zh = LanguageCode::CHINESE_SIMPLIFIED;
+    constexpr auto en = LanguageCode::ENGLISH;
+
     // Blocked message - shown to players when bone meal is blocked
-    mMessages["blocked_message"] = {
-        {LanguageCode::CHINESE_SIMPLIFIED, "§c骨粉不能用于土豆作物！"},
-        {LanguageCode::ENGLISH, "§cBone meal cannot be used on potato crops!"}
-    };
+    setMessage(zh, MessageKey::BLOCKED_MESSAGE, "§c骨粉不能用于土豆作物！");
+    setMessage(en, MessageKey::BLOCKED_MESSAGE, "§cBone meal cannot be used on potato crops!");
 
     // Info message - additional information for players
-    mMessages["info_message"] = {
-        {LanguageCode::CHINESE_SIMPLIFIED, "§e你仍然可以在其他作物上使用骨粉。"},
-        {LanguageCode::ENGLISH, "§eYou can still use bone meal on other crops."}
-    };
+    setMessage(zh, MessageKey::INFO_MESSAGE, "§e你仍然可以在其他作物上使用骨粉。");
+    setMessage(en, MessageKey::INFO_MESSAGE, "§eYou can still use bone meal on other crops.");
 
     // Plugin loading message
-    mMessages["loading"] = {
-        {LanguageCode::CHINESE_SIMPLIFIED, "正在加载土豆骨粉阻止器 v1.1.0..."},
-        {LanguageCode::ENGLISH, "Loading Potato Bone Meal Blocker v1.1.0..."}
-    };
+    setMessage(zh, MessageKey::LOADING, "正在加载土豆骨粉阻止器 v1.1.0...");
+    setMessage(en, MessageKey::LOADING, "Loading Potato Bone Meal Blocker v1.1.0...");
 
     // Plugin enabled message
-    mMessages["enabled"] = {
-        {LanguageCode::CHINESE_SIMPLIFIED, "土豆骨粉阻止器已成功启用！"},
-        {LanguageCode::ENGLISH, "Potato Bone Meal Blocker enabled successfully!"}
-    };
+    setMessage(zh, MessageKey::ENABLED, "土豆骨粉阻止器已成功启用！");
+    setMessage(en, MessageKey::ENABLED, "Potato Bone Meal Blocker enabled successfully!");
 
     // Compatibility message
-    mMessages["compatibility"] = {
-        {LanguageCode::CHINESE_SIMPLIFIED, "兼容 LeviLamina 3 v1.2.0"},
-        {LanguageCode::ENGLISH, "Compatible with LeviLamina 3 v1.2.0"}
-    };
+    setMessage(zh, MessageKey::COMPATIBILITY, "兼容 LeviLamina 3 v1.2.0");
+    setMessage(en, MessageKey::COMPATIBILITY, "Compatible with LeviLamina 3 v1.2.0");
 
     // Performance optimization message
-    mMessages["optimization"] = {
-        {LanguageCode::CHINESE_SIMPLIFIED, "插件已初始化，具有优化的性能特性"},
-        {LanguageCode::ENGLISH, "Plugin initialized with optimized performance features"}
-    };
+    setMessage(zh, MessageKey::OPTIMIZATION, "插件已初始化，具有优化的性能特性");
+    setMessage(en, MessageKey::OPTIMIZATION, "Plugin initialized with optimized performance features");
 
     // Event listener registration message
-    mMessages["listener_registered"] = {
-        {LanguageCode::CHINESE_SIMPLIFIED, "已为 PlayerInteractBlockEvent 注册事件监听器"},
-        {LanguageCode::ENGLISH, "Event listener registered for PlayerInteractBlockEvent"}
-    };
+    setMessage(zh, MessageKey::LISTENER_REGISTERED, "已为 PlayerInteractBlockEvent 注册事件监听器");
+    setMessage(en, MessageKey::LISTENER_REGISTERED, "Event listener registered for PlayerInteractBlockEvent");
 
     // Statistics message
-    mMessages["blocked_attempt_log"] = {
-        {LanguageCode::CHINESE_SIMPLIFIED, "阻止了 {} 在位置 ({}, {}, {}) 对土豆作物使用骨粉"},
-        {LanguageCode::ENGLISH, "Prevented {} from using bone meal on potato crop at ({}, {}, {})"}
-    };
+    setMessage(zh, MessageKey::BLOCKED_ATTEMPT_LOG, "阻止了 {} 在位置 ({}, {}, {}) 对土豆作物使用骨粉");
+    setMessage(en, MessageKey::BLOCKED_ATTEMPT_LOG, "Prevented {} from using bone meal on potato crop at ({}, {}, {})");
 
     // Plugin disable message
-    mMessages["disabled"] = {
-        {LanguageCode::CHINESE_SIMPLIFIED, "土豆骨粉阻止器已禁用"},
-        {LanguageCode::ENGLISH, "Potato Bone Meal Blocker disabled"}
-    };
+    setMessage(zh, MessageKey::DISABLED, "土豆骨粉阻止器已禁用");
+    setMessage(en, MessageKey::DISABLED, "Potato Bone Meal Blocker disabled");
 
     // Error messages
-    mMessages["error_generic"] = {
-        {LanguageCode::CHINESE_SIMPLIFIED, "插件运行时发生错误"},
-        {LanguageCode::ENGLISH, "An error occurred while running the plugin"}
-    };
+    setMessage(zh, MessageKey::ERROR_GENERIC, "插件运行时发生错误");
+    setMessage(en, MessageKey::ERROR_GENERIC, "An error occurred while running the plugin");
+
+    // Coalesced feedback - replaces repeated blocked messages within one window
+    setMessage(zh, MessageKey::BLOCKED_SUMMARY, "§c骨粉在土豆作物上又被阻止了 {} 次");
+    setMessage(en, MessageKey::BLOCKED_SUMMARY, "§cBone meal was blocked on potato crops {} more times");
 }
 
-std::string_view Language::getMessage(std::string_view key) const noexcept {
-    const auto keyStr = std::string(key);
-    const auto messageIt = mMessages.find(keyStr);
-    
-    if (messageIt != mMessages.end()) {
-        const auto& languageMap = messageIt->second;
-        const auto langIt = languageMap.find(mCurrentLanguage);
-        
-        if (langIt != languageMap.end()) {
-            return langIt->second;
+std::size_t Language::loadDirectory(const std::filesystem::path& directory) {
+    std::error_code ec;
+    std::filesystem::create_directories(directory, ec);
+
+    // Write the built-in languages out once so operators can copy them for new locales
+    for (std::size_t i = 0; i < mLocales.size(); ++i) {
+        const auto path = directory / (mLocales[i] + ".lang");
+        if (std::filesystem::exists(path, ec)) {
+            continue;
         }
-        
-        // Fallback to English if current language not found
-        const auto englishIt = languageMap.find(LanguageCode::ENGLISH);
-        if (englishIt != languageMap.end()) {
-            return englishIt->second;
+        std::ofstream out(path, std::ios::binary);
+        for (std::size_t key = 0; key < KEY_COUNT; ++key) {
+            out << KEY_NAMES[key] << '=' << escape(mTable[i * KEY_COUNT + key]) << '\n';
         }
     }
-    
-    // Ultimate fallback
-    return "Message not found";
-}
 
-std::string Language::getBlockedMessage() const noexcept {
-    return std::string(getMessage("blocked_message"));
-}
-
-std::string Language::getInfoMessage() const noexcept {
-    return std::string(getMessage("info_message"));
-}
-
-std::string Language::getLoadingMessage() const noexcept {
-    return std::string(getMessage("loading"));
-}
-
-std::string Language::getEnabledMessage() const noexcept {
-    return std::string(getMessage("enabled"));
-}
+    std::size_t loaded = 0;
+    for (const auto& entry : std::filesystem::directory_iterator(directory, ec)) {
+        if (!entry.is_regular_file() || entry.path().extension() != ".lang") {
+            continue;
+        }
+        const auto language = addLanguage(entry.path().stem().string());
+        if (!language) {
+            continue;
+        }
 
-std::string Language::getCompatibilityMessage() const noexcept {
-    return std::string(getMessage("compatibility"));
+        std::ifstream in(entry.path(), std::ios::binary);
+        std::string   line;
+        while (std::getline(in, line)) {
+            auto text = trim(line);
+            if (text.starts_with("\xEF\xBB\xBF")) {
+                text.remove_prefix(3); // UTF-8 byte order mark written by some editors
+            }
+            if (text.empty() || text.front() == '#') {
+                continue;
+            }
+            const auto separator = text.find('=');
+            if (separator == std::string_view::npos) {
+                continue;
+            }
+            const auto name = trim(text.substr(0, separator));
+            for (std::size_t key = 0; key < KEY_COUNT; ++key) {
+                if (KEY_NAMES[key] == name) {
+                    setMessage(*language, static_cast<MessageKey>(key), unescape(trim(text.substr(separator + 1))));
+                    break;
+                }
+            }
+        }
+        ++loaded;
+    }
+    return loaded;
 }
 
 } // namespace potato_bonemeal_blocker
@@ -1,24 +1,75 @@
 #pragma once
 
+#include "TextFormat.h"
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
 #include <string>
-#include <unordered_map>
 #include <string_view>
+#include <vector>
 
 namespace potato_bonemeal_blocker {
 
 /**
  * @brief Language support for the Potato Bonemeal Blocker plugin
- * 
- * Provides localized messages for Chinese and English languages.
+ *
+ * Provides localized messages for Chinese and English languages, plus any
+ * additional locale found as a `<locale>.lang` file in the language directory.
  * Default language is Chinese (Simplified) for Chinese Minecraft servers.
+ *
+ * Messages live in one flat table indexed by [language][key]; lookups return
+ * views into that table and never allocate.
  */
 class Language {
 public:
-    enum class LanguageCode {
+    /**
+     * @brief Index of a loaded language
+     *
+     * The named values are always present. Locales loaded from disk are
+     * appended after them and obtained through findLanguage().
+     */
+    enum class LanguageCode : std::uint8_t {
         CHINESE_SIMPLIFIED,  // zh_CN - Default for Chinese servers
         ENGLISH             // en_US - Fallback language
     };
 
+    /**
+     * @brief Compile-time message keys
+     */
+    enum class MessageKey : std::uint8_t {
+        BLOCKED_MESSAGE,
+        INFO_MESSAGE,
+        LOADING,
+        ENABLED,
+        COMPATIBILITY,
+        OPTIMIZATION,
+        LISTENER_REGISTERED,
+        BLOCKED_ATTEMPT_LOG,
+        DISABLED,
+        ERROR_GENERIC,
+        BLOCKED_SUMMARY,
+        COUNT
+    };
+
+    static constexpr std::size_t KEY_COUNT = static_cast<std::size_t>(MessageKey::COUNT);
+
+    /// Key names as they appear in `.lang` files, indexed by MessageKey
+    static constexpr std::array<std::string_view, KEY_COUNT> KEY_NAMES = {
+        "blocked_message",
+        "info_message",
+        "loading",
+        "enabled",
+        "compatibility",
+        "optimization",
+        "listener_registered",
+        "blocked_attempt_log",
+        "disabled",
+        "error_generic",
+        "blocked_summary"
+    };
+
     /**
      * @brief Get the singleton instance of Language
      * @return Reference to the Language instance
@@ -38,41 +89,96 @@ class Language {
     LanguageCode getCurrentLanguage() const noexcept;
 
     /**
-     * @brief Get a localized message by key
+     * @brief Look up a loaded language by its locale tag
+     * @param locale Locale tag such as "zh_CN" or "en_US"
+     * @return The language code, or std::nullopt if the locale is not loaded
+     */
+    std::optional<LanguageCode> findLanguage(std::string_view locale) const noexcept;
+
+    /**
+     * @brief Get the locale tag of a loaded language
+     * @param language The language code
+     * @return Locale tag such as "zh_CN"
+     */
+    std::string_view getLocale(LanguageCode language) const noexcept;
+
+    /**
+     * @brief Get the number of loaded languages
+     * @return Count of valid LanguageCode values, built-in ones included
+     */
+    std::size_t getLanguageCount() const noexcept { return mLocales.size(); }
+
+    /**
+     * @brief Load every `<locale>.lang` file in a directory
+     *
+     * Files use one `key=value` pair per line; `#` starts a comment and `\n`
+     * in a value is a line break. Keys missing from a file fall back to English.
+     * Missing built-in files are written first so they can serve as templates.
+     *
+     * @param directory The language directory
+     * @return Number of language files loaded
+     */
+    std::size_t loadDirectory(const std::filesystem::path& directory);
+
+    /**
+     * @brief Get a localized message by key in the current language
+     * @param key The message key
+     * @return View of the localized message, valid until the next loadDirectory()
+     */
+    std::string_view getMessage(MessageKey key) const noexcept {
+        return getMessage(key, mCurrentLanguage);
+    }
+
+    /**
+     * @brief Get a localized message by key in a specific language
      * @param key The message key
-     * @return Localized message string
+     * @param language The language to look up
+     * @return View of the localized message, valid until the next loadDirectory()
      */
-    std::string_view getMessage(std::string_view key) const noexcept;
+    std::string_view getMessage(MessageKey key, LanguageCode language) const noexcept {
+        return mTable[static_cast<std::size_t>(language) * KEY_COUNT + static_cast<std::size_t>(key)];
+    }
+
+    /**
+     * @brief Append a localized message in the current language with its `{}` placeholders substituted
+     * @param out Any container with append(const char*, size_t), e.g. an ArenaString
+     * @param key The message key
+     * @param args Arguments substituted in order
+     */
+    template <class Out>
+    void formatMessage(Out& out, MessageKey key, std::initializer_list<FormatArg> args) const {
+        appendFormatted(out, getMessage(key), args);
+    }
 
     /**
      * @brief Get the blocked message for display to players
      * @return Localized blocked message with formatting
      */
-    std::string getBlockedMessage() const noexcept;
+    std::string_view getBlockedMessage() const noexcept { return getMessage(MessageKey::BLOCKED_MESSAGE); }
 
     /**
      * @brief Get the info message for display to players
      * @return Localized info message with formatting
      */
-    std::string getInfoMessage() const noexcept;
+    std::string_view getInfoMessage() const noexcept { return getMessage(MessageKey::INFO_MESSAGE); }
 
     /**
      * @brief Get the plugin loading message
      * @return Localized loading message
      */
-    std::string getLoadingMessage() const noexcept;
+    std::string_view getLoadingMessage() const noexcept { return getMessage(MessageKey::LOADING); }
 
     /**
      * @brief Get the plugin enabled message
      * @return Localized enabled message
      */
-    std::string getEnabledMessage() const noexcept;
+    std::string_view getEnabledMessage() const noexcept { return getMessage(MessageKey::ENABLED); }
 
     /**
      * @brief Get the compatibility message
      * @return Localized compatibility message
      */
-    std::string getCompatibilityMessage() const noexcept;
+    std::string_view getCompatibilityMessage() const noexcept { return getMessage(MessageKey::COMPATIBILITY); }
 
 private:
     Language() noexcept;
@@ -82,8 +188,18 @@ class Language {
 
     void initializeMessages() noexcept;
 
+    /**
+     * @brief Get or create the table row for a locale
+     * @param locale Locale tag
+     * @return The language code, or std::nullopt if the table is full
+     */
+    std::optional<LanguageCode> addLanguage(std::string_view locale);
+
+    void setMessage(LanguageCode language, MessageKey key, std::string_view message);
+
     LanguageCode mCurrentLanguage;
-    std::unordered_map<std::string, std::unordered_map<LanguageCode, std::string>> mMessages;
+    std::vector<std::string> mLocales; ///< Locale tag per LanguageCode
+    std::vector<std::string> mTable;   ///< Messages, mLocales.size() * KEY_COUNT entries
 };
 
 } // namespace potato_bonemeal_blocker
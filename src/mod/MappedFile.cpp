@@ -0,0 +1,115 @@
+#include "mod/MappedFile.h"
+
+#include <utility>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace potato_bonemeal_blocker {
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+: mData(std::exchange(other.mData, nullptr)),
+  mSize(std::exchange(other.mSize, 0)),
+  mOpen(std::exchange(other.mOpen, false)) {}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        close();
+        mData = std::exchange(other.mData, nullptr);
+        mSize = std::exchange(other.mSize, 0);
+        mOpen = std::exchange(other.mOpen, false);
+    }
+    return *this;
+}
+
+bool MappedFile::open(const std::filesystem::path& path) noexcept {
+    close();
+
+#if defined(_WIN32)
+    const HANDLE file = CreateFileW(
+        path.c_str(),
+        GENERIC_READ,
+        FILE_SHARE_READ | FILE_SHARE_WRITE,
+        nullptr,
+        OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL,
+        nullptr
+    );
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+
+    LARGE_INTEGER size{};
+    if (!GetFileSizeEx(file, &size)) {
+        CloseHandle(file);
+        return false;
+    }
+    if (size.QuadPart == 0) {
+        CloseHandle(file);
+        mOpen = true;
+        return true;
+    }
+
+    // The view keeps the mapping alive, so both handles can be closed right away
+    const HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (mapping == nullptr) {
+        return false;
+    }
+    const void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if (view == nullptr) {
+        return false;
+    }
+    mData = view;
+    mSize = static_cast<std::size_t>(size.QuadPart);
+#else
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat info{};
+    if (::fstat(fd, &info) != 0) {
+        ::close(fd);
+        return false;
+    }
+    if (info.st_size == 0) {
+        ::close(fd);
+        mOpen = true;
+        return true;
+    }
+
+    void* view = ::mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (view == MAP_FAILED) {
+        return false;
+    }
+    mData = view;
+    mSize = static_cast<std::size_t>(info.st_size);
+#endif
+
+    mOpen = true;
+    return true;
+}
+
+void MappedFile::close() noexcept {
+    if (mData != nullptr) {
+#if defined(_WIN32)
+        UnmapViewOfFile(mData);
+#else
+        ::munmap(const_cast<void*>(mData), mSize);
+#endif
+    }
+    mData = nullptr;
+    mSize = 0;
+    mOpen = false;
+}
+
+} // namespace potato_bonemeal_blocker
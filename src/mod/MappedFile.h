@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <span>
+
+namespace potato_bonemeal_blocker {
+
+/**
+ * @brief Read-only memory mapping of a whole file
+ *
+ * Uses MapViewOfFile on Windows and mmap elsewhere. The mapping is a snapshot
+ * of the file size at open(); bytes appended later are not visible.
+ */
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile() { close(); }
+
+    MappedFile(const MappedFile&)            = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    /**
+     * @brief Map a file, replacing any previous mapping
+     * @param path The file to map
+     * @return true if the file was opened; empty files map to an empty span
+     */
+    bool open(const std::filesystem::path& path) noexcept;
+
+    /**
+     * @brief Unmap the file
+     */
+    void close() noexcept;
+
+    /**
+     * @brief Check whether a file is mapped
+     * @return true after a successful open()
+     */
+    [[nodiscard]] bool isOpen() const noexcept { return mOpen; }
+
+    /**
+     * @brief Get the mapped bytes
+     * @return View of the whole file
+     */
+    [[nodiscard]] std::span<const std::byte> data() const noexcept {
+        return {static_cast<const std::byte*>(mData), mSize};
+    }
+
+private:
+    const void* mData = nullptr;
+    std::size_t mSize = 0;
+    bool        mOpen = false;
+};
+
+} // namespace potato_bonemeal_blocker
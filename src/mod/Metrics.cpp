@@ -0,0 +1,229 @@
+#include "mod/Metrics.h"
+#include "mod/TextFormat.h"
+
+#include <bit>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace potato_bonemeal_blocker::metrics {
+
+namespace {
+
+/**
+ * @brief All thread blocks ever registered; blocks are never freed so readers can't race thread exit
+ */
+struct Registry {
+    std::mutex                                  mutex;
+    std::vector<std::unique_ptr<ThreadMetrics>> threads;
+};
+
+Registry& registry() noexcept {
+    static Registry instance;
+    return instance;
+}
+
+template <class Visitor>
+void forEachThread(Visitor&& visitor) {
+    auto&      reg = registry();
+    const std::lock_guard lock(reg.mutex);
+    for (const auto& thread : reg.threads) {
+        visitor(*thread);
+    }
+}
+
+struct HistogramSnapshot {
+    std::array<std::uint64_t, Histogram::BUCKET_COUNT> buckets{};
+    std::uint64_t                                      sum   = 0;
+    std::uint64_t                                      count = 0;
+};
+
+HistogramSnapshot snapshot(Stage stage) {
+    HistogramSnapshot result;
+    forEachThread([&](const ThreadMetrics& thread) {
+        thread.histograms[static_cast<std::size_t>(stage)].accumulate(result.buckets, result.sum);
+    });
+    for (const auto bucket : result.buckets) {
+        result.count += bucket;
+    }
+    return result;
+}
+
+} // namespace
+
+std::size_t Histogram::bucketFor(std::uint64_t value) noexcept {
+    if (value < SUB_BUCKETS) {
+        return static_cast<std::size_t>(value);
+    }
+    const auto exponent = static_cast<unsigned>(std::bit_width(value) - 1);
+    const auto sub      = (value >> (exponent - SUB_BUCKET_BITS)) & (SUB_BUCKETS - 1);
+    return (exponent - SUB_BUCKET_BITS + 1) * SUB_BUCKETS + static_cast<std::size_t>(sub);
+}
+
+std::uint64_t Histogram::lowerBound(std::size_t bucket) noexcept {
+    if (bucket < SUB_BUCKETS) {
+        return bucket;
+    }
+    const auto group    = bucket / SUB_BUCKETS;
+    const auto sub      = bucket % SUB_BUCKETS;
+    const auto exponent = group + SUB_BUCKET_BITS - 1;
+    return static_cast<std::uint64_t>(SUB_BUCKETS + sub) << (exponent - SUB_BUCKET_BITS);
+}
+
+void Histogram::accumulate(std::array<std::uint64_t, BUCKET_COUNT>& buckets, std::uint64_t& sum) const noexcept {
+    for (std::size_t i = 0; i < BUCKET_COUNT; ++i) {
+        buckets[i] += mBuckets[i].load(std::memory_order_relaxed);
+    }
+    sum += mSum.load(std::memory_order_relaxed);
+}
+
+ThreadMetrics& local() noexcept {
+    thread_local ThreadMetrics* block = [] {
+        auto& reg = registry();
+        auto  owned = std::make_unique<ThreadMetrics>();
+        auto* raw   = owned.get();
+
+        const std::lock_guard lock(reg.mutex);
+        reg.threads.push_back(std::move(owned));
+        return raw;
+    }();
+    return *block;
+}
+
+std::uint64_t total(Counter counter) noexcept {
+    std::uint64_t sum = 0;
+    forEachThread([&](const ThreadMetrics& thread) {
+        sum += thread.counters[static_cast<std::size_t>(counter)].load(std::memory_order_relaxed);
+    });
+    return sum;
+}
+
+std::uint64_t quantile(Stage stage, double quantile) noexcept {
+    const auto data = snapshot(stage);
+    if (data.count == 0) {
+        return 0;
+    }
+    const auto    rank = static_cast<std::uint64_t>(quantile * static_cast<double>(data.count - 1));
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < Histogram::BUCKET_COUNT; ++i) {
+        seen += data.buckets[i];
+        if (seen > rank) {
+            return Histogram::lowerBound(i);
+        }
+    }
+    return Histogram::lowerBound(Histogram::BUCKET_COUNT - 1);
+}
+
+void renderPrometheus(std::string& out) {
+    if constexpr (!ENABLED) {
+        out += "# potato-bonemeal-blocker was built without PBB_ENABLE_METRICS\n";
+        return;
+    }
+
+    out += "# HELP pbb_events_total PlayerInteractBlockEvent handler branches taken\n";
+    out += "# TYPE pbb_events_total counter\n";
+    for (std::size_t i = 0; i < COUNTER_COUNT; ++i) {
+        appendFormatted(
+            out,
+            "pbb_events_total{branch=\"{}\"} {}\n",
+            {COUNTER_NAMES[i], total(static_cast<Counter>(i))}
+        );
+    }
+
+    out += "# HELP pbb_stage_latency_ns Handler stage latency in nanoseconds\n";
+    out += "# TYPE pbb_stage_latency_ns histogram\n";
+    for (std::size_t stage = 0; stage < STAGE_COUNT; ++stage) {
+        const auto data = snapshot(static_cast<Stage>(stage));
+
+        // Only buckets that received samples are emitted; cumulative counts stay exact
+        std::uint64_t cumulative = 0;
+        for (std::size_t i = 0; i + 1 < Histogram::BUCKET_COUNT; ++i) {
+            if (data.buckets[i] == 0) {
+                continue;
+            }
+            cumulative += data.buckets[i];
+            appendFormatted(
+                out,
+                "pbb_stage_latency_ns_bucket{stage=\"{}\",le=\"{}\"} {}\n",
+                {STAGE_NAMES[stage], Histogram::lowerBound(i + 1) - 1, cumulative}
+            );
+        }
+        appendFormatted(
+            out,
+            "pbb_stage_latency_ns_bucket{stage=\"{}\",le=\"+Inf\"} {}\n",
+            {STAGE_NAMES[stage], data.count}
+        );
+        appendFormatted(out, "pbb_stage_latency_ns_sum{stage=\"{}\"} {}\n", {STAGE_NAMES[stage], data.sum});
+        appendFormatted(out, "pbb_stage_latency_ns_count{stage=\"{}\"} {}\n", {STAGE_NAMES[stage], data.count});
+    }
+}
+
+void renderSummary(std::string& out) {
+    if constexpr (!ENABLED) {
+        out += "Metrics were disabled at build time (PBB_ENABLE_METRICS)\n";
+        return;
+    }
+
+    for (std::size_t i = 0; i < COUNTER_COUNT; ++i) {
+        appendFormatted(out, "{}: {}\n", {COUNTER_NAMES[i], total(static_cast<Counter>(i))});
+    }
+    for (std::size_t i = 0; i < STAGE_COUNT; ++i) {
+        const auto stage = static_cast<Stage>(i);
+        appendFormatted(
+            out,
+            "{}: p50 {} ns, p99 {} ns, max bucket {} ns\n",
+            {STAGE_NAMES[i], quantile(stage, 0.5), quantile(stage, 0.99), quantile(stage, 1.0)}
+        );
+    }
+}
+
+void Exporter::start(std::filesystem::path path, std::chrono::seconds interval) {
+    if (!ENABLED || mRunning.load()) {
+        return;
+    }
+    mPath     = std::move(path);
+    mInterval = interval;
+    mRunning.store(true);
+    mThread = std::thread([this] {
+        auto nextDump = std::chrono::steady_clock::now() + mInterval;
+        while (mRunning.load()) {
+            // Sleep in short steps so stop() does not wait for a whole interval
+            std::this_thread::sleep_for(std::chrono::milliseconds(200));
+            if (std::chrono::steady_clock::now() >= nextDump) {
+                writeFile();
+                nextDump += mInterval;
+            }
+        }
+        writeFile();
+    });
+}
+
+void Exporter::stop() noexcept {
+    if (!mRunning.exchange(false)) {
+        return;
+    }
+    if (mThread.joinable()) {
+        mThread.join();
+    }
+}
+
+void Exporter::writeFile() const noexcept {
+    try {
+        std::string text;
+        renderPrometheus(text);
+
+        auto temporary = mPath;
+        temporary += ".tmp";
+        {
+            std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+            out.write(text.data(), static_cast<std::streamsize>(text.size()));
+        }
+        std::error_code ec;
+        std::filesystem::rename(temporary, mPath, ec);
+    } catch (...) {
+        // Metrics export is best effort
+    }
+}
+
+} // namespace potato_bonemeal_blocker::metrics
@@ -0,0 +1,256 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <thread>
+
+namespace potato_bonemeal_blocker::metrics {
+
+/**
+ * @brief Hot-path telemetry: per-thread branch counters and log-linear latency histograms
+ *
+ * Every thread that records a metric gets its own block of relaxed atomics,
+ * so updates never contend. Readers (the stats command and the exporter
+ * thread) sum the blocks of all threads.
+ *
+ * All recording goes through the PBB_METRIC_* macros, which expand to
+ * nothing unless the plugin is built with PBB_ENABLE_METRICS.
+ */
+
+#if defined(PBB_ENABLE_METRICS)
+inline constexpr bool ENABLED = true;
+#else
+inline constexpr bool ENABLED = false;
+#endif
+
+/**
+ * @brief Branch and outcome counters
+ */
+enum class Counter : std::uint8_t {
+    EVENTS,             // PlayerInteractBlockEvent dispatched to the handler
+    NOT_BONE_MEAL,      // Early return: held item is not covered by any rule
+    DIRECT_BLOCK,       // Block taken from event.block()
+    FALLBACK_BLOCK,     // Block looked up because event.block() was empty
+    BLOCK_CACHE_HIT,    // Fallback lookup served by the block lookup cache
+    BLOCKED,            // Event cancelled
+    BLOCK_EXCEPTION,    // Fallback block lookup failed
+    HANDLER_EXCEPTION,  // Exception reaching the handler boundary
+    REGION_LOOKUP,      // Rules chosen through the region index
+    BYPASS_HIT,         // Exemption decision found in the bypass cache
+    BYPASS_MISS,        // Exemption decision computed on the event path
+    CLICK_RATE_DROPPED, // Cancelled without evaluation: player flagged by the auto-clicker detector
+    FERTILIZED,         // Crop fertilized by a dispenser or another non-player source
+    FERTILIZER_BLOCKED, // Non-player fertilization refused by the growth pipeline
+    COUNT
+};
+
+/**
+ * @brief Timed stages of the handler
+ */
+enum class Stage : std::uint8_t {
+    HANDLER,        // Whole onPlayerInteractBlock call
+    BLOCK_FALLBACK, // Block lookup when event.block() is empty, cache hits included
+    BLOCK_SOURCE,   // getBlockSourceFromMainChunkSource() lookup on a block cache miss
+    FEEDBACK,       // sendBlockedMessage
+    LOG,            // logBlockedAttempt
+    FERTILIZER,     // Growth pipeline decision for a non-player fertilization
+    COUNT
+};
+
+inline constexpr std::size_t COUNTER_COUNT = static_cast<std::size_t>(Counter::COUNT);
+inline constexpr std::size_t STAGE_COUNT   = static_cast<std::size_t>(Stage::COUNT);
+
+inline constexpr std::array<std::string_view, COUNTER_COUNT> COUNTER_NAMES =
+    {"events",
+     "not_bone_meal",
+     "direct_block",
+     "fallback_block",
+     "block_cache_hit",
+     "blocked",
+     "block_exception",
+     "handler_exception",
+     "region_lookup",
+     "bypass_hit",
+     "bypass_miss",
+     "click_rate_dropped",
+     "fertilized",
+     "fertilizer_blocked"};
+
+inline constexpr std::array<std::string_view, STAGE_COUNT> STAGE_NAMES =
+    {"handler", "block_fallback", "block_source", "feedback", "log", "fertilizer"};
+
+/**
+ * @brief Fixed-bucket log-linear histogram of nanosecond latencies
+ *
+ * Values below 4 get one bucket each; above that every power of two is split
+ * into 4 linear sub-buckets, giving <= 25% relative error over the full
+ * 64-bit range with 252 buckets and no configuration.
+ */
+class Histogram {
+public:
+    static constexpr unsigned    SUB_BUCKET_BITS = 2;
+    static constexpr std::size_t SUB_BUCKETS     = std::size_t{1} << SUB_BUCKET_BITS;
+    static constexpr std::size_t BUCKET_COUNT    = (64 - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+    /**
+     * @brief Map a value to its bucket index
+     * @param value The recorded value
+     * @return Bucket index in [0, BUCKET_COUNT)
+     */
+    static std::size_t bucketFor(std::uint64_t value) noexcept;
+
+    /**
+     * @brief Get the smallest value that falls into a bucket
+     * @param bucket Bucket index
+     * @return Inclusive lower bound of the bucket
+     */
+    static std::uint64_t lowerBound(std::size_t bucket) noexcept;
+
+    /**
+     * @brief Record one value; only the owning thread may call this
+     * @param value The value to record
+     */
+    void record(std::uint64_t value) noexcept {
+        auto& bucket = mBuckets[bucketFor(value)];
+        bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        mSum.store(mSum.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Add this histogram's buckets into a plain snapshot
+     * @param buckets Destination bucket counts
+     * @param sum Destination sum of recorded values
+     */
+    void accumulate(std::array<std::uint64_t, BUCKET_COUNT>& buckets, std::uint64_t& sum) const noexcept;
+
+private:
+    std::array<std::atomic<std::uint64_t>, BUCKET_COUNT> mBuckets{};
+    std::atomic<std::uint64_t>                           mSum{0};
+};
+
+/**
+ * @brief Metric block owned by a single thread
+ */
+struct ThreadMetrics {
+    std::array<std::atomic<std::uint64_t>, COUNTER_COUNT> counters{};
+    std::array<Histogram, STAGE_COUNT>                    histograms{};
+};
+
+/**
+ * @brief Get the calling thread's metric block, registering it on first use
+ * @return The calling thread's metrics
+ */
+ThreadMetrics& local() noexcept;
+
+/**
+ * @brief Increment a counter of the calling thread
+ * @param counter The counter to increment
+ */
+inline void increment(Counter counter) noexcept {
+    auto& value = local().counters[static_cast<std::size_t>(counter)];
+    value.store(value.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Records the lifetime of a scope into a stage histogram
+ */
+class ScopedTimer {
+public:
+    explicit ScopedTimer(Stage stage) noexcept : mStage(stage), mStart(std::chrono::steady_clock::now()) {}
+    ~ScopedTimer() {
+        const auto elapsed = std::chrono::steady_clock::now() - mStart;
+        local().histograms[static_cast<std::size_t>(mStage)].record(
+            static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count())
+        );
+    }
+
+    ScopedTimer(const ScopedTimer&)            = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+    Stage                                 mStage;
+    std::chrono::steady_clock::time_point mStart;
+};
+
+/**
+ * @brief Sum of all threads' counters
+ * @param counter The counter to read
+ * @return Total count
+ */
+std::uint64_t total(Counter counter) noexcept;
+
+/**
+ * @brief Estimate a latency quantile of a stage from the merged histograms
+ * @param stage The stage
+ * @param quantile Quantile in [0, 1]
+ * @return Lower bound of the bucket holding the quantile, in nanoseconds
+ */
+std::uint64_t quantile(Stage stage, double quantile) noexcept;
+
+/**
+ * @brief Render all metrics in the Prometheus text exposition format
+ * @param out Buffer the text is appended to
+ */
+void renderPrometheus(std::string& out);
+
+/**
+ * @brief Render a short human-readable summary, one line per entry
+ * @param out Buffer the text is appended to
+ */
+void renderSummary(std::string& out);
+
+/**
+ * @brief Background thread that periodically writes renderPrometheus() to a file
+ *
+ * The file is written to a temporary name and renamed, so scrapers never
+ * observe a partial file.
+ */
+class Exporter {
+public:
+    Exporter() = default;
+    ~Exporter() { stop(); }
+
+    Exporter(const Exporter&)            = delete;
+    Exporter& operator=(const Exporter&) = delete;
+
+    /**
+     * @brief Start the exporter thread; does nothing when metrics are compiled out
+     * @param path Destination file
+     * @param interval Time between dumps
+     */
+    void start(std::filesystem::path path, std::chrono::seconds interval);
+
+    /**
+     * @brief Write a final dump and stop the exporter thread
+     */
+    void stop() noexcept;
+
+private:
+    void writeFile() const noexcept;
+
+    std::filesystem::path mPath;
+    std::chrono::seconds  mInterval{60};
+    std::thread           mThread;
+    std::atomic<bool>     mRunning{false};
+};
+
+} // namespace potato_bonemeal_blocker::metrics
+
+#if defined(PBB_ENABLE_METRICS)
+#define PBB_METRIC_CONCAT_IMPL(a, b) a##b
+#define PBB_METRIC_CONCAT(a, b)      PBB_METRIC_CONCAT_IMPL(a, b)
+#define PBB_METRIC_COUNT(counter)                                                                                      \
+    ::potato_bonemeal_blocker::metrics::increment(::potato_bonemeal_blocker::metrics::Counter::counter)
+#define PBB_METRIC_SCOPE(stage)                                                                                        \
+    const ::potato_bonemeal_blocker::metrics::ScopedTimer PBB_METRIC_CONCAT(pbbMetricTimer, __LINE__)(                 \
+        ::potato_bonemeal_blocker::metrics::Stage::stage                                                               \
+    )
+#else
+#define PBB_METRIC_COUNT(counter) ((void)0)
+#define PBB_METRIC_SCOPE(stage)   ((void)0)
+#endif
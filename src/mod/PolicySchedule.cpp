@@ -0,0 +1,163 @@
+#include "mod/PolicySchedule.h"
+
+#include <algorithm>
+#include <array>
+#include <utility>
+
+namespace potato_bonemeal_blocker {
+
+namespace {
+
+constexpr std::array<std::string_view, 7> SHORT_DAYS = {"sun", "mon", "tue", "wed", "thu", "fri", "sat"};
+constexpr std::array<std::string_view, 7> LONG_DAYS =
+    {"sunday", "monday", "tuesday", "wednesday", "thursday", "friday", "saturday"};
+
+std::int64_t floorMod(std::int64_t value, std::int64_t modulus) noexcept {
+    const auto rest = value % modulus;
+    return rest < 0 ? rest + modulus : rest;
+}
+
+/**
+ * @brief Call a function with the second of the week each weekly window of a policy opens at
+ */
+template <typename Fn>
+void forEachWeeklyStart(const PolicySchedule::Policy& policy, Fn&& fn) {
+    const auto offset = static_cast<std::int64_t>(policy.startMinute) * 60;
+    if (policy.days.empty()) {
+        for (std::int64_t day = 0; day < 7; ++day) {
+            fn(day * PolicySchedule::DAY_SECONDS + offset);
+        }
+        return;
+    }
+    for (const auto day : policy.days) {
+        fn(static_cast<std::int64_t>(day) * PolicySchedule::DAY_SECONDS + offset);
+    }
+}
+
+} // namespace
+
+std::optional<std::uint8_t> PolicySchedule::parseDay(std::string_view name) noexcept {
+    for (std::uint8_t day = 0; day < SHORT_DAYS.size(); ++day) {
+        if (name == SHORT_DAYS[day] || name == LONG_DAYS[day]) {
+            return day;
+        }
+    }
+    return std::nullopt;
+}
+
+std::string_view PolicySchedule::dayName(std::uint8_t day) noexcept {
+    return day < SHORT_DAYS.size() ? SHORT_DAYS[day] : "?";
+}
+
+bool PolicySchedule::isOpen(const Policy& policy, const Clock& clock) noexcept {
+    const auto length = static_cast<std::int64_t>(policy.minutes) * 60;
+    if (policy.afterStartMinutes >= 0) {
+        const auto start = static_cast<std::int64_t>(policy.afterStartMinutes) * 60;
+        return clock.uptimeSeconds >= start && clock.uptimeSeconds < start + length;
+    }
+    bool open = false;
+    forEachWeeklyStart(policy, [&](std::int64_t start) {
+        open = open || floorMod(clock.weekSeconds - start, WEEK_SECONDS) < length;
+    });
+    return open;
+}
+
+std::optional<std::int64_t> PolicySchedule::secondsUntilChange(const Policy& policy, const Clock& clock) noexcept {
+    const auto length = static_cast<std::int64_t>(policy.minutes) * 60;
+    if (policy.afterStartMinutes >= 0) {
+        const auto start = static_cast<std::int64_t>(policy.afterStartMinutes) * 60;
+        if (clock.uptimeSeconds < start) {
+            return start - clock.uptimeSeconds;
+        }
+        if (clock.uptimeSeconds < start + length) {
+            return start + length - clock.uptimeSeconds;
+        }
+        return std::nullopt;
+    }
+
+    // The nearest opening of any window, or closing of an open one
+    auto next = WEEK_SECONDS;
+    forEachWeeklyStart(policy, [&](std::int64_t start) {
+        const auto sinceStart = floorMod(clock.weekSeconds - start, WEEK_SECONDS);
+        if (sinceStart < length) {
+            next = std::min(next, length - sinceStart);
+        }
+        if (sinceStart > 0) {
+            next = std::min(next, WEEK_SECONDS - sinceStart);
+        }
+    });
+    return next;
+}
+
+int PolicySchedule::findActive(const std::vector<Policy>& policies, const Clock& clock) noexcept {
+    for (std::size_t i = 0; i < policies.size(); ++i) {
+        if (isOpen(policies[i], clock)) {
+            return static_cast<int>(i);
+        }
+    }
+    return NONE;
+}
+
+void PolicySchedule::configure(std::vector<Policy> policies, const Clock& clock) {
+    mPolicies = std::move(policies);
+    mOpen.assign(mPolicies.size(), 0);
+    mDue.assign(mPolicies.size(), -1);
+    mWheel.reset(static_cast<std::uint64_t>(clock.monotonicSeconds));
+    for (std::uint32_t i = 0; i < mPolicies.size(); ++i) {
+        arm(i, clock);
+    }
+    mActive  = findActive(mPolicies, clock);
+    mChanges = 0;
+}
+
+bool PolicySchedule::advance(const Clock& clock) {
+    bool fired = false;
+    mWheel.advance(static_cast<std::uint64_t>(clock.monotonicSeconds), [&](std::uint32_t index) {
+        arm(index, clock);
+        fired = true;
+    });
+    if (!fired) [[likely]] {
+        return false;
+    }
+
+    // The first open policy wins; only a change of winner needs a new snapshot
+    auto active = NONE;
+    for (std::size_t i = 0; i < mOpen.size(); ++i) {
+        if (mOpen[i] != 0) {
+            active = static_cast<int>(i);
+            break;
+        }
+    }
+    if (active == mActive) {
+        return false;
+    }
+    mActive = active;
+    ++mChanges;
+    return true;
+}
+
+std::optional<std::int64_t> PolicySchedule::secondsUntilNextCheck(const Clock& clock) const noexcept {
+    std::optional<std::int64_t> next;
+    for (const auto due : mDue) {
+        if (due >= 0) {
+            const auto seconds = std::max<std::int64_t>(due - clock.monotonicSeconds, 0);
+            next               = next ? std::min(*next, seconds) : seconds;
+        }
+    }
+    return next;
+}
+
+void PolicySchedule::arm(std::uint32_t index, const Clock& clock) {
+    const auto& policy = mPolicies[index];
+    mOpen[index]       = isOpen(policy, clock) ? 1 : 0;
+
+    const auto until = secondsUntilChange(policy, clock);
+    if (!until) {
+        mDue[index] = -1;
+        return;
+    }
+    mDue[index] = clock.monotonicSeconds + std::min(*until, RESYNC_SECONDS);
+    mWheel.schedule(static_cast<std::uint64_t>(mDue[index]), index);
+}
+
+} // namespace potato_bonemeal_blocker
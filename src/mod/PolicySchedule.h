@@ -0,0 +1,150 @@
+#pragma once
+
+#include "RuleMatcher.h"
+#include "TimerWheel.h"
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace potato_bonemeal_blocker {
+
+/**
+ * @brief Time-boxed rule sets that replace the top-level rules while their window is open
+ *
+ * A window is either weekly, opening at a local time on some days of the
+ * week, or relative to the plugin start. The first open policy in
+ * configuration order is in force.
+ *
+ * Windows are not checked per interaction. Each policy keeps one timer in a
+ * TimerWheel of one-second units, due at its next boundary; the plugin
+ * advances the wheel from the server tick and recompiles the rule snapshot
+ * only when the policy in force changes. Timers are capped at RESYNC_SECONDS
+ * and re-armed from the wall clock, so clock steps and daylight saving
+ * changes are picked up within that time.
+ *
+ * Must only be touched from the server thread.
+ */
+class PolicySchedule {
+public:
+    /// Policies one configuration may define
+    static constexpr std::size_t MAX_POLICIES = 64;
+
+    /// Longest a timer runs before its window is re-evaluated against the wall clock
+    static constexpr std::int64_t RESYNC_SECONDS = 3600;
+
+    static constexpr std::int64_t DAY_SECONDS  = 24 * 60 * 60;
+    static constexpr std::int64_t WEEK_SECONDS = 7 * DAY_SECONDS;
+
+    /// No policy in force
+    static constexpr int NONE = -1;
+
+    /**
+     * @brief One time-boxed rule set
+     */
+    struct Policy {
+        std::string               name;
+        std::vector<std::uint8_t> days;                   ///< Weekdays, 0 = Sunday; empty means every day
+        std::int32_t              startMinute       = -1; ///< Local minute of the day the window opens, or -1
+        std::int32_t              afterStartMinutes = -1; ///< Minutes after the plugin started, or -1
+        std::uint32_t             minutes           = 60; ///< Length of the window
+        std::vector<GrowthRule>   rules;                  ///< In force instead of the top-level rules; may be empty
+
+        bool operator==(const Policy&) const = default;
+    };
+
+    /**
+     * @brief The times a window is judged against, read once per second at most
+     */
+    struct Clock {
+        std::int64_t monotonicSeconds = 0; ///< Drives the timer wheel
+        std::int64_t uptimeSeconds    = 0; ///< Since the plugin was enabled
+        std::int64_t weekSeconds      = 0; ///< Local time since Sunday 00:00
+    };
+
+    /**
+     * @brief Parse a weekday name
+     * @param name "sun" to "sat" or the full English name, lower case
+     * @return 0 for Sunday to 6 for Saturday, or std::nullopt
+     */
+    [[nodiscard]] static std::optional<std::uint8_t> parseDay(std::string_view name) noexcept;
+
+    /**
+     * @brief Get the short name of a weekday
+     * @param day 0 for Sunday to 6 for Saturday
+     */
+    [[nodiscard]] static std::string_view dayName(std::uint8_t day) noexcept;
+
+    /**
+     * @brief Check whether a policy's window is open
+     * @param policy The policy
+     * @param clock Current times
+     */
+    [[nodiscard]] static bool isOpen(const Policy& policy, const Clock& clock) noexcept;
+
+    /**
+     * @brief Get the seconds until a policy's window next opens or closes
+     * @param policy The policy
+     * @param clock Current times
+     * @return At least 1, or std::nullopt if an uptime window already closed
+     */
+    [[nodiscard]] static std::optional<std::int64_t>
+    secondsUntilChange(const Policy& policy, const Clock& clock) noexcept;
+
+    /**
+     * @brief Find the policy in force without arming any timer
+     * @param policies The policies, in priority order
+     * @param clock Current times
+     * @return Index of the first open policy, or NONE
+     */
+    [[nodiscard]] static int findActive(const std::vector<Policy>& policies, const Clock& clock) noexcept;
+
+    /**
+     * @brief Replace the policies, evaluate them and arm one timer each
+     * @param policies The policies, in priority order
+     * @param clock Current times
+     */
+    void configure(std::vector<Policy> policies, const Clock& clock);
+
+    /**
+     * @brief Fire the timers due up to the clock's monotonic time and re-evaluate their policies
+     * @param clock Current times
+     * @return true if the policy in force changed
+     */
+    bool advance(const Clock& clock);
+
+    /**
+     * @brief Get the policy in force
+     * @return The policy, or nullptr if the top-level rules apply
+     */
+    [[nodiscard]] const Policy* getActive() const noexcept {
+        return mActive == NONE ? nullptr : &mPolicies[static_cast<std::size_t>(mActive)];
+    }
+
+    /**
+     * @brief Get the seconds until the next timer fires
+     * @param clock Current times
+     * @return Seconds, or std::nullopt if no window will open or close again
+     */
+    [[nodiscard]] std::optional<std::int64_t> secondsUntilNextCheck(const Clock& clock) const noexcept;
+
+    [[nodiscard]] const std::vector<Policy>& getPolicies() const noexcept { return mPolicies; }
+    [[nodiscard]] std::uint64_t              getChangeCount() const noexcept { return mChanges; }
+
+private:
+    /**
+     * @brief Evaluate one policy and arm its timer for the next boundary
+     */
+    void arm(std::uint32_t index, const Clock& clock);
+
+    std::vector<Policy>       mPolicies;
+    std::vector<std::uint8_t> mOpen; ///< Per policy: window open at its last evaluation
+    std::vector<std::int64_t> mDue;  ///< Per policy: monotonic second its timer fires, or -1
+    TimerWheel                mWheel;
+    int                       mActive  = NONE;
+    std::uint64_t             mChanges = 0; ///< Times the policy in force changed since configure()
+};
+
+} // namespace potato_bonemeal_blocker
@@ -1,8 +1,20 @@
 #include "mod/PotatoBoneMealBlocker.h"
+#include "mod/GrowthPipeline.h"
 #include "mod/Language.h"
+#include "mod/Commands.h"
+#include "mod/Metrics.h"
+#include "mod/StatsFormat.h"
+#include "mod/TextFormat.h"
 #include "ll/api/mod/RegisterHelper.h"
 #include "ll/api/event/EventBus.h"
+#include "ll/api/event/player/PlayerDestroyBlockEvent.h"
+#include "ll/api/event/player/PlayerDisconnectEvent.h"
+#include "ll/api/event/player/PlayerJoinEvent.h"
+#include "ll/api/event/player/PlayerPlaceBlockEvent.h"
+#include "ll/api/service/Bedrock.h"
+#include "mc/server/commands/CommandPermissionLevel.h"
 #include "mc/world/level/block/Block.h"
+#include "mc/world/level/block/BlockLegacy.h"
 #include "mc/world/item/ItemStack.h"
 #include "mc/world/actor/player/Player.h"
 #include "mc/world/level/BlockPos.h"
@@ -10,12 +22,144 @@
 #include "mc/world/level/dimension/Dimension.h"
 #include "mc/world/level/BlockSource.h"
 
+#include <algorithm>
+#include <chrono>
+#include <ctime>
+#include <new>
+#include <optional>
+#include <span>
 #include <string_view>
-#include <sstream>
-#include <iomanip>
+#include <utility>
 
 namespace potato_bonemeal_blocker {
 
+namespace {
+
+/// Ticks between checks for ended feedback coalescing windows
+constexpr std::uint32_t FEEDBACK_FLUSH_INTERVAL_TICKS = 10;
+
+/// Interval between metrics file dumps
+constexpr std::chrono::seconds METRICS_EXPORT_INTERVAL{60};
+
+/// Ticks between hand-offs of partially filled trace buffers to the writer thread
+constexpr std::uint32_t TRACE_FLUSH_INTERVAL_TICKS = 20;
+
+/// Ticks between checks for a configuration parsed by the watcher; also reclaims retired snapshots
+constexpr std::uint32_t CONFIG_POLL_INTERVAL_TICKS = 20;
+
+/// Ticks between re-evaluations of online players' exemptions; LeviLamina has no permission-change event
+constexpr std::uint32_t BYPASS_REFRESH_INTERVAL_TICKS = 100;
+
+/// Ticks between checks whether the interaction listener is still needed
+constexpr std::uint32_t INTERACT_RELEASE_INTERVAL_TICKS = 20;
+
+/// Ticks between re-scans of online players' selected items; hooks catch changes, this repairs drift
+constexpr std::uint32_t HELD_ITEM_REFRESH_INTERVAL_TICKS = 200;
+
+/// Ticks between hand-offs of blocked dispenser attempts to statistics and the log
+constexpr std::uint32_t GROWTH_FLUSH_INTERVAL_TICKS = 20;
+
+/// Item dispensers and other non-player sources are judged as
+constexpr std::string_view FERTILIZER_ITEM_NAME = "minecraft:bone_meal";
+
+/// Chunks counted around every online player by a crop census, in each direction
+constexpr int CENSUS_RADIUS_CHUNKS = 4;
+
+/// Blocked-attempt statistics file inside the plugin data directory
+constexpr std::string_view STATS_FILE_NAME = "blocked-stats.pbbs";
+
+/// Server ticks between publishing counters to the host share and checking it for a new configuration
+constexpr std::uint32_t HOST_SHARE_INTERVAL_TICKS = 20;
+
+/// Interval between modification checks of the configuration file
+constexpr std::chrono::milliseconds CONFIG_WATCH_INTERVAL{1000};
+
+std::int64_t steadyMillis() noexcept {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+std::int64_t steadyNanos() noexcept {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+std::int64_t epochMillis() noexcept {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch())
+        .count();
+}
+
+/**
+ * @brief Get the local time as seconds since Sunday 00:00
+ */
+std::int64_t localWeekSeconds() noexcept {
+    const auto now   = std::time(nullptr);
+    std::tm    local = {};
+#if defined(_WIN32)
+    localtime_s(&local, &now);
+#else
+    localtime_r(&now, &local);
+#endif
+    return ((static_cast<std::int64_t>(local.tm_wday) * 24 + local.tm_hour) * 60 + local.tm_min) * 60 + local.tm_sec;
+}
+
+/**
+ * @brief Resolves rule names through the game's item and block registries
+ */
+class RegistryResolver final : public RuleMatcher::Resolver {
+public:
+    [[nodiscard]] std::optional<std::int16_t> resolveItem(std::string_view name) const override {
+        const auto itemStack = ItemStack::create(std::string(name));
+        if (!itemStack || itemStack->isNull()) {
+            return std::nullopt;
+        }
+        return itemStack->getId();
+    }
+
+    [[nodiscard]] std::optional<std::uint32_t>
+    resolveBlock(std::string_view name, std::uint8_t growthStage) const override {
+        // Crop growth stages map onto the legacy data value of the block permutation
+        const auto block = Block::tryGetFromRegistry(name, growthStage);
+        if (!block) {
+            return std::nullopt;
+        }
+        return block->getRuntimeId();
+    }
+};
+
+/**
+ * @brief Add the block type of every rule's crop to a list, once each
+ */
+void appendRuleTypes(std::span<const GrowthRule> rules, std::vector<const BlockLegacy*>& types) {
+    for (const auto& rule : rules) {
+        const auto block = Block::tryGetFromRegistry(rule.blockName);
+        if (!block) {
+            continue;
+        }
+        const auto* type = &block->getLegacyBlock();
+        if (std::find(types.begin(), types.end(), type) == types.end()) {
+            types.push_back(type);
+        }
+    }
+}
+
+/**
+ * @brief Recover the growth stage of a block permutation for the trace palette
+ *
+ * Only runs the first time a capture sees a runtime ID.
+ */
+std::uint8_t growthStageOf(const Block& block) {
+    for (std::uint8_t stage = 0; stage <= RuleMatcher::MAX_GROWTH_STAGE; ++stage) {
+        const auto candidate = Block::tryGetFromRegistry(block.getTypeName(), stage);
+        if (candidate && candidate->getRuntimeId() == block.getRuntimeId()) {
+            return stage;
+        }
+    }
+    return UNKNOWN_GROWTH_STAGE;
+}
+
+} // namespace
+
 PotatoBoneMealBlocker& PotatoBoneMealBlocker::getInstance() {
     static PotatoBoneMealBlocker instance;
     return instance;
@@ -23,13 +167,25 @@ PotatoBoneMealBlocker& PotatoBoneMealBlocker::getInstance() {
 
 bool PotatoBoneMealBlocker::load() noexcept {
     try {
-        // Initialize language system for Chinese servers
+        mConfigPath = getSelf().getConfigDir() / CONFIG_FILE_NAME;
+        std::string error;
+        if (!loadConfig(mConfigPath, mConfig, error)) {
+            getSelf().getLogger().error("Invalid configuration {}: {}; using defaults", mConfigPath.string(), error);
+        }
+        mGrowthGovernor.setMode(mConfig.growthMode, mConfig.growthThrottleFactor);
+
+        // Chinese stays the default for Chinese servers if the configured locale is not installed
         auto& language = Language::getInstance();
-        language.setLanguage(Language::LanguageCode::CHINESE_SIMPLIFIED);
+        language.loadDirectory(getSelf().getLangDir());
+        const auto configured = language.findLanguage(mConfig.language);
+        if (!configured) {
+            getSelf().getLogger().warn("Language {} has no .lang file, using zh_CN", mConfig.language);
+        }
+        language.setLanguage(configured.value_or(Language::LanguageCode::CHINESE_SIMPLIFIED));
 
         getSelf().getLogger().info(language.getLoadingMessage());
         getSelf().getLogger().info(language.getCompatibilityMessage());
-        getSelf().getLogger().info(language.getMessage("optimization"));
+        getSelf().getLogger().info(language.getMessage(Language::MessageKey::OPTIMIZATION));
         return true;
     } catch (...) {
         // Fallback logging in case of logger issues
@@ -40,24 +196,118 @@ bool PotatoBoneMealBlocker::load() noexcept {
 bool PotatoBoneMealBlocker::enable() noexcept {
     try {
         getSelf().getLogger().info("Enabling Potato Bone Meal Blocker...");
+        mStartedMs = steadyMillis();
+
+        if (!applyConfig(mConfig)) {
+            getSelf().getLogger().error("No bone meal rule could be resolved, plugin stays inactive");
+            return false;
+        }
+
+        startLogSink();
+        startStats();
 
         auto& eventBus = ll::event::EventBus::getInstance();
 
-        // Use optimized lambda capture for better performance
-        mPlayerUseItemListener = eventBus.emplaceListener<ll::event::PlayerInteractBlockEvent>(
-            [this](ll::event::PlayerInteractBlockEvent& event) noexcept {
-                onPlayerInteractBlock(event);
+        // Interactions are only dispatched to the plugin while someone holds a covered item
+        mFaultBreaker.reset();
+        mInteractSubscriptions = 0;
+        const bool tracking    = mHeldItems.attach(
+            [this](std::int16_t itemId) {
+                // Items only the shadow candidate covers are held too, so it sees their interactions
+                const auto* rules = mSnapshot.load();
+                return rules && (rules->coversItem(itemId) || (rules->shadow && rules->shadow->coversItem(itemId)));
+            },
+            [this] { subscribeInteract(); }
+        );
+        if (!tracking) {
+            getSelf().getLogger().warn("Could not hook hotbar changes, the interaction listener stays registered");
+        }
+        if (!tracking && !subscribeInteract()) {
+            mLogSink.stop();
+            mStats.stop();
+            mSnapshot.reset();
+            return false;
+        }
+
+        // Feedback and exemption state of players who leave is evicted immediately
+        mPlayerDisconnectListener = eventBus.emplaceListener<ll::event::PlayerDisconnectEvent>(
+            [this](ll::event::PlayerDisconnectEvent& event) noexcept {
+                const auto playerId = event.self().getOrCreateUniqueID().id;
+                mFeedback.evict(playerId);
+                mBypass.evict(playerId);
+                mClickRate.evict(playerId);
+                mHeldItems.evict(playerId);
             }
         );
 
-        if (!mPlayerUseItemListener) {
-            getSelf().getLogger().error("Failed to register event listener");
-            return false;
+        // Exemptions are decided on join, so the event path only probes the cache
+        mPlayerJoinListener = eventBus.emplaceListener<ll::event::PlayerJoinEvent>(
+            [this](ll::event::PlayerJoinEvent& event) noexcept {
+                try {
+                    mBypass.refresh(event.self());
+                    mHeldItems.refresh(event.self());
+                } catch (...) {
+                    // Decided on the player's first interaction, or held items on the next refresh
+                }
+            }
+        );
+        refreshBypass();
+        refreshHeldItems();
+
+        // Player block changes drop cached fallback lookups and keep the growth governor's crop list current
+        mBlockPlacedListener = eventBus.emplaceListener<ll::event::PlayerPlacedBlockEvent>(
+            [this](ll::event::PlayerPlacedBlockEvent& event) noexcept {
+                auto&        player = event.self();
+                const Block* placed = nullptr;
+                try {
+                    if (mGrowthGovernor.isAttached()) {
+                        placed = &player.getDimension().getBlockSourceFromMainChunkSource().getBlock(event.pos());
+                    }
+                } catch (...) {
+                    // Untracked crops are registered on their first random tick
+                }
+                onBlockChanged(player.getDimensionId().id, event.pos(), placed);
+            }
+        );
+        mBlockDestroyedListener = eventBus.emplaceListener<ll::event::PlayerDestroyBlockEvent>(
+            [this](ll::event::PlayerDestroyBlockEvent& event) noexcept {
+                onBlockChanged(event.self().getDimensionId().id, event.pos(), nullptr);
+            }
+        );
+
+        // Dispensers and other non-player sources bypass the interaction event
+        if (!mGrowthPipeline.attach(mSnapshot)) {
+            getSelf().getLogger().warn("Could not hook crop fertilization, dispensers are not covered by the rules");
+        }
+
+        mTicker.addTask(FEEDBACK_FLUSH_INTERVAL_TICKS, [this] { sendFeedbackSummaries(); });
+        mTicker.addTask(TRACE_FLUSH_INTERVAL_TICKS, [this] { mTraceWriter.flush(); });
+        mTicker.addTask(CONFIG_POLL_INTERVAL_TICKS, [this] { pollConfig(); });
+        mTicker.addTask(BYPASS_REFRESH_INTERVAL_TICKS, [this] { refreshBypass(); });
+        mTicker.addTask(INTERACT_RELEASE_INTERVAL_TICKS, [this] { releaseInteract(); });
+        mTicker.addTask(HELD_ITEM_REFRESH_INTERVAL_TICKS, [this] { refreshHeldItems(); });
+        mTicker.addTask(1, [this] { mCensus.tick(); });
+        mTicker.addTask(GROWTH_FLUSH_INTERVAL_TICKS, [this] { flushGrowthBatches(); });
+        mTicker.addTask(HOST_SHARE_INTERVAL_TICKS, [this] { syncHostShare(); });
+        mTicker.addTask(1, [this] { advanceSchedule(); });
+        mTicker.start();
+
+        // Edits to the config file are parsed off-thread and applied by pollConfig()
+        mConfigWatcher.start(mConfigPath, CONFIG_WATCH_INTERVAL);
+
+        // Handler telemetry: /potatoblocker stats and a periodic Prometheus-style dump
+        registerCommands();
+        mMetricsExporter.start(getSelf().getDataDir() / "metrics.prom", METRICS_EXPORT_INTERVAL);
+
+        mEnabled = true;
+        openHostShare();
+        if (mGrowthGovernor.getMode() != GrowthGovernor::Mode::OFF) {
+            attachGrowthGovernor();
         }
 
         auto& language = Language::getInstance();
         getSelf().getLogger().info(language.getEnabledMessage());
-        getSelf().getLogger().info(language.getMessage("listener_registered"));
+        getSelf().getLogger().info(language.getMessage(Language::MessageKey::LISTENER_REGISTERED));
         return true;
 
     } catch (const std::exception& e) {
@@ -73,20 +323,75 @@ bool PotatoBoneMealBlocker::disable() noexcept {
     try {
         getSelf().getLogger().info("Disabling Potato Bone Meal Blocker...");
 
+        mHeldItems.detach();
         if (mPlayerUseItemListener) {
             ll::event::EventBus::getInstance().removeListener(mPlayerUseItemListener);
             mPlayerUseItemListener.reset();
             getSelf().getLogger().info("Event listener unregistered successfully");
         }
+        if (mPlayerDisconnectListener) {
+            ll::event::EventBus::getInstance().removeListener(mPlayerDisconnectListener);
+            mPlayerDisconnectListener.reset();
+        }
+        if (mPlayerJoinListener) {
+            ll::event::EventBus::getInstance().removeListener(mPlayerJoinListener);
+            mPlayerJoinListener.reset();
+        }
+        if (mBlockPlacedListener) {
+            ll::event::EventBus::getInstance().removeListener(mBlockPlacedListener);
+            mBlockPlacedListener.reset();
+        }
+        if (mBlockDestroyedListener) {
+            ll::event::EventBus::getInstance().removeListener(mBlockDestroyedListener);
+            mBlockDestroyedListener.reset();
+        }
+        mEnabled = false;
+        mConfigWatcher.stop();
+        detachGrowthGovernor();
+        mGrowthPipeline.detach();
+        mTicker.stop();
+        mTicker.clearTasks();
+        mCensus.cancel();
+        flushGrowthBatches();
+        syncHostShare();
+        mHostShare.close();
+        stopCapture();
+        mMetricsExporter.stop();
+
+        // The listener is gone and this is the server thread, so no reader can hold a snapshot
+        mSnapshot.reset();
+
+        const auto packetsSaved = mFeedback.getPacketsSaved();
+        if (packetsSaved > 0) {
+            getSelf().getLogger().info("Feedback packets saved by coalescing: {}", packetsSaved);
+        }
+        mFeedback.clear();
+        mBypass.clear();
+        mClickRate.clear();
+        mBlockCache.clear();
+
+        // Pending per-player and per-chunk counts are appended before the file is closed
+        mStats.stop();
+
+        // Flush queued log records before reporting statistics
+        mLogSink.stop();
+        const auto lostRecords = mLogSink.getDroppedCount() + mLogSink.getSampledOutCount();
+        if (lostRecords > 0) {
+            getSelf().getLogger().warn("Blocked-attempt log records lost to overflow: {}", lostRecords);
+        }
 
         // Log final statistics
         const auto blockedCount = getBlockedCount();
         if (blockedCount > 0) {
-            getSelf().getLogger().info("Total bone meal attempts blocked on potatoes: {}", blockedCount);
+            getSelf().getLogger().info(
+                "Total bone meal attempts blocked on potatoes: {} ({} including earlier sessions)",
+                blockedCount,
+                getLifetimeBlockedCount()
+            );
         }
 
         auto& language = Language::getInstance();
-        getSelf().getLogger().info(language.getMessage("disabled"));
+        getSelf().getLogger().info(language.getMessage(Language::MessageKey::DISABLED));
         return true;
 
     } catch (const std::exception& e) {
@@ -98,143 +403,1073 @@ bool PotatoBoneMealBlocker::disable() noexcept {
     }
 }
 
-void PotatoBoneMealBlocker::onPlayerInteractBlock(ll::event::PlayerInteractBlockEvent& event) noexcept {
+bool PotatoBoneMealBlocker::startCapture(const std::filesystem::path& path) noexcept {
+    try {
+        std::filesystem::create_directories(path.parent_path());
+        if (!mTraceWriter.start(path)) {
+            getSelf().getLogger().error("Could not start interaction capture to {}", path.string());
+            return false;
+        }
+        getSelf().getLogger().info("Capturing interactions to {}", path.string());
+
+        // Interactions with any item are recorded, so the listener stays registered until the capture ends
+        if (mEnabled) {
+            subscribeInteract();
+        }
+        return true;
+    } catch (const std::exception& e) {
+        getSelf().getLogger().error("Could not start interaction capture: {}", e.what());
+        return false;
+    }
+}
+
+void PotatoBoneMealBlocker::stopCapture() noexcept {
+    if (!mTraceWriter.isCapturing()) {
+        return;
+    }
+    mTraceWriter.stop();
     try {
-        const auto& itemStack = event.item();
+        getSelf().getLogger().info(
+            "Interaction capture stopped: {} records written, {} dropped",
+            mTraceWriter.getWrittenCount(),
+            mTraceWriter.getDroppedCount()
+        );
+    } catch (...) {
+        // Statistics are best effort
+    }
+}
 
-        // Critical performance optimization: Early return if not bone meal
-        // This check happens first to minimize processing for non-bone-meal items
-        if (!isBoneMeal(itemStack)) [[likely]] {
+bool PotatoBoneMealBlocker::setRules(std::vector<GrowthRule> rules) noexcept {
+    try {
+        auto config  = mConfig;
+        config.rules = std::move(rules);
+        if (!mEnabled) {
+            mConfig = std::move(config);
+            return true;
+        }
+        return applyConfig(std::move(config));
+    } catch (const std::exception& e) {
+        getSelf().getLogger().error("Could not apply rules: {}", e.what());
+        return false;
+    }
+}
+
+bool PotatoBoneMealBlocker::reloadConfig() noexcept {
+    try {
+        // Marked before reading, so an edit racing with this reload is picked up by the watcher
+        mConfigWatcher.markCurrent();
+
+        PluginConfig config;
+        std::string  error;
+        if (!loadConfig(mConfigPath, config, error)) {
+            getSelf().getLogger().error("Invalid configuration {}: {}", mConfigPath.string(), error);
+            return false;
+        }
+        if (!mEnabled) {
+            mConfig = std::move(config);
+            return true;
+        }
+        if (!applyConfig(std::move(config))) {
+            getSelf().getLogger().error("No rule in the configuration could be resolved, keeping the previous rules");
+            return false;
+        }
+        getSelf().getLogger().info("Configuration reloaded from {}", mConfigPath.string());
+        shareConfig();
+        return true;
+    } catch (const std::exception& e) {
+        getSelf().getLogger().error("Could not reload configuration: {}", e.what());
+        return false;
+    }
+}
+
+std::unique_ptr<const RuleSnapshot>
+PotatoBoneMealBlocker::compileSnapshot(const PluginConfig& config, const PolicySchedule::Policy* policy) const {
+    const auto& rules    = policy ? policy->rules : config.rules;
+    auto        snapshot = std::make_unique<RuleSnapshot>();
+    const auto  report   = snapshot->matcher.compile(rules, RegistryResolver{});
+
+    for (const auto& name : report.unresolved) {
+        getSelf().getLogger().warn("Unknown item or block in rule: {}", name);
+    }
+    getSelf().getLogger().info(
+        "Compiled {} of {} rules{}{} into {} block states",
+        report.compiledRules,
+        rules.size(),
+        policy ? " of schedule " : "",
+        policy ? std::string_view(policy->name) : std::string_view(),
+        report.blockStates
+    );
+    if (!config.regions.empty()) {
+        compileRegions(rules, config.regions, *snapshot);
+    }
+    // A schedule may deliberately allow everything while it is in force
+    if (snapshot->matcher.empty() && snapshot->itemFilter.empty() && !policy) {
+        return nullptr;
+    }
+
+    auto&      language = Language::getInstance();
+    const auto code     = language.findLanguage(config.language);
+    if (!code) {
+        getSelf().getLogger().warn("Language {} has no .lang file, keeping the current language", config.language);
+    }
+    snapshot->language           = code.value_or(language.getCurrentLanguage());
+    snapshot->showInfoMessage    = config.showInfoMessage;
+    snapshot->logBlockedAttempts = config.logBlockedAttempts;
+    snapshot->fertilizerItemId   = RegistryResolver{}.resolveItem(FERTILIZER_ITEM_NAME);
+    if (config.shadow.enabled) {
+        snapshot->shadow = compileCandidate(config);
+    }
+    return snapshot;
+}
+
+std::unique_ptr<const RuleSnapshot> PotatoBoneMealBlocker::compileCandidate(const PluginConfig& config) const {
+    // Only the matchers of a candidate are read; one without rules allows everything
+    auto       candidate = std::make_unique<RuleSnapshot>();
+    const auto report    = candidate->matcher.compile(config.shadowRules, RegistryResolver{});
+    for (const auto& name : report.unresolved) {
+        getSelf().getLogger().warn("Unknown item or block in shadow rule: {}", name);
+    }
+    if (!config.shadowRegions.empty()) {
+        compileRegions(config.shadowRules, config.shadowRegions, *candidate);
+    }
+    getSelf().getLogger().info(
+        "Shadow mode: compiled {} of {} candidate rules into {} block states, evaluated on 1 in {} interactions",
+        report.compiledRules,
+        config.shadowRules.size(),
+        report.blockStates,
+        config.shadow.sampleInterval
+    );
+    return candidate;
+}
+
+void PotatoBoneMealBlocker::compileRegions(
+    const std::vector<GrowthRule>&   globalRules,
+    const std::vector<RegionConfig>& regionConfigs,
+    RuleSnapshot&                    snapshot
+) const {
+    // Regions with equal rule lists share one compiled matcher
+    std::vector<const std::vector<GrowthRule>*> ruleSets;
+    std::vector<RegionIndex::Region>            regions;
+    regions.reserve(regionConfigs.size());
+    for (const auto& region : regionConfigs) {
+        auto set = std::find_if(ruleSets.begin(), ruleSets.end(), [&](const auto* rules) {
+            return *rules == region.rules;
+        });
+        if (set == ruleSets.end()) {
+            ruleSets.push_back(&region.rules);
+            set = ruleSets.end() - 1;
+        }
+        regions.push_back(
+            RegionIndex::Region{region.box, region.priority, static_cast<std::uint32_t>(set - ruleSets.begin())}
+        );
+    }
+
+    const RegistryResolver  resolver{};
+    std::vector<GrowthRule> allRules = globalRules;
+    snapshot.regionRules.resize(ruleSets.size());
+    for (std::size_t i = 0; i < ruleSets.size(); ++i) {
+        const auto report = snapshot.regionRules[i].compile(*ruleSets[i], resolver);
+        for (const auto& name : report.unresolved) {
+            getSelf().getLogger().warn("Unknown item or block in region rule: {}", name);
+        }
+        allRules.insert(allRules.end(), ruleSets[i]->begin(), ruleSets[i]->end());
+    }
+    snapshot.itemFilter.compile(allRules, resolver);
+    snapshot.regions.build(regions);
+
+    getSelf().getLogger().info(
+        "Indexed {} regions with {} distinct rule lists over {} chunks",
+        snapshot.regions.size(),
+        ruleSets.size(),
+        snapshot.regions.getChunkCount()
+    );
+}
+
+bool PotatoBoneMealBlocker::applyConfig(PluginConfig config) {
+    const auto clock    = getScheduleClock();
+    const auto active   = PolicySchedule::findActive(config.schedules, clock);
+    auto       snapshot = compileSnapshot(
+        config,
+        active == PolicySchedule::NONE ? nullptr : &config.schedules[static_cast<std::size_t>(active)]
+    );
+    if (!snapshot) {
+        return false;
+    }
+    mSchedule.configure(config.schedules, clock);
+
+    Language::getInstance().setLanguage(snapshot->language);
+    mFeedbackPackets.build(Language::getInstance());
+    mFeedback.configure(config.feedback);
+    mClickRate.configure(config.clickRate);
+    mFaultBreaker.configure(config.faultBreaker);
+    mBlockCache.setVolatileTypes(resolveVolatileTypes(config));
+    mShadow.configure(config.shadow);
+    if (config.shadowRules != mConfig.shadowRules || config.shadowRegions != mConfig.shadowRegions) {
+        // Samples of the previous candidate say nothing about this one
+        mShadow.reset();
+    }
+    if (config.bypass != mBypass.getSettings()) {
+        mBypass.configure(config.bypass);
+        refreshBypass();
+    }
+
+    const bool hostChanged   = config.hostShare != mConfig.hostShare;
+    const bool statsChanged  = config.stats != mConfig.stats;
+    const bool sinkChanged   = config.logSink != mConfig.logSink;
+    const bool rulesChanged  = config.rules != mConfig.rules;
+    const bool growthChanged = config.growthMode != mConfig.growthMode
+                            || config.growthThrottleFactor != mConfig.growthThrottleFactor;
+    mConfig = std::move(config);
+
+    // Handlers see the new rules from their next event; the old snapshot is freed after this tick
+    mSnapshot.publish(std::move(snapshot), mTicker.getCurrentTick());
+
+    // The covered items may have changed, and with them who counts as holding one
+    refreshHeldItems();
+
+    if (rulesChanged && mGrowthGovernor.isAttached()) {
+        if (auto types = resolveGovernedTypes(); !types.empty()) {
+            mGrowthGovernor.setGovernedTypes(std::move(types));
+        }
+    }
+    if (growthChanged) {
+        setGrowthMode(mConfig.growthMode, mConfig.growthThrottleFactor);
+    }
+    if (hostChanged && mEnabled) {
+        openHostShare();
+    }
+    if (statsChanged && mStats.isRunning()) {
+        // Pending counts are flushed under the old settings before the flusher restarts
+        mStats.stop();
+        startStats();
+    }
+    if (sinkChanged && mEnabled) {
+        // Queued records are written before the ring is rebuilt with the new size
+        mLogSink.stop();
+        startLogSink();
+    }
+    return true;
+}
+
+PolicySchedule::Clock PotatoBoneMealBlocker::getScheduleClock() const noexcept {
+    const auto            now = steadyMillis();
+    PolicySchedule::Clock clock;
+    clock.monotonicSeconds = now / 1000;
+    clock.uptimeSeconds    = (now - mStartedMs) / 1000;
+    clock.weekSeconds      = localWeekSeconds();
+    return clock;
+}
+
+void PotatoBoneMealBlocker::advanceSchedule() noexcept {
+    // The wheel counts seconds, so the clocks are read once per second rather than per tick
+    const auto second = steadyMillis() / 1000;
+    if (second == mScheduleSecond) [[likely]] {
+        return;
+    }
+    mScheduleSecond = second;
+    try {
+        const auto* previous     = mSchedule.getActive();
+        const auto  previousName = previous ? previous->name : std::string();
+        if (!mSchedule.advance(getScheduleClock())) [[likely]] {
             return;
         }
 
-        auto& player = event.self();
+        const auto* policy   = mSchedule.getActive();
+        auto        snapshot = compileSnapshot(mConfig, policy);
+        if (!snapshot) {
+            getSelf().getLogger().error("No rule resolved after schedule {} ended, keeping its rules", previousName);
+            return;
+        }
+        mSnapshot.publish(std::move(snapshot), mTicker.getCurrentTick());
+        refreshHeldItems();
+        if (policy) {
+            getSelf().getLogger().info("Schedule {} is in force", policy->name);
+        } else {
+            getSelf().getLogger().info("Schedule {} ended, the configured rules are in force", previousName);
+        }
+    } catch (const std::exception& e) {
+        getSelf().getLogger().error("Could not switch scheduled rules: {}", e.what());
+    }
+}
 
-        // Get block position and block directly from the event
-        try {
-            const auto& blockPos = event.blockPos();
+void PotatoBoneMealBlocker::startLogSink() noexcept {
+    try {
+        // Blocked attempts are formatted and written by the sink thread
+        mLogSink.configure(mConfig.logSink);
+        mLogSink.start([this](std::string_view line) { getSelf().getLogger().info(line); });
+    } catch (const std::exception& e) {
+        getSelf().getLogger().warn("Blocked attempts are not logged: {}", e.what());
+    }
+}
 
-            // Check if we have a valid block reference
-            auto blockRef = event.block();
-            if (!blockRef.has_value()) [[unlikely]] {
-                // Fallback: get block from dimension if direct reference not available
-                auto& dimension = player.getDimension();
-                auto& blockSource = dimension.getBlockSourceFromMainChunkSource();
-                const auto& block = blockSource.getBlock(blockPos);
+void PotatoBoneMealBlocker::startStats() noexcept {
+    try {
+        const auto dataDir = getSelf().getDataDir();
+        std::filesystem::create_directories(dataDir);
+        if (!mStats.start(dataDir / STATS_FILE_NAME, mConfig.stats)) {
+            getSelf().getLogger().warn("Blocked-attempt statistics are not persisted: {}", mStats.getError());
+            return;
+        }
+        getSelf().getLogger().info(
+            "Blocked-attempt statistics in {}: {} attempts from earlier sessions",
+            mStats.getPath().string(),
+            mStats.getPersistedCount()
+        );
+    } catch (const std::exception& e) {
+        getSelf().getLogger().warn("Blocked-attempt statistics are not persisted: {}", e.what());
+    }
+}
 
-                // Check if this is a potato crop that should be blocked
-                if (isPotatoCrop(block)) [[unlikely]] {
-                    // Cancel the event to prevent bone meal usage
-                    event.cancel();
+void PotatoBoneMealBlocker::pollConfig() noexcept {
+    try {
+        // Snapshots retired in an earlier tick can no longer be in use
+        mSnapshot.reclaim(mTicker.getCurrentTick());
 
-                    // Send optimized feedback messages
-                    sendBlockedMessage(player);
+        auto update = mConfigWatcher.takeUpdate();
+        if (!update) [[likely]] {
+            return;
+        }
+        if (!update->config) {
+            getSelf().getLogger().warn("Ignoring invalid configuration {}: {}", mConfigPath.string(), update->error);
+            return;
+        }
+        if (!applyConfig(std::move(*update->config))) {
+            getSelf().getLogger().error("No rule in the changed configuration resolved, keeping the old rules");
+            return;
+        }
+        getSelf().getLogger().info("Configuration reloaded from {}", mConfigPath.string());
+        shareConfig();
+    } catch (const std::exception& e) {
+        getSelf().getLogger().error("Could not apply changed configuration: {}", e.what());
+    } catch (...) {
+        // Keep the running configuration
+    }
+}
 
-                    // Log the blocked attempt with optimized formatting
-                    logBlockedAttempt(player.getRealName(), blockPos);
+void PotatoBoneMealBlocker::openHostShare() noexcept {
+    mHostShare.close();
+    mHostConfigGeneration = 0;
+    if (!mConfig.hostShare.enabled) {
+        return;
+    }
+    try {
+        const auto& name = mConfig.hostShare.name;
+        std::string error;
+        if (!mHostShare.open(name, epochMillis(), error)) {
+            getSelf().getLogger().warn("Could not open host share {}: {}; keeping local configuration", name, error);
+            return;
+        }
 
-                    // Increment atomic counter for statistics
-                    mBlockedCount.fetch_add(1, std::memory_order_relaxed);
-                }
-            } else {
-                // Use the direct block reference for better performance
-                const auto& block = blockRef.value();
+        // Only attempts blocked from now on are added to the host totals
+        mHostPublishedBlocked    = getBlockedCount();
+        mHostPublishedFertilizer = mGrowthPipeline.getBlockedCount();
+        if (mHostShare.getConfigGeneration() == 0) {
+            getSelf().getLogger().info("Created host share {} with this instance's configuration", name);
+            shareConfig();
+            return;
+        }
+        getSelf().getLogger().info("Joined host share {}", name);
+        syncHostShare();
+    } catch (const std::exception& e) {
+        getSelf().getLogger().error("Could not open host share: {}", e.what());
+    }
+}
 
-                // Check if this is a potato crop that should be blocked
-                if (isPotatoCrop(block)) [[unlikely]] {
-                    // Cancel the event to prevent bone meal usage
-                    event.cancel();
+void PotatoBoneMealBlocker::shareConfig() noexcept {
+    if (!mHostShare.isOpen()) [[likely]] {
+        return;
+    }
+    try {
+        const auto text       = renderConfig(mConfig);
+        const auto generation = mHostShare.publishConfig(text);
+        if (generation == 0) {
+            getSelf().getLogger().warn(
+                "Configuration of {} bytes exceeds the host share limit, other instances keep theirs",
+                text.size()
+            );
+            return;
+        }
+        mHostConfigGeneration = generation;
+    } catch (const std::exception& e) {
+        getSelf().getLogger().error("Could not share configuration: {}", e.what());
+    }
+}
 
-                    // Send optimized feedback messages
-                    sendBlockedMessage(player);
+void PotatoBoneMealBlocker::syncHostShare() noexcept {
+    if (!mHostShare.isOpen()) [[likely]] {
+        return;
+    }
+    try {
+        const auto blocked    = getBlockedCount();
+        const auto fertilizer = mGrowthPipeline.getBlockedCount();
+        mHostShare.publish(blocked - mHostPublishedBlocked, fertilizer - mHostPublishedFertilizer, epochMillis());
+        mHostPublishedBlocked    = blocked;
+        mHostPublishedFertilizer = fertilizer;
 
-                    // Log the blocked attempt with optimized formatting
-                    logBlockedAttempt(player.getRealName(), blockPos);
+        // Another instance published a configuration since this one last looked
+        if (mHostShare.getConfigGeneration() == mHostConfigGeneration) [[likely]] {
+            return;
+        }
+        std::string text;
+        const auto  generation = mHostShare.readConfig(text);
+        if (generation == 0) {
+            return; // A writer holds the lock; retried on the next sync
+        }
+        mHostConfigGeneration = generation;
+
+        auto        config = mConfig;
+        std::string error;
+        if (!parseConfig(text, config, error)) {
+            getSelf().getLogger().warn("Ignoring shared configuration generation {}: {}", generation, error);
+            return;
+        }
+        // Whether and where to share stays a decision of the local file
+        config.hostShare = mConfig.hostShare;
+        if (!applyConfig(std::move(config))) {
+            getSelf().getLogger().error("No rule in shared configuration generation {} resolved", generation);
+            return;
+        }
+        getSelf().getLogger().info(
+            "Applied configuration generation {} from host share {}",
+            generation,
+            mHostShare.getName()
+        );
+    } catch (const std::exception& e) {
+        getSelf().getLogger().error("Could not synchronize with the host share: {}", e.what());
+    } catch (...) {
+        // Retried on the next sync
+    }
+}
+
+bool PotatoBoneMealBlocker::setGrowthMode(GrowthGovernor::Mode mode, std::uint32_t throttleFactor) noexcept {
+    mGrowthGovernor.setMode(mode, throttleFactor);
+    if (mode == GrowthGovernor::Mode::OFF) {
+        detachGrowthGovernor();
+        return true;
+    }
+    // The hook is installed by enable() if the plugin is not running yet
+    return !mEnabled || mGrowthGovernor.isAttached() || attachGrowthGovernor();
+}
+
+std::vector<const BlockLegacy*> PotatoBoneMealBlocker::resolveGovernedTypes() const {
+    // Every crop named by a rule is governed, whatever the rule's item
+    std::vector<const BlockLegacy*> types;
+    appendRuleTypes(mConfig.rules, types);
+    return types;
+}
+
+std::vector<const BlockLegacy*> PotatoBoneMealBlocker::resolveVolatileTypes(const PluginConfig& config) {
+    // A crop's growth stage, and with it whether a rule matches, changes on random ticks no event reports
+    std::vector<const BlockLegacy*> types;
+    appendRuleTypes(config.rules, types);
+    appendRuleTypes(config.shadowRules, types);
+    for (const auto& policy : config.schedules) {
+        appendRuleTypes(policy.rules, types);
+    }
+    for (const auto& region : config.regions) {
+        appendRuleTypes(region.rules, types);
+    }
+    for (const auto& region : config.shadowRegions) {
+        appendRuleTypes(region.rules, types);
+    }
+    return types;
+}
+
+void PotatoBoneMealBlocker::onBlockChanged(int dimension, const BlockPos& pos, const Block* placed) noexcept {
+    mBlockCache.invalidate(dimension, pos.x, pos.y, pos.z);
+    if (!mGrowthGovernor.isAttached()) {
+        return;
+    }
+    if (!placed) {
+        mGrowthGovernor.onRemoved(dimension, pos.x, pos.y, pos.z);
+        return;
+    }
+    try {
+        mGrowthGovernor.onPlaced(dimension, pos.x, pos.y, pos.z, placed->getLegacyBlock());
+    } catch (...) {
+        // Untracked crops are registered on their first random tick
+    }
+}
+
+std::size_t PotatoBoneMealBlocker::startCensus(CropCensus::Callback done) noexcept {
+    try {
+        auto level = ll::service::getLevel();
+        if (!mEnabled || mCensus.isRunning() || !level) {
+            return 0;
+        }
+
+        // Crop permutations of every block a rule names, at every growth stage the registry knows
+        std::vector<CropCensus::Target> targets;
+        for (const auto& rule : mConfig.rules) {
+            for (std::uint8_t stage = 0; stage <= RuleMatcher::MAX_GROWTH_STAGE; ++stage) {
+                const auto block = Block::tryGetFromRegistry(rule.blockName, stage);
+                if (!block) {
+                    continue;
+                }
+                const auto runtimeId = block->getRuntimeId();
+                if (std::none_of(targets.begin(), targets.end(), [&](const auto& target) {
+                        return target.runtimeId == runtimeId;
+                    })) {
+                    targets.push_back({runtimeId, stage});
+                }
+            }
+        }
+        if (targets.empty()) {
+            return 0;
+        }
 
-                    // Increment atomic counter for statistics
-                    mBlockedCount.fetch_add(1, std::memory_order_relaxed);
+        // LeviLamina has no loaded-chunk enumeration; chunks around players are loaded by their presence
+        std::vector<CropCensus::Column> columns;
+        FlatIdMap<bool>                 seen;
+        level->forEachPlayer([&](Player& player) {
+            auto&      dimension = player.getDimension();
+            const auto feet      = player.getFeetBlockPos();
+            const int  centerX   = feet.x >> 4;
+            const int  centerZ   = feet.z >> 4;
+            for (int chunkX = centerX - CENSUS_RADIUS_CHUNKS; chunkX <= centerX + CENSUS_RADIUS_CHUNKS; ++chunkX) {
+                for (int chunkZ = centerZ - CENSUS_RADIUS_CHUNKS; chunkZ <= centerZ + CENSUS_RADIUS_CHUNKS; ++chunkZ) {
+                    // Players close to each other share most of their chunks
+                    if (std::exchange(seen[packChunkKey(dimension.getDimensionId().id, chunkX, chunkZ)], true)) {
+                        continue;
+                    }
+                    columns.push_back(
+                        {&dimension.getBlockSourceFromMainChunkSource(),
+                         dimension.getDimensionId().id,
+                         chunkX,
+                         chunkZ,
+                         dimension.getMinHeight(),
+                         dimension.getHeight()}
+                    );
                 }
             }
+            return true;
+        });
 
-        } catch (const std::exception& blockException) {
-            // Log block position errors at debug level to avoid spam
-            getSelf().getLogger().debug("Could not process block interaction: {}", blockException.what());
+        const auto chunks = columns.size();
+        if (chunks == 0 || !mCensus.start(std::move(columns), std::move(targets), {}, std::move(done))) {
+            return 0;
         }
+        return chunks;
+    } catch (const std::exception& e) {
+        getSelf().getLogger().warn("Could not start the crop census: {}", e.what());
+        return 0;
+    }
+}
 
+bool PotatoBoneMealBlocker::attachGrowthGovernor() {
+    try {
+        auto types = resolveGovernedTypes();
+        if (types.empty()) {
+            getSelf().getLogger().warn("No crop in the rules could be resolved, growth stays ungoverned");
+            return false;
+        }
+        mGrowthGovernor.setGovernedTypes(std::move(types));
+
+        if (!mGrowthGovernor.attach()) {
+            getSelf().getLogger().error("Failed to hook crop random ticks");
+            detachGrowthGovernor();
+            return false;
+        }
+        getSelf().getLogger().info(
+            "Crop growth governor active: {}",
+            GrowthGovernor::modeName(mGrowthGovernor.getMode())
+        );
+        return true;
     } catch (const std::exception& e) {
-        getSelf().getLogger().error("Error in onPlayerInteractBlock: {}", e.what());
+        getSelf().getLogger().error("Failed to start crop growth governor: {}", e.what());
+        detachGrowthGovernor();
+        return false;
+    }
+}
+
+void PotatoBoneMealBlocker::detachGrowthGovernor() noexcept {
+    mGrowthGovernor.detach();
+    mGrowthGovernor.clear();
+}
+
+void PotatoBoneMealBlocker::onPlayerInteractBlock(ll::event::PlayerInteractBlockEvent& event) noexcept {
+    PBB_METRIC_SCOPE(HANDLER);
+    PBB_METRIC_COUNT(EVENTS);
+
+    // Tripped: events pass through unevaluated until releaseInteract() removes the listener
+    if (mFaultBreaker.isOpen()) [[unlikely]] {
+        return;
+    }
+
+    // Shadow mode times one interaction per sample interval and judges it with the candidate rules afterwards
+    const bool         sampled      = mShadow.isEnabled() && mShadow.shouldSample();
+    const std::int64_t handlerStart = sampled ? steadyNanos() : 0;
+
+    // The only exception boundary of the event path; the steps below report faults as return values
+    try {
+        if (const auto handled = handleInteraction(event); !handled) [[unlikely]] {
+            recordFault(handled.error(), {});
+        }
+    } catch (const std::bad_alloc&) {
+        recordFault(HandlerFault::OUT_OF_MEMORY, {});
+    } catch (const std::exception& e) {
+        recordFault(HandlerFault::EXCEPTION, e.what());
     } catch (...) {
-        // Catch-all to prevent any crashes
-        getSelf().getLogger().error("Unknown error in onPlayerInteractBlock");
+        recordFault(HandlerFault::EXCEPTION, "unknown exception");
+    }
+    if (sampled) [[unlikely]] {
+        evaluateShadow(event, steadyNanos() - handlerStart);
+    }
+}
+
+HandlerResult PotatoBoneMealBlocker::handleInteraction(ll::event::PlayerInteractBlockEvent& event) {
+    // One acquire load, no lock; the snapshot stays valid until this event is handled
+    const auto* rules = mSnapshot.load();
+    if (!rules) [[unlikely]] {
+        return {};
+    }
+    const auto& itemStack = event.item();
+
+    // Critical performance optimization: Early return if not bone meal
+    // This check happens first to minimize processing for non-bone-meal items
+    if (!isBoneMeal(*rules, itemStack)) [[likely]] {
+        PBB_METRIC_COUNT(NOT_BONE_MEAL);
+        if (mTraceWriter.isCapturing()) [[unlikely]] {
+            captureInteraction(event, event.block().as_ptr(), TraceDecision::IGNORED);
+        }
+        return {};
+    }
+
+    auto& player = event.self();
+
+    // Flagged auto-clickers are cancelled outright: no block lookup, feedback, log line or statistics
+    if (mClickRate.hasFlagged()) [[unlikely]] {
+        if (mClickRate.isFlagged(player.getOrCreateUniqueID().id, steadyMillis())) {
+            event.cancel();
+            PBB_METRIC_COUNT(CLICK_RATE_DROPPED);
+            if (mTraceWriter.isCapturing()) [[unlikely]] {
+                captureInteraction(event, event.block().as_ptr(), TraceDecision::BLOCKED);
+            }
+            return {};
+        }
+    }
+
+    // Exempt staff skip the rules; one cache probe per bone meal interaction
+    if (isExempt(player)) [[unlikely]] {
+        if (mTraceWriter.isCapturing()) [[unlikely]] {
+            captureInteraction(event, event.block().as_ptr(), TraceDecision::ALLOWED);
+        }
+        return {};
+    }
+
+    const auto& blockPos = event.blockPos();
+    const auto  block    = resolveBlock(event, player);
+    if (!block) [[unlikely]] {
+        return unexpected(block.error());
     }
+
+    // The same decision dispensers and other fertilizer sources go through
+    GrowthAttempt attempt;
+    attempt.source    = GrowthSource::PLAYER;
+    attempt.itemId    = itemStack.getId();
+    attempt.runtimeId = (*block)->getRuntimeId();
+    attempt.dimension = player.getDimensionId().id;
+    attempt.x         = blockPos.x;
+    attempt.y         = blockPos.y;
+    attempt.z         = blockPos.z;
+
+    const bool    blocked = GrowthPipeline::isBlocked(*rules, attempt);
+    HandlerResult result;
+    if (blocked) [[unlikely]] {
+        // Cancel the event to prevent bone meal usage
+        event.cancel();
+        PBB_METRIC_COUNT(BLOCKED);
+        result = onPlayerBlocked(*rules, player, attempt);
+    }
+    if (mTraceWriter.isCapturing()) [[unlikely]] {
+        captureInteraction(event, *block, blocked ? TraceDecision::BLOCKED : TraceDecision::ALLOWED);
+    }
+    return result;
 }
 
-bool PotatoBoneMealBlocker::isPotatoCrop(const Block& block) const noexcept {
+Expected<const Block*, HandlerFault>
+PotatoBoneMealBlocker::resolveBlock(ll::event::PlayerInteractBlockEvent& event, Player& player) noexcept {
+    if (const auto blockRef = event.block(); blockRef.has_value()) [[likely]] {
+        PBB_METRIC_COUNT(DIRECT_BLOCK);
+        return blockRef.as_ptr();
+    }
+
+    // Fallback: get block from dimension if direct reference not available
+    PBB_METRIC_COUNT(FALLBACK_BLOCK);
+    PBB_METRIC_SCOPE(BLOCK_FALLBACK);
     try {
-        // Use string_view for efficient comparison without allocations
-        const auto blockName = block.getTypeName();
-        const std::string_view blockNameView{blockName};
+        // Clients clicking the same block again are served without the chunk source
+        const auto& pos         = event.blockPos();
+        const auto  dimensionId = player.getDimensionId().id;
+        const auto  tick        = mTicker.getCurrentTick();
+        if (const auto* cached = mBlockCache.find(dimensionId, pos.x, pos.y, pos.z, tick)) {
+            PBB_METRIC_COUNT(BLOCK_CACHE_HIT);
+            return cached;
+        }
 
-        // Direct comparison with compile-time constant
-        return blockNameView == POTATO_BLOCK_NAME;
+        PBB_METRIC_SCOPE(BLOCK_SOURCE);
+        auto&       dimension   = player.getDimension();
+        auto&       blockSource = dimension.getBlockSourceFromMainChunkSource();
+        const auto& block       = blockSource.getBlock(pos);
+        mBlockCache.insert(dimensionId, pos.x, pos.y, pos.z, block, tick);
+        return &block;
+    } catch (...) {
+        // Rarely taken and the first thing an incompatible game update breaks
+        PBB_METRIC_COUNT(BLOCK_EXCEPTION);
+        return unexpected(HandlerFault::BLOCK_LOOKUP);
+    }
+}
 
-    } catch (const std::exception& e) {
-        getSelf().getLogger().debug("Error checking block type: {}", e.what());
-        return false;
+void PotatoBoneMealBlocker::evaluateShadow(ll::event::PlayerInteractBlockEvent& event, std::int64_t handlerNs) noexcept {
+    const auto  start = steadyNanos();
+    const auto* rules = mSnapshot.load();
+    if (!rules || !rules->shadow) [[unlikely]] {
+        return;
+    }
+
+    // Only the event's own block is judged; a fallback lookup would cost more than the sample is worth
+    const auto block = event.block();
+    if (!block.has_value()) {
+        mShadow.skip(handlerNs, steadyNanos() - start);
+        return;
+    }
+    const auto&   blockPos = event.blockPos();
+    GrowthAttempt attempt;
+    attempt.source    = GrowthSource::PLAYER;
+    attempt.itemId    = event.item().getId();
+    attempt.runtimeId = block->getRuntimeId();
+    attempt.dimension = event.self().getDimensionId().id;
+    attempt.x         = blockPos.x;
+    attempt.y         = blockPos.y;
+    attempt.z         = blockPos.z;
+
+    // Rule decisions only: exemptions and auto-clicker drops are not part of a rule set
+    ShadowEvaluator::Sample sample;
+    sample.live               = GrowthPipeline::isBlocked(*rules, attempt);
+    const auto candidateStart = steadyNanos();
+    sample.candidate          = GrowthPipeline::isBlocked(*rules->shadow, attempt);
+    const auto end            = steadyNanos();
+    sample.timeMs             = end / 1'000'000;
+    sample.costNs             = static_cast<std::uint32_t>(std::min<std::int64_t>(end - candidateStart, UINT32_MAX));
+    sample.runtimeId          = attempt.runtimeId;
+    sample.itemId             = attempt.itemId;
+    sample.dimension          = attempt.dimension;
+    sample.x                  = attempt.x;
+    sample.y                  = attempt.y;
+    sample.z                  = attempt.z;
+    mShadow.record(sample, handlerNs, end - start);
+}
+
+void PotatoBoneMealBlocker::recordFault(HandlerFault fault, std::string_view detail) noexcept {
+    if (fault == HandlerFault::OUT_OF_MEMORY || fault == HandlerFault::EXCEPTION) {
+        PBB_METRIC_COUNT(HANDLER_EXCEPTION);
+    }
+    const bool first   = mFaultBreaker.getCount(fault) == 0;
+    const bool tripped = mFaultBreaker.record(fault, steadyMillis());
+
+    // First fault of each kind is logged; repeats only count until the breaker trips
+    if (first) {
+        try {
+            getSelf().getLogger().warn(
+                "Bone meal handler fault {}: {}",
+                FaultBreaker::faultName(fault),
+                detail.empty() ? std::string_view("no details") : detail
+            );
+        } catch (...) {}
+    }
+    if (tripped) {
+        tripFaultBreaker();
+    }
+}
+
+void PotatoBoneMealBlocker::tripFaultBreaker() noexcept {
+    try {
+        const auto& settings = mFaultBreaker.getSettings();
+        std::string text;
+        appendFormatted(
+            text,
+            "Bone meal blocking disabled after {} handler faults within {} ms (",
+            {settings.budget, settings.window.count()}
+        );
+        for (std::size_t kind = 0; kind < FaultBreaker::FAULT_KINDS; ++kind) {
+            const auto fault = static_cast<HandlerFault>(kind);
+            appendFormatted(
+                text,
+                kind == 0 ? "{} {}" : ", {} {}",
+                {FaultBreaker::faultName(fault), mFaultBreaker.getCount(fault)}
+            );
+        }
+        text += "); run /potatoblocker breaker reset once the cause is fixed";
+        getSelf().getLogger().error(text);
+        if (auto level = ll::service::getLevel()) {
+            level->forEachPlayer([&](Player& player) {
+                if (player.getCommandPermissionLevel() >= CommandPermissionLevel::GameDirectors) {
+                    player.sendMessage(text);
+                }
+                return true;
+            });
+        }
     } catch (...) {
-        // Catch-all for safety
+        // The breaker is open regardless; the alert is best effort
+    }
+}
+
+bool PotatoBoneMealBlocker::resetFaultBreaker() noexcept {
+    if (!mFaultBreaker.isOpen()) {
         return false;
     }
+    mFaultBreaker.reset();
+    getSelf().getLogger().info("Fault breaker reset, bone meal interactions are evaluated again");
+
+    // Registered for now; releaseInteract() drops it again if nobody holds a covered item
+    if (mEnabled) {
+        subscribeInteract();
+    }
+    return true;
 }
 
-bool PotatoBoneMealBlocker::isBoneMeal(const ItemStack& item) const noexcept {
-    try {
-        // Use string_view for efficient comparison without allocations
-        const auto itemName = item.getTypeName();
-        const std::string_view itemNameView{itemName};
+bool PotatoBoneMealBlocker::isExempt(Player& player) {
+    if (const auto* exempt = mBypass.find(player.getOrCreateUniqueID().id)) [[likely]] {
+        PBB_METRIC_COUNT(BYPASS_HIT);
+        return *exempt;
+    }
+    // Joined before the plugin was enabled, or the join-time evaluation failed
+    PBB_METRIC_COUNT(BYPASS_MISS);
+    return mBypass.refresh(player);
+}
 
-        // Direct comparison with compile-time constant
-        return itemNameView == BONE_MEAL_ITEM_NAME;
+void PotatoBoneMealBlocker::refreshBypass() noexcept {
+    try {
+        auto level = ll::service::getLevel();
+        if (!level) {
+            return;
+        }
+        level->forEachPlayer([this](Player& player) {
+            mBypass.refresh(player);
+            return true;
+        });
+    } catch (...) {
+        // Stale decisions are corrected by the next refresh
+    }
+}
 
-    } catch (const std::exception& e) {
-        getSelf().getLogger().debug("Error checking item type: {}", e.what());
+bool PotatoBoneMealBlocker::subscribeInteract() noexcept {
+    if (mPlayerUseItemListener) {
+        return true;
+    }
+    if (mFaultBreaker.isOpen()) {
         return false;
+    }
+    try {
+        auto& eventBus         = ll::event::EventBus::getInstance();
+        mPlayerUseItemListener = eventBus.emplaceListener<ll::event::PlayerInteractBlockEvent>(
+            [this](ll::event::PlayerInteractBlockEvent& event) noexcept { onPlayerInteractBlock(event); }
+        );
     } catch (...) {
-        // Catch-all for safety
+        mPlayerUseItemListener.reset();
+    }
+    if (!mPlayerUseItemListener) {
+        getSelf().getLogger().error("Failed to register event listener");
         return false;
     }
+    ++mInteractSubscriptions;
+    return true;
 }
 
-void PotatoBoneMealBlocker::sendBlockedMessage(Player& player) const noexcept {
+void PotatoBoneMealBlocker::releaseInteract() noexcept {
+    // Removed from a ticker task, never from inside an event that may be dispatching the listener
+    if (!mPlayerUseItemListener) {
+        return;
+    }
+    if (!mFaultBreaker.isOpen()
+        && (!mHeldItems.isAttached() || mHeldItems.getHolderCount() > 0 || mTraceWriter.isCapturing())) {
+        return;
+    }
+    ll::event::EventBus::getInstance().removeListener(mPlayerUseItemListener);
+    mPlayerUseItemListener.reset();
+}
+
+void PotatoBoneMealBlocker::refreshHeldItems() noexcept {
+    if (!mHeldItems.isAttached()) {
+        return;
+    }
+    try {
+        auto level = ll::service::getLevel();
+        if (!level) {
+            return;
+        }
+        level->forEachPlayer([this](Player& player) {
+            mHeldItems.refresh(player);
+            return true;
+        });
+    } catch (...) {
+        // Corrected by the next refresh
+    }
+}
+
+HandlerResult
+PotatoBoneMealBlocker::onPlayerBlocked(const RuleSnapshot& rules, Player& player, const GrowthAttempt& attempt) {
+    // Send optimized feedback messages; a failure is reported after the remaining side effects
+    const auto feedback = sendBlockedMessage(rules, player);
+    recordAttemptRate(player);
+
+    // Queue the blocked attempt for the asynchronous log sink
+    if (rules.logBlockedAttempts) {
+        logBlockedAttempt(player, BlockPos{attempt.x, attempt.y, attempt.z});
+    }
+
+    // Increment atomic counter for statistics
+    mBlockedCount.fetch_add(1, std::memory_order_relaxed);
+    mStats.record(player.getOrCreateUniqueID().id, attempt.dimension, attempt.x, attempt.z, epochMillis());
+    return feedback;
+}
+
+void PotatoBoneMealBlocker::flushGrowthBatches() noexcept {
+    try {
+        const auto* rules   = mSnapshot.load();
+        const bool  log     = !rules || rules->logBlockedAttempts;
+        const auto  epochMs = epochMillis();
+        const auto  blocked = mGrowthPipeline.flush([&](const GrowthPipeline::Batch& batch) {
+            mStats.recordChunk(batch.dimension, batch.chunkX, batch.chunkZ, batch.count, epochMs);
+            if (log) {
+                // Formatted and written by the sink thread, like player attempts
+                BlockedAttemptRecord record;
+                record.kind        = BlockedAttemptRecord::Kind::GROWTH_BATCH;
+                record.timestampMs = epochMs;
+                record.x           = batch.chunkX;
+                record.y           = static_cast<std::int32_t>(std::min<std::uint32_t>(batch.count, INT32_MAX));
+                record.z           = batch.chunkZ;
+                record.dimension   = batch.dimension;
+                record.setPlayerName(GrowthPipeline::sourceName(batch.source));
+                mLogSink.push(record);
+            }
+        });
+        mBlockedCount.fetch_add(blocked, std::memory_order_relaxed);
+    } catch (...) {
+        // The counts of this flush are lost; the crops were protected regardless
+    }
+}
+
+bool PotatoBoneMealBlocker::isBoneMeal(const RuleSnapshot& rules, const ItemStack& item) noexcept {
+    // Flat table lookup by numeric item ID, no type name is built
+    return rules.coversItem(item.getId());
+}
+
+HandlerResult PotatoBoneMealBlocker::sendBlockedMessage(const RuleSnapshot& rules, Player& player) {
+    PBB_METRIC_SCOPE(FEEDBACK);
+
+    // Repeated attempts within the bucket limit are folded into a later summary
+    if (!mFeedback.tryConsume(player.getOrCreateUniqueID().id, steadyMillis(), rules.showInfoMessage ? 2 : 1)) {
+        return {};
+    }
+
+    // Packets built once per language; nothing is formatted or copied per attempt
     try {
+        if (mFeedbackPackets.send(player, rules.language, rules.showInfoMessage)) [[likely]] {
+            return {};
+        }
+
         // Send localized messages using the language system
         auto& language = Language::getInstance();
-        player.sendMessage(language.getBlockedMessage());
-        player.sendMessage(language.getInfoMessage());
+        player.sendMessage(language.getMessage(Language::MessageKey::BLOCKED_MESSAGE, rules.language));
+        if (rules.showInfoMessage) {
+            player.sendMessage(language.getMessage(Language::MessageKey::INFO_MESSAGE, rules.language));
+        }
+    } catch (...) {
+        // The network layer is outside the plugin's control; the attempt is blocked either way
+        return unexpected(HandlerFault::FEEDBACK);
+    }
+    return {};
+}
+
+void PotatoBoneMealBlocker::recordAttemptRate(Player& player) {
+    if (!mClickRate.record(player.getOrCreateUniqueID().id, steadyMillis())) [[likely]] {
+        return;
+    }
+    // Logged once per flag; the interactions dropped afterwards produce no output
+    const auto& settings = mClickRate.getSettings();
+    getSelf().getLogger().warn(
+        "{} exceeded {} blocked attempts in {} ms, dropping their interactions for {} ms",
+        player.getRealName(),
+        settings.maxAttempts,
+        settings.window.count(),
+        settings.cooldown.count()
+    );
+}
+
+void PotatoBoneMealBlocker::sendFeedbackSummaries() noexcept {
+    try {
+        auto level = ll::service::getLevel();
+        if (!level) {
+            return;
+        }
+
+        FrameScope  frame;
+        const auto& language = Language::getInstance();
+        ArenaString message;
+        mFeedback.flushSummaries(steadyMillis(), [&](std::int64_t playerId, std::uint32_t count) {
+            auto* player = level->getPlayer(ActorUniqueID(playerId));
+            if (!player) {
+                return;
+            }
+            message.clear();
+            language.formatMessage(message, Language::MessageKey::BLOCKED_SUMMARY, {count});
+            player->sendMessage(message);
+        });
     } catch (const std::exception& e) {
-        getSelf().getLogger().debug("Error sending message to player: {}", e.what());
+        getSelf().getLogger().debug("Error sending feedback summaries: {}", e.what());
     } catch (...) {
-        // Silently fail to avoid cascading errors
+        // Silently fail, summaries are best effort
     }
 }
 
-void PotatoBoneMealBlocker::logBlockedAttempt(std::string_view playerName, const BlockPos& blockPos) const noexcept {
+void PotatoBoneMealBlocker::logBlockedAttempt(Player& player, const BlockPos& blockPos) {
+    PBB_METRIC_SCOPE(LOG);
+
+    // Only a fixed-size record is built here; formatting and I/O happen on the sink thread
+    BlockedAttemptRecord record;
+    record.playerId    = player.getOrCreateUniqueID().id;
+    record.timestampMs = epochMillis();
+    record.x           = blockPos.x;
+    record.y           = blockPos.y;
+    record.z           = blockPos.z;
+    record.dimension   = player.getDimensionId().id;
+    record.setPlayerName(player.getRealName());
+
+    mLogSink.push(record);
+}
+
+void PotatoBoneMealBlocker::captureInteraction(
+    const ll::event::PlayerInteractBlockEvent& event,
+    const Block*                               block,
+    TraceDecision                              decision
+) noexcept {
     try {
-        // Use stringstream for efficient string formatting (compatible with older C++ standards)
-        std::ostringstream logStream;
-        logStream << "Prevented " << playerName
-                  << " from using bone meal on potato crop at ("
-                  << blockPos.x << ", " << blockPos.y << ", " << blockPos.z << ")";
+        const auto& item     = event.item();
+        const auto& blockPos = event.blockPos();
+        auto&       player   = event.self();
 
-        getSelf().getLogger().info(logStream.str());
+        TraceRecord record;
+        record.itemId         = item.getId();
+        record.blockRuntimeId = block ? block->getRuntimeId() : TraceRecord::UNKNOWN_BLOCK;
+        record.playerId       = player.getOrCreateUniqueID().id;
+        record.x              = blockPos.x;
+        record.y              = blockPos.y;
+        record.z              = blockPos.z;
+        record.dimension      = static_cast<std::int8_t>(player.getDimensionId().id);
+        record.decision       = decision;
 
-    } catch (const std::exception& e) {
-        // Fallback to basic logging if formatting fails
-        getSelf().getLogger().info("Prevented player from using bone meal on potato crop");
-        getSelf().getLogger().debug("Logging error: {}", e.what());
+        // Names are resolved once per ID and capture; the common case is two bit tests
+        if (mTraceWriter.needsItemName(record.itemId)) [[unlikely]] {
+            mTraceWriter.addItemName(record.itemId, item.getTypeName());
+        }
+        if (block && mTraceWriter.needsBlockName(record.blockRuntimeId)) [[unlikely]] {
+            mTraceWriter.addBlockName(record.blockRuntimeId, block->getTypeName(), growthStageOf(*block));
+        }
+
+        mTraceWriter.append(record);
     } catch (...) {
-        // Last resort logging
-        getSelf().getLogger().info("Prevented bone meal usage on potato crop");
+        // Capture must never affect the event outcome
     }
 }
 
@@ -242,6 +1477,7 @@ void PotatoBoneMealBlocker::logBlockedAttempt(std::string_view playerName, const
 
 LL_REGISTER_MOD(potato_bonemeal_blocker::PotatoBoneMealBlocker, potato_bonemeal_blocker::PotatoBoneMealBlocker::getInstance());
 
+#if defined(_WIN32)
 // Explicit plugin export functions for better compatibility
 extern "C" {
     __declspec(dllexport) bool ll_plugin_load() {
@@ -262,3 +1498,4 @@ extern "C" {
         }
     }
 }
+#endif
@@ -8,11 +8,36 @@
 #include "mc/world/item/ItemStack.h"
 #include "mc/world/actor/player/Player.h"
 #include "mc/world/level/BlockPos.h"
+#include "AsyncLogSink.h"
+#include "BlockedStats.h"
+#include "BlockLookupCache.h"
+#include "BypassCache.h"
+#include "ClickRateDetector.h"
+#include "Config.h"
+#include "ConfigWatcher.h"
+#include "CropCensus.h"
+#include "Expected.h"
+#include "FaultBreaker.h"
+#include "FeedbackLimiter.h"
+#include "FeedbackPackets.h"
+#include "FrameArena.h"
+#include "GrowthGovernor.h"
+#include "GrowthPipeline.h"
+#include "HeldItemTracker.h"
+#include "HostShare.h"
 #include "Language.h"
+#include "Metrics.h"
+#include "RuleMatcher.h"
+#include "ServerTicker.h"
+#include "ShadowEvaluator.h"
+#include "SnapshotCell.h"
+#include "TraceWriter.h"
 
 #include <string_view>
 #include <atomic>
+#include <filesystem>
 #include <memory>
+#include <vector>
 
 namespace potato_bonemeal_blocker {
 
@@ -20,7 +45,8 @@ namespace potato_bonemeal_blocker {
  * @brief Main plugin class that prevents bone meal usage on potato crops
  *
  * This plugin implements a singleton pattern and uses event-driven architecture
- * to intercept PlayerUseItemEvent and selectively block bone meal usage on potatoes.
+ * to intercept PlayerInteractBlockEvent and selectively block bone meal usage on potatoes.
+ * The listener is only registered while some player holds an item covered by a rule.
  *
  * Compatibility:
  * - LeviLamina 3 v1.2.0 and later
@@ -28,16 +54,16 @@ namespace potato_bonemeal_blocker {
  * - Windows x64 platform
  *
  * Performance optimizations:
- * - Cached string comparisons using string_view
+ * - Item and block names resolved to numeric runtime IDs once per configuration load
+ * - Rules read through one atomic snapshot pointer, swapped on config reload without locks
  * - Early returns to minimize processing
  * - Atomic counters for statistics
  * - Efficient memory management
  */
 class PotatoBoneMealBlocker {
 public:
-    // Compile-time constants for better performance
-    static constexpr std::string_view POTATO_BLOCK_NAME = "minecraft:potatoes";
-    static constexpr std::string_view BONE_MEAL_ITEM_NAME = "minecraft:bone_meal";
+    /// Configuration file name inside the plugin config directory
+    static constexpr std::string_view CONFIG_FILE_NAME = "potato-bonemeal-blocker.json";
 
     /**
      * @brief Get the singleton instance of the plugin
@@ -48,7 +74,9 @@ class PotatoBoneMealBlocker {
     /**
      * @brief Constructor - initializes the plugin with current mod reference
      */
-    PotatoBoneMealBlocker() : mSelf(*ll::mod::NativeMod::current()), mBlockedCount(0) {}
+    PotatoBoneMealBlocker()
+    : mSelf(*ll::mod::NativeMod::current()),
+      mBlockedCount(0) {}
 
     // Disable copy constructor and assignment operator for singleton
     PotatoBoneMealBlocker(const PotatoBoneMealBlocker&) = delete;
@@ -84,9 +112,229 @@ class PotatoBoneMealBlocker {
      */
     [[nodiscard]] std::uint64_t getBlockedCount() const noexcept { return mBlockedCount.load(); }
 
+    /**
+     * @brief Get the number of blocked attempts including earlier server sessions
+     * @return Attempts in the statistics file before this session plus getBlockedCount()
+     */
+    [[nodiscard]] std::uint64_t getLifetimeBlockedCount() const noexcept {
+        return mStats.getPersistedCount() + getBlockedCount();
+    }
+
+    /**
+     * @brief Get the per-player and per-chunk blocked-attempt statistics
+     * @return Reference to the statistics aggregator
+     */
+    [[nodiscard]] BlockedStats& getBlockedStats() noexcept { return mStats; }
+
+    /**
+     * @brief Replace the rule list; applied at once while enabled, otherwise on enable
+     * @param rules The item/block/growth-stage rules to enforce
+     * @return false if the plugin is enabled and none of the rules could be resolved
+     */
+    bool setRules(std::vector<GrowthRule> rules) noexcept;
+
+    /**
+     * @brief Get the configured rule list
+     * @return The rules as configured (names, not resolved IDs)
+     */
+    [[nodiscard]] const std::vector<GrowthRule>& getRules() const noexcept { return mConfig.rules; }
+
+    /**
+     * @brief Re-read the configuration file and publish it
+     *
+     * The file watcher does the same on its own when the file changes; this
+     * is the synchronous path used by `/potatoblocker reload`.
+     *
+     * @return true if the file was loaded and its rules compiled; otherwise the running rules stay
+     */
+    bool reloadConfig() noexcept;
+
+    /**
+     * @brief Get the configuration the current rule snapshot was compiled from
+     * @return The active configuration
+     */
+    [[nodiscard]] const PluginConfig& getConfig() const noexcept { return mConfig; }
+
+    /**
+     * @brief Get the published rule snapshots
+     * @return Reference to the snapshot cell
+     */
+    [[nodiscard]] const SnapshotCell<RuleSnapshot>& getRuleSnapshots() const noexcept { return mSnapshot; }
+
+    /**
+     * @brief Get the asynchronous sink used for blocked-attempt log lines
+     * @return Reference to the log sink
+     */
+    [[nodiscard]] AsyncLogSink& getLogSink() noexcept { return mLogSink; }
+
+    /**
+     * @brief Get the per-player feedback limiter
+     * @return Reference to the feedback limiter
+     */
+    [[nodiscard]] FeedbackLimiter& getFeedbackLimiter() noexcept { return mFeedback; }
+
+    /**
+     * @brief Start recording every interaction the handler sees into a trace file
+     * @param path The trace file; an item/block name palette is written next to it
+     * @return true if the capture started
+     */
+    bool startCapture(const std::filesystem::path& path) noexcept;
+
+    /**
+     * @brief Stop the running capture and flush it to disk
+     */
+    void stopCapture() noexcept;
+
+    /**
+     * @brief Get the interaction trace writer
+     * @return Reference to the trace writer
+     */
+    [[nodiscard]] const TraceWriter& getTraceWriter() const noexcept { return mTraceWriter; }
+
+    /**
+     * @brief Change how random-tick growth of the rules' crops is governed
+     * @param mode OFF removes the growth hook; BLOCK and THROTTLE install it while enabled
+     * @param throttleFactor In THROTTLE mode, crops grow on every this many random ticks
+     * @return true if the mode was applied
+     */
+    bool setGrowthMode(
+        GrowthGovernor::Mode mode,
+        std::uint32_t        throttleFactor = GrowthGovernor::DEFAULT_THROTTLE_FACTOR
+    ) noexcept;
+
+    /**
+     * @brief Get the per-player exemption cache
+     * @return Reference to the bypass cache
+     */
+    [[nodiscard]] const BypassCache& getBypassCache() const noexcept { return mBypass; }
+
+    /**
+     * @brief Get the auto-clicker detector
+     * @return Reference to the click-rate detector
+     */
+    [[nodiscard]] const ClickRateDetector& getClickRateDetector() const noexcept { return mClickRate; }
+
+    /**
+     * @brief Get the tracker of players holding a rule-covered item
+     * @return Reference to the held-item tracker
+     */
+    [[nodiscard]] const HeldItemTracker& getHeldItemTracker() const noexcept { return mHeldItems; }
+
+    /**
+     * @brief Check whether the PlayerInteractBlockEvent listener is registered
+     * @return true while someone holds a covered item, a capture runs, or tracking is unavailable
+     */
+    [[nodiscard]] bool isInteractListenerRegistered() const noexcept { return mPlayerUseItemListener != nullptr; }
+
+    /**
+     * @brief Get the number of times the interaction listener was registered since enable()
+     * @return Subscription count
+     */
+    [[nodiscard]] std::uint64_t getInteractSubscriptions() const noexcept { return mInteractSubscriptions; }
+
+    /**
+     * @brief Get the crop growth governor
+     * @return Reference to the growth governor
+     */
+    [[nodiscard]] const GrowthGovernor& getGrowthGovernor() const noexcept { return mGrowthGovernor; }
+
+    /**
+     * @brief Get the handler fault counters and circuit breaker
+     * @return Reference to the fault breaker
+     */
+    [[nodiscard]] const FaultBreaker& getFaultBreaker() const noexcept { return mFaultBreaker; }
+
+    /**
+     * @brief Close a tripped fault breaker and register the interaction listener again
+     * @return false if the breaker was not open
+     */
+    bool resetFaultBreaker() noexcept;
+
+    /**
+     * @brief Get the scheduled policies and which one is in force
+     * @return Reference to the schedule
+     */
+    [[nodiscard]] const PolicySchedule& getSchedule() const noexcept { return mSchedule; }
+
+    /**
+     * @brief Read the clocks the schedule is judged against
+     * @return Monotonic seconds, seconds since enable() and local seconds since Sunday 00:00
+     */
+    [[nodiscard]] PolicySchedule::Clock getScheduleClock() const noexcept;
+
+    /**
+     * @brief Get the cache of fallback block lookups
+     * @return Reference to the cache, for its hit and miss counts
+     */
+    [[nodiscard]] const BlockLookupCache& getBlockLookupCache() const noexcept { return mBlockCache; }
+
+    /**
+     * @brief Get the segment shared with the other server instances of this host
+     * @return Reference to the host share; closed unless host_share.enabled
+     */
+    [[nodiscard]] const HostShare& getHostShare() const noexcept { return mHostShare; }
+
+    /**
+     * @brief Get the dry-run evaluator of the candidate rule set
+     * @return Reference to the shadow evaluator
+     */
+    [[nodiscard]] const ShadowEvaluator& getShadowEvaluator() const noexcept { return mShadow; }
+
+    /**
+     * @brief Get the pipeline judging dispensers and other non-player fertilizer sources
+     * @return Reference to the growth pipeline
+     */
+    [[nodiscard]] const GrowthPipeline& getGrowthPipeline() const noexcept { return mGrowthPipeline; }
+
+    /**
+     * @brief Start counting the rules' crops in the chunks around the online players
+     * @param done Called on the server thread with the report, a few ticks later
+     * @return Number of chunks to count, or 0 if no census was started
+     */
+    std::size_t startCensus(CropCensus::Callback done) noexcept;
+
+    /**
+     * @brief Get the crop census
+     * @return Reference to the census, to check whether one is running
+     */
+    [[nodiscard]] const CropCensus& getCropCensus() const noexcept { return mCensus; }
+
 private:
     ll::mod::NativeMod& mSelf;
     ll::event::ListenerPtr mPlayerUseItemListener;
+    ll::event::ListenerPtr mPlayerDisconnectListener;
+    ll::event::ListenerPtr mPlayerJoinListener;
+    ll::event::ListenerPtr mBlockPlacedListener;
+    ll::event::ListenerPtr mBlockDestroyedListener;
+    std::filesystem::path mConfigPath; ///< potato-bonemeal-blocker.json in the config directory
+    PluginConfig mConfig;             ///< Active configuration, server thread only
+    SnapshotCell<RuleSnapshot> mSnapshot; ///< Compiled rules read by the event path
+    ConfigWatcher mConfigWatcher;     ///< Parses the config file off-thread when it changes
+    AsyncLogSink mLogSink;            ///< Formats and writes blocked-attempt records off the game thread
+    FeedbackLimiter mFeedback;        ///< Per-player token buckets for blocked feedback
+    FeedbackPackets mFeedbackPackets; ///< Blocked and info text packets per language, built on config apply
+    BypassCache mBypass;              ///< Per-player exemption decisions
+    ClickRateDetector mClickRate;     ///< Per-player attempt rings; flagged players skip the handler
+    FaultBreaker mFaultBreaker;       ///< Handler faults by kind; unregisters the listener past its budget
+    ShadowEvaluator mShadow;          ///< Samples the candidate rule set's decisions next to the live rules
+    HeldItemTracker mHeldItems;       ///< Players with a covered item selected; gates the interaction listener
+    std::uint64_t mInteractSubscriptions = 0; ///< Registrations of the interaction listener since enable()
+    BlockedStats mStats;              ///< Per-player and per-chunk blocked attempts, persisted hourly buckets
+    ServerTicker mTicker;             ///< Periodic server-thread tasks
+    metrics::Exporter mMetricsExporter; ///< Writes handler metrics to metrics.prom
+    TraceWriter mTraceWriter;         ///< Interaction capture, idle unless a trace is started
+    GrowthGovernor mGrowthGovernor;   ///< Random-tick growth filter for the rules' crops
+    BlockLookupCache mBlockCache;     ///< Fallback block lookups by position, dropped when the block changes
+    PolicySchedule mSchedule;         ///< Time-boxed rule sets; switches the snapshot at window boundaries
+    std::int64_t mStartedMs      = 0;  ///< Steady clock at enable(), for windows relative to the start
+    std::int64_t mScheduleSecond = -1; ///< Steady second the schedule was last advanced in
+    GrowthPipeline mGrowthPipeline;   ///< Judges dispensers and other non-player fertilizer sources
+    CropCensus mCensus;               ///< Crop count around the players, copied per tick and counted off-thread
+    HostShare mHostShare;             ///< Configuration and totals shared with the host's other instances
+    std::uint64_t mHostConfigGeneration    = 0; ///< Shared configuration generation applied or published last
+    std::uint64_t mHostPublishedBlocked    = 0; ///< getBlockedCount() already added to the host totals
+    std::uint64_t mHostPublishedFertilizer = 0; ///< Growth pipeline blocks already added to the host totals
+    bool mEnabled = false;            ///< Between a successful enable() and disable()
     std::atomic<std::uint64_t> mBlockedCount; ///< Thread-safe counter for blocked attempts
 
     /**
@@ -96,31 +344,229 @@ class PotatoBoneMealBlocker {
     void onPlayerInteractBlock(ll::event::PlayerInteractBlockEvent& event) noexcept;
 
     /**
-     * @brief Check if a block is a potato crop
-     * @param block The block to check
-     * @return true if the block is a potato crop, false otherwise
+     * @brief Evaluate one interaction; exceptions are left to the caller's single boundary
+     * @param event The PlayerInteractBlockEvent to process
+     * @return The fault that stopped the evaluation, if any
+     */
+    HandlerResult handleInteraction(ll::event::PlayerInteractBlockEvent& event);
+
+    /**
+     * @brief Get the target block, from the event, the block lookup cache or the player's block source
+     * @param event The interaction event
+     * @param player The interacting player
+     * @return The block, or BLOCK_LOOKUP if the fallback lookup failed
+     */
+    [[nodiscard]] Expected<const Block*, HandlerFault>
+    resolveBlock(ll::event::PlayerInteractBlockEvent& event, Player& player) noexcept;
+
+    /**
+     * @brief Judge a sampled interaction with the live and the candidate rules and record both decisions
+     * @param event The interaction event, after the live handler ran
+     * @param handlerNs Time the live handler took on it
+     */
+    void evaluateShadow(ll::event::PlayerInteractBlockEvent& event, std::int64_t handlerNs) noexcept;
+
+    /**
+     * @brief Count a handler fault, logging the first of each kind, and trip the breaker past its budget
+     * @param fault The fault kind
+     * @param detail Exception message, if any
+     */
+    void recordFault(HandlerFault fault, std::string_view detail) noexcept;
+
+    /**
+     * @brief Alert the log and online operators that the breaker opened; the listener goes on the next release
+     */
+    void tripFaultBreaker() noexcept;
+
+    /**
+     * @brief Compile a configuration into a rule snapshot
+     * @param config The configuration
+     * @param policy Scheduled policy whose rules replace the configured rules, or nullptr
+     * @return The snapshot, or nullptr if no configured rule could be resolved
+     */
+    [[nodiscard]] std::unique_ptr<const RuleSnapshot>
+    compileSnapshot(const PluginConfig& config, const PolicySchedule::Policy* policy) const;
+
+    /**
+     * @brief Advance the schedule's timer wheel and publish new rules when the policy in force changes
+     */
+    void advanceSchedule() noexcept;
+
+    /**
+     * @brief Compile the shadow-mode candidate rules and regions
+     * @param config The configuration
+     * @return The candidate's snapshot; only its matchers and region index are set
+     */
+    [[nodiscard]] std::unique_ptr<const RuleSnapshot> compileCandidate(const PluginConfig& config) const;
+
+    /**
+     * @brief Compile regions and their rule lists into a snapshot
+     * @param globalRules The rules outside every region
+     * @param regionConfigs The regions
+     * @param snapshot Receives the region index, region rules and combined item filter
      */
-    [[nodiscard]] bool isPotatoCrop(const Block& block) const noexcept;
+    void compileRegions(
+        const std::vector<GrowthRule>&   globalRules,
+        const std::vector<RegionConfig>& regionConfigs,
+        RuleSnapshot&                    snapshot
+    ) const;
 
     /**
-     * @brief Check if an item is bone meal
+     * @brief Compile a configuration, publish its snapshot and apply its other settings
+     * @param config The new configuration
+     * @return true if it was applied; on failure the running configuration stays
+     */
+    bool applyConfig(PluginConfig config);
+
+    /**
+     * @brief Open the host share named by the configuration, publishing or adopting the shared configuration
+     */
+    void openHostShare() noexcept;
+
+    /**
+     * @brief Publish the active configuration to the host share, if open
+     */
+    void shareConfig() noexcept;
+
+    /**
+     * @brief Add new blocked attempts to the host totals and apply a configuration another instance published
+     */
+    void syncHostShare() noexcept;
+
+    /**
+     * @brief Open the statistics file in the data directory and start its flusher
+     */
+    void startStats() noexcept;
+
+    /**
+     * @brief Apply the configured queue settings and start the blocked-attempt log sink
+     */
+    void startLogSink() noexcept;
+
+    /**
+     * @brief Apply a configuration parsed by the watcher and reclaim retired snapshots
+     */
+    void pollConfig() noexcept;
+
+    /**
+     * @brief Check whether a player is exempt from the rules
+     * @param player The interacting player
+     * @return The cached decision; computed and cached on a miss
+     */
+    [[nodiscard]] bool isExempt(Player& player);
+
+    /**
+     * @brief Re-evaluate the exemption of every online player, e.g. after permission changes
+     */
+    void refreshBypass() noexcept;
+
+    /**
+     * @brief Register the PlayerInteractBlockEvent listener unless it already is
+     * @return true if the listener is registered
+     */
+    bool subscribeInteract() noexcept;
+
+    /**
+     * @brief Remove the PlayerInteractBlockEvent listener if nobody needs it any more
+     */
+    void releaseInteract() noexcept;
+
+    /**
+     * @brief Re-evaluate the selected item of every online player, e.g. after the rules changed
+     */
+    void refreshHeldItems() noexcept;
+
+    /**
+     * @brief Check if an item is a fertilizer covered by any rule
+     * @param rules The current rule snapshot
      * @param item The item to check
-     * @return true if the item is bone meal, false otherwise
+     * @return true if the item is bone meal (or another item in a global or region rule), false otherwise
      */
-    [[nodiscard]] bool isBoneMeal(const ItemStack& item) const noexcept;
+    [[nodiscard]] static bool isBoneMeal(const RuleSnapshot& rules, const ItemStack& item) noexcept;
 
     /**
-     * @brief Send feedback messages to player efficiently
+     * @brief Send feedback messages to player, unless coalesced by the feedback limiter
+     * @param rules The current rule snapshot
      * @param player The player to send messages to
+     * @return FEEDBACK if sending failed
+     */
+    HandlerResult sendBlockedMessage(const RuleSnapshot& rules, Player& player);
+
+    /**
+     * @brief Feed a blocked attempt to the auto-clicker detector, logging when the player gets flagged
+     * @param player The player whose attempt was blocked
+     */
+    void recordAttemptRate(Player& player);
+
+    /**
+     * @brief Apply the side effects of a blocked player attempt: feedback, rate tracking, log and statistics
+     * @param rules The current rule snapshot
+     * @param player The player whose attempt was blocked
+     * @param attempt The blocked attempt
+     * @return FEEDBACK if the message could not be sent; the other side effects are applied regardless
+     */
+    HandlerResult onPlayerBlocked(const RuleSnapshot& rules, Player& player, const GrowthAttempt& attempt);
+
+    /**
+     * @brief Turn the growth pipeline's per-chunk counts of non-player attempts into statistics and log lines
+     */
+    void flushGrowthBatches() noexcept;
+
+    /**
+     * @brief Send "blocked N times" summaries for coalescing windows that have ended
      */
-    void sendBlockedMessage(Player& player) const noexcept;
+    void sendFeedbackSummaries() noexcept;
 
     /**
-     * @brief Log blocked attempt with optimized formatting
-     * @param playerName The name of the player
+     * @brief Queue a blocked-attempt record for the asynchronous log sink
+     * @param player The player whose attempt was blocked
      * @param blockPos The position where bone meal was blocked
      */
-    void logBlockedAttempt(std::string_view playerName, const BlockPos& blockPos) const noexcept;
+    void logBlockedAttempt(Player& player, const BlockPos& blockPos);
+
+    /**
+     * @brief Resolve the block types of the rules' crops
+     * @return Distinct crop types named by any rule
+     */
+    [[nodiscard]] std::vector<const BlockLegacy*> resolveGovernedTypes() const;
+
+    /**
+     * @brief Resolve the block types the block lookup cache must not keep
+     * @param config The configuration being applied
+     * @return Distinct crop types named by the live, region or shadow rules
+     */
+    [[nodiscard]] static std::vector<const BlockLegacy*> resolveVolatileTypes(const PluginConfig& config);
+
+    /**
+     * @brief Drop cached lookups of a changed block and tell the growth governor about it
+     * @param dimension Dimension ID
+     * @param pos Position of the block
+     * @param placed The block that was placed, or nullptr if it was destroyed or could not be read
+     */
+    void onBlockChanged(int dimension, const BlockPos& pos, const Block* placed) noexcept;
+
+    /**
+     * @brief Resolve the governed crop types and install the growth hook
+     * @return true if the hook is installed
+     */
+    bool attachGrowthGovernor();
+
+    /**
+     * @brief Remove the growth hook and the placement listeners
+     */
+    void detachGrowthGovernor() noexcept;
+
+    /**
+     * @brief Append an interaction to the running trace capture
+     * @param event The handled event
+     * @param block The target block if the handler resolved it, nullptr otherwise
+     * @param decision What the handler did with the event
+     */
+    void captureInteraction(
+        const ll::event::PlayerInteractBlockEvent& event,
+        const Block*                               block,
+        TraceDecision                              decision
+    ) noexcept;
 };
 
 } // namespace potato_bonemeal_blocker
@@ -0,0 +1,65 @@
+#include "mod/RegionIndex.h"
+
+#include <algorithm>
+
+namespace potato_bonemeal_blocker {
+
+void RegionIndex::build(std::span<const Region> regions) {
+    // Stable: equal priorities keep their definition order
+    std::vector<Region> entries(regions.begin(), regions.end());
+    std::stable_sort(entries.begin(), entries.end(), [](const Region& a, const Region& b) {
+        return a.priority > b.priority;
+    });
+
+    // Count candidates per chunk first so every list is one contiguous range
+    FlatIdMap<std::uint32_t>   counts;
+    std::vector<std::uint32_t> large;
+    const auto forEachChunk = [](const RegionBox& box, auto&& visit) {
+        for (int chunkX = box.minX >> 4; chunkX <= box.maxX >> 4; ++chunkX) {
+            for (int chunkZ = box.minZ >> 4; chunkZ <= box.maxZ >> 4; ++chunkZ) {
+                visit(chunkKey(box.dimension, chunkX, chunkZ));
+            }
+        }
+    };
+    const auto isLarge = [](const RegionBox& box) {
+        const auto chunksX = static_cast<std::size_t>((box.maxX >> 4) - (box.minX >> 4) + 1);
+        const auto chunksZ = static_cast<std::size_t>((box.maxZ >> 4) - (box.minZ >> 4) + 1);
+        return chunksX * chunksZ > LARGE_REGION_CHUNKS;
+    };
+
+    for (std::uint32_t entry = 0; entry < entries.size(); ++entry) {
+        const auto& box = entries[entry].box;
+        if (isLarge(box)) {
+            large.push_back(entry);
+            continue;
+        }
+        forEachChunk(box, [&](std::int64_t key) { ++counts[key]; });
+    }
+
+    FlatIdMap<Cell> cells(counts.size() * 2);
+    std::uint32_t   offset = 0;
+    counts.forEach([&](std::int64_t key, std::uint32_t& count) {
+        cells[key] = Cell{offset, offset};
+        offset    += count;
+    });
+
+    // Entries are visited in precedence order, so each chunk's list comes out sorted
+    std::vector<std::uint32_t> cellEntries(offset);
+    for (std::uint32_t entry = 0; entry < entries.size(); ++entry) {
+        const auto& box = entries[entry].box;
+        if (isLarge(box)) {
+            continue;
+        }
+        forEachChunk(box, [&](std::int64_t key) {
+            auto& cell              = *cells.find(key);
+            cellEntries[cell.end++] = entry;
+        });
+    }
+
+    mEntries      = std::move(entries);
+    mCells        = std::move(cells);
+    mCellEntries  = std::move(cellEntries);
+    mLargeEntries = std::move(large);
+}
+
+} // namespace potato_bonemeal_blocker
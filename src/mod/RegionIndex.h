@@ -0,0 +1,122 @@
+#pragma once
+
+#include "FlatIdMap.h"
+
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+namespace potato_bonemeal_blocker {
+
+/**
+ * @brief An axis-aligned block box in one dimension, bounds inclusive
+ */
+struct RegionBox {
+    int dimension = 0;
+    int minX = 0, minY = 0, minZ = 0;
+    int maxX = 0, maxY = 0, maxZ = 0;
+
+    [[nodiscard]] constexpr bool contains(int x, int y, int z) const noexcept {
+        return x >= minX && x <= maxX && y >= minY && y <= maxY && z >= minZ && z <= maxZ;
+    }
+
+    bool operator==(const RegionBox&) const = default;
+};
+
+/**
+ * @brief Chunk-grid index answering "which region contains this block"
+ *
+ * Every region is registered in each 16x16 chunk column it overlaps. A
+ * lookup packs the position's chunk into one key, finds that chunk's
+ * candidate list with a single hash probe and tests the few boxes in it,
+ * so the cost does not depend on how many regions exist.
+ *
+ * Regions spanning more than LARGE_REGION_CHUNKS chunks (whole-map event
+ * areas) are not registered per chunk; they are kept in one short list that
+ * every lookup tests as well.
+ *
+ * Overlapping regions are resolved by priority, higher first, then by
+ * definition order. The index is immutable once built and safe to read from
+ * any thread.
+ */
+class RegionIndex {
+public:
+    /// Returned by find() for positions outside every region
+    static constexpr std::uint32_t NO_REGION = std::numeric_limits<std::uint32_t>::max();
+
+    /// Regions overlapping more chunks than this go to the always-tested list
+    static constexpr std::size_t LARGE_REGION_CHUNKS = 4096;
+
+    /**
+     * @brief A region to index
+     */
+    struct Region {
+        RegionBox     box;
+        std::int32_t  priority = 0; ///< Higher wins where regions overlap
+        std::uint32_t value    = 0; ///< Returned by find(), e.g. a rule set index
+    };
+
+    /**
+     * @brief Build the index, replacing any previous contents
+     * @param regions The regions; boxes must have min <= max on every axis
+     */
+    void build(std::span<const Region> regions);
+
+    /**
+     * @brief Find the winning region at a block position
+     * @param dimension Dimension ID
+     * @return The region's value, or NO_REGION
+     */
+    [[nodiscard]] std::uint32_t find(int dimension, int x, int y, int z) const noexcept {
+        // Entries are ordered by precedence, so the lowest matching entry index wins
+        auto best = NO_REGION;
+        if (const auto* cell = mCells.find(chunkKey(dimension, x >> 4, z >> 4))) {
+            for (auto i = cell->begin; i < cell->end; ++i) {
+                const auto entry = mCellEntries[i];
+                if (mEntries[entry].box.contains(x, y, z)) {
+                    best = entry;
+                    break;
+                }
+            }
+        }
+        for (const auto entry : mLargeEntries) {
+            if (entry >= best) {
+                break;
+            }
+            const auto& box = mEntries[entry].box;
+            if (box.dimension == dimension && box.contains(x, y, z)) {
+                best = entry;
+                break;
+            }
+        }
+        return best == NO_REGION ? NO_REGION : mEntries[best].value;
+    }
+
+    [[nodiscard]] bool        empty() const noexcept { return mEntries.empty(); }
+    [[nodiscard]] std::size_t size() const noexcept { return mEntries.size(); }
+    [[nodiscard]] std::size_t getChunkCount() const noexcept { return mCells.size(); }
+    [[nodiscard]] std::size_t getLargeRegionCount() const noexcept { return mLargeEntries.size(); }
+
+private:
+    struct Cell {
+        std::uint32_t begin = 0; ///< Range in mCellEntries
+        std::uint32_t end   = 0;
+    };
+
+    [[nodiscard]] static constexpr std::int64_t chunkKey(int dimension, int chunkX, int chunkZ) noexcept {
+        // 8 bits dimension, 24 bits per chunk coordinate; the top bit stays clear for FlatIdMap
+        return static_cast<std::int64_t>(
+            (static_cast<std::uint64_t>(dimension & 0xFF) << 48)
+            | (static_cast<std::uint64_t>(static_cast<std::uint32_t>(chunkX) & 0xFFFFFF) << 24)
+            | static_cast<std::uint64_t>(static_cast<std::uint32_t>(chunkZ) & 0xFFFFFF)
+        );
+    }
+
+    std::vector<Region>        mEntries;      ///< Sorted by precedence
+    FlatIdMap<Cell>            mCells;        ///< Chunk key -> candidate entries
+    std::vector<std::uint32_t> mCellEntries;  ///< Candidate lists of all chunks, each in precedence order
+    std::vector<std::uint32_t> mLargeEntries; ///< Entries tested on every lookup, in precedence order
+};
+
+} // namespace potato_bonemeal_blocker
@@ -0,0 +1,70 @@
+#include "mod/RuleMatcher.h"
+
+#include <limits>
+
+namespace potato_bonemeal_blocker {
+
+RuleMatcher::CompileReport RuleMatcher::compile(std::span<const GrowthRule> rules, const Resolver& resolver) {
+    CompileReport report;
+
+    std::vector<std::uint8_t>                itemSlots(std::size_t{1} << 16, 0);
+    std::vector<std::vector<std::uint64_t>> blockSets;
+
+    for (const auto& rule : rules) {
+        const auto itemId = resolver.resolveItem(rule.itemName);
+        if (!itemId) {
+            report.unresolved.push_back(rule.itemName);
+            continue;
+        }
+
+        // Resolve every growth stage at or above the threshold to its own runtime ID
+        std::vector<std::uint32_t> runtimeIds;
+        for (unsigned stage = rule.minGrowthStage; stage <= MAX_GROWTH_STAGE; ++stage) {
+            if (const auto runtimeId = resolver.resolveBlock(rule.blockName, static_cast<std::uint8_t>(stage))) {
+                runtimeIds.push_back(*runtimeId);
+            }
+        }
+        if (runtimeIds.empty()) {
+            report.unresolved.push_back(rule.blockName);
+            continue;
+        }
+
+        // Items sharing rules share one block set
+        auto& slot = itemSlots[static_cast<std::uint16_t>(*itemId)];
+        if (slot == 0) {
+            if (blockSets.size() == std::numeric_limits<std::uint8_t>::max()) {
+                report.unresolved.push_back(rule.itemName);
+                continue;
+            }
+            blockSets.emplace_back();
+            slot = static_cast<std::uint8_t>(blockSets.size());
+        }
+
+        auto& bits = blockSets[slot - 1];
+        for (const auto runtimeId : runtimeIds) {
+            const auto word = runtimeId >> 6;
+            if (word >= bits.size()) {
+                bits.resize(word + 1, 0);
+            }
+            bits[word] |= std::uint64_t{1} << (runtimeId & 63);
+        }
+
+        report.blockStates += runtimeIds.size();
+        ++report.compiledRules;
+    }
+
+    if (blockSets.empty()) {
+        clear();
+    } else {
+        mItemSlots = std::move(itemSlots);
+        mBlockSets = std::move(blockSets);
+    }
+    return report;
+}
+
+void RuleMatcher::clear() noexcept {
+    std::vector<std::uint8_t>().swap(mItemSlots);
+    std::vector<std::vector<std::uint64_t>>().swap(mBlockSets);
+}
+
+} // namespace potato_bonemeal_blocker
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace potato_bonemeal_blocker {
+
+/**
+ * @brief A single "item X may not be used on block Y" rule
+ *
+ * Names are resolved to runtime IDs once by RuleMatcher::compile(), never on the event path.
+ */
+struct GrowthRule {
+    std::string  itemName;           ///< Fertilizer item, e.g. "minecraft:bone_meal"
+    std::string  blockName;          ///< Protected crop block, e.g. "minecraft:potatoes"
+    std::uint8_t minGrowthStage = 0; ///< First growth stage (inclusive) the rule applies to
+
+    bool operator==(const GrowthRule&) const = default;
+};
+
+/**
+ * @brief Numeric-ID rule matcher for (item, block, growth stage) triples
+ *
+ * Rules are compiled into two flat tables:
+ * - a 64K entry table indexed by item ID holding a 1-based slot (0 = item has no rules)
+ * - one bitset per slot over block runtime IDs, where every runtime ID stands for
+ *   exactly one (block, growth stage) permutation
+ *
+ * A lookup is therefore two array loads regardless of how many rules are configured.
+ */
+class RuleMatcher {
+public:
+    /// Highest growth stage representable in the legacy data nibble
+    static constexpr std::uint8_t MAX_GROWTH_STAGE = 15;
+
+    /**
+     * @brief Translates configured names into runtime IDs
+     *
+     * Implemented on top of the game registries in the plugin and on top of
+     * recorded palettes in offline tools.
+     */
+    class Resolver {
+    public:
+        virtual ~Resolver() = default;
+
+        /**
+         * @brief Resolve an item name to its numeric item ID
+         * @param name The namespaced item name
+         * @return The item ID, or std::nullopt if the item does not exist
+         */
+        [[nodiscard]] virtual std::optional<std::int16_t> resolveItem(std::string_view name) const = 0;
+
+        /**
+         * @brief Resolve a block permutation to its runtime ID
+         * @param name The namespaced block name
+         * @param growthStage The growth stage (legacy data value) of the permutation
+         * @return The runtime ID, or std::nullopt if the permutation does not exist
+         */
+        [[nodiscard]] virtual std::optional<std::uint32_t>
+        resolveBlock(std::string_view name, std::uint8_t growthStage) const = 0;
+    };
+
+    /**
+     * @brief Result of compiling a rule list
+     */
+    struct CompileReport {
+        std::size_t              compiledRules = 0; ///< Rules that resolved to at least one block permutation
+        std::size_t              blockStates   = 0; ///< Total block permutations marked
+        std::vector<std::string> unresolved;        ///< Item or block names that could not be resolved
+    };
+
+    /**
+     * @brief Compile a rule list, replacing any previously compiled rules
+     * @param rules The rules to compile
+     * @param resolver Resolver used to translate names to runtime IDs
+     * @return Summary of the compilation
+     */
+    CompileReport compile(std::span<const GrowthRule> rules, const Resolver& resolver);
+
+    /**
+     * @brief Remove all compiled rules
+     */
+    void clear() noexcept;
+
+    /**
+     * @brief Check whether any rule uses the given item
+     * @param itemId The numeric item ID
+     * @return true if at least one rule applies to this item
+     */
+    [[nodiscard]] bool matchesItem(std::int16_t itemId) const noexcept {
+        return !mItemSlots.empty() && mItemSlots[static_cast<std::uint16_t>(itemId)] != 0;
+    }
+
+    /**
+     * @brief Check whether using the item on the block permutation is forbidden
+     * @param itemId The numeric item ID
+     * @param blockRuntimeId The runtime ID of the target block permutation
+     * @return true if a rule forbids this combination
+     */
+    [[nodiscard]] bool matches(std::int16_t itemId, std::uint32_t blockRuntimeId) const noexcept {
+        if (mItemSlots.empty()) {
+            return false;
+        }
+        const auto slot = mItemSlots[static_cast<std::uint16_t>(itemId)];
+        if (slot == 0) {
+            return false;
+        }
+        const auto& bits = mBlockSets[slot - 1];
+        const auto  word = blockRuntimeId >> 6;
+        return word < bits.size() && ((bits[word] >> (blockRuntimeId & 63)) & 1) != 0;
+    }
+
+    /**
+     * @brief Check whether any rule is compiled
+     * @return true if no rule is active
+     */
+    [[nodiscard]] bool empty() const noexcept { return mBlockSets.empty(); }
+
+private:
+    std::vector<std::uint8_t>                mItemSlots; ///< Item ID -> 1-based block set slot
+    std::vector<std::vector<std::uint64_t>> mBlockSets; ///< Per-item bitsets over block runtime IDs
+};
+
+} // namespace potato_bonemeal_blocker
@@ -0,0 +1,57 @@
+#include "mod/ServerTicker.h"
+
+#include "ll/api/chrono/GameChrono.h"
+#include "ll/api/coro/CoroTask.h"
+#include "ll/api/thread/ServerThreadExecutor.h"
+
+#include <algorithm>
+
+namespace potato_bonemeal_blocker {
+
+void ServerTicker::addTask(std::uint32_t intervalTicks, Task task) {
+    const auto interval = std::max<std::uint32_t>(intervalTicks, 1);
+    mTasks.push_back(Entry{interval, mCurrentTick + interval, std::move(task)});
+}
+
+void ServerTicker::start() {
+    if (mRunning && mRunning->load()) {
+        return;
+    }
+
+    // The flag is shared with the coroutine so a stopped ticker can never be resumed into
+    mRunning = std::make_shared<std::atomic<bool>>(true);
+    ll::coro::keepThis([this, running = mRunning]() -> ll::coro::CoroTask<> {
+        while (running->load()) {
+            co_await ll::chrono::ticks(1);
+            if (!running->load()) {
+                break;
+            }
+            tick();
+        }
+        co_return;
+    }).launch(ll::thread::ServerThreadExecutor::getDefault());
+}
+
+void ServerTicker::stop() noexcept {
+    if (mRunning) {
+        mRunning->store(false);
+        mRunning.reset();
+    }
+}
+
+void ServerTicker::tick() noexcept {
+    ++mCurrentTick;
+    for (auto& entry : mTasks) {
+        if (mCurrentTick < entry.nextTick) {
+            continue;
+        }
+        entry.nextTick = mCurrentTick + entry.interval;
+        try {
+            entry.task();
+        } catch (...) {
+            // A failing task must not stop the others
+        }
+    }
+}
+
+} // namespace potato_bonemeal_blocker
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace potato_bonemeal_blocker {
+
+/**
+ * @brief Runs periodic plugin tasks on the server thread, once per game tick
+ *
+ * Tasks are registered before start() with an interval in ticks. The ticker
+ * is driven by a LeviLamina coroutine on the server thread executor, so
+ * tasks may touch game state and the plugin's game-thread-only structures.
+ */
+class ServerTicker {
+public:
+    using Task = std::function<void()>;
+
+    ServerTicker() = default;
+    ~ServerTicker() { stop(); }
+
+    ServerTicker(const ServerTicker&)            = delete;
+    ServerTicker& operator=(const ServerTicker&) = delete;
+
+    /**
+     * @brief Register a periodic task
+     * @param intervalTicks Run the task every this many ticks (20 ticks = 1 second)
+     * @param task The task to run on the server thread
+     */
+    void addTask(std::uint32_t intervalTicks, Task task);
+
+    /**
+     * @brief Remove all registered tasks
+     */
+    void clearTasks() noexcept { mTasks.clear(); }
+
+    /**
+     * @brief Start ticking on the server thread
+     */
+    void start();
+
+    /**
+     * @brief Stop ticking; pending coroutine resumptions become no-ops
+     */
+    void stop() noexcept;
+
+    /**
+     * @brief Advance one tick and run the tasks that are due
+     */
+    void tick() noexcept;
+
+    /**
+     * @brief Get the number of ticks since start()
+     * @return Current tick
+     */
+    [[nodiscard]] std::uint64_t getCurrentTick() const noexcept { return mCurrentTick; }
+
+private:
+    struct Entry {
+        std::uint32_t interval = 1;
+        std::uint64_t nextTick = 0;
+        Task          task;
+    };
+
+    std::vector<Entry>                 mTasks;
+    std::uint64_t                      mCurrentTick = 0;
+    std::shared_ptr<std::atomic<bool>> mRunning;
+};
+
+} // namespace potato_bonemeal_blocker
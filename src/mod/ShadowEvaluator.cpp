@@ -0,0 +1,107 @@
+#include "mod/ShadowEvaluator.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+namespace potato_bonemeal_blocker {
+
+void ShadowEvaluator::configure(const Settings& settings) noexcept {
+    auto clamped           = settings;
+    clamped.sampleInterval = std::bit_ceil(std::clamp<std::uint32_t>(settings.sampleInterval, 1, MAX_SAMPLE_INTERVAL));
+    clamped.maxOverhead    = std::clamp(settings.maxOverhead, 1e-6, 1.0);
+    if (clamped == mSettings) {
+        return;
+    }
+    mSettings = clamped;
+    mMinMask  = clamped.sampleInterval - 1;
+    reset();
+}
+
+void ShadowEvaluator::reset() noexcept {
+    mMask            = mMinMask;
+    mEvents          = 0;
+    mSamples         = 0;
+    mSkipped         = 0;
+    mLiveOnly        = 0;
+    mCandidateOnly   = 0;
+    mShadowNs        = 0;
+    mHandlerNs       = 0;
+    mWindowShadowNs  = 0;
+    mWindowHandlerNs = 0;
+    mWindowSamples   = 0;
+    mNext            = 0;
+    mFilled          = 0;
+}
+
+void ShadowEvaluator::record(const Sample& sample, std::uint64_t handlerNs, std::uint64_t shadowNs) noexcept {
+    ++mSamples;
+    if (sample.live && !sample.candidate) {
+        ++mLiveOnly;
+    } else if (!sample.live && sample.candidate) {
+        ++mCandidateOnly;
+    }
+    mRing[mNext] = sample;
+    mNext        = (mNext + 1) % RING_SIZE;
+    mFilled      = std::min(mFilled + 1, RING_SIZE);
+    account(handlerNs, shadowNs);
+}
+
+void ShadowEvaluator::skip(std::uint64_t handlerNs, std::uint64_t shadowNs) noexcept {
+    ++mSkipped;
+    account(handlerNs, shadowNs);
+}
+
+void ShadowEvaluator::account(std::uint64_t handlerNs, std::uint64_t shadowNs) noexcept {
+    // The sampled event stands for every event of its interval
+    mShadowNs        += shadowNs;
+    mHandlerNs       += handlerNs * (mMask + 1);
+    mWindowShadowNs  += shadowNs;
+    mWindowHandlerNs += handlerNs;
+    if (++mWindowSamples < ADAPT_SAMPLES) {
+        return;
+    }
+
+    // shadow / (handler * interval) <= maxOverhead; a coarse clock may read 0 ns, so count at least 1 per sample
+    const auto handler  = static_cast<double>(std::max<std::uint64_t>(mWindowHandlerNs, mWindowSamples));
+    const auto needed   = static_cast<double>(mWindowShadowNs) / (handler * mSettings.maxOverhead);
+    const auto interval = needed >= MAX_SAMPLE_INTERVAL ? MAX_SAMPLE_INTERVAL
+                                                        : std::bit_ceil(static_cast<std::uint32_t>(std::ceil(needed)));
+    mMask            = std::max(interval - 1, mMinMask);
+    mWindowShadowNs  = 0;
+    mWindowHandlerNs = 0;
+    mWindowSamples   = 0;
+}
+
+ShadowEvaluator::Summary ShadowEvaluator::summarize(std::size_t limit) const {
+    Summary summary;
+    summary.events        = mEvents;
+    summary.samples       = mSamples;
+    summary.skipped       = mSkipped;
+    summary.liveOnly      = mLiveOnly;
+    summary.candidateOnly = mCandidateOnly;
+    summary.agreed        = mSamples - mLiveOnly - mCandidateOnly;
+    summary.interval      = getInterval();
+    summary.overhead      = mHandlerNs > 0 ? static_cast<double>(mShadowNs) / static_cast<double>(mHandlerNs) : 0.0;
+    summary.ringSamples   = mFilled;
+
+    std::vector<std::uint32_t> costs;
+    costs.reserve(mFilled);
+    for (std::size_t i = 0; i < mFilled; ++i) {
+        // Newest first: the slot before mNext, walking backwards
+        const auto& sample = mRing[(mNext + RING_SIZE - 1 - i) % RING_SIZE];
+        costs.push_back(sample.costNs);
+        if (sample.live != sample.candidate && summary.disagreements.size() < limit) {
+            summary.disagreements.push_back(sample);
+        }
+    }
+    if (!costs.empty()) {
+        std::sort(costs.begin(), costs.end());
+        summary.costP50Ns = costs[(costs.size() - 1) / 2];
+        summary.costP99Ns = costs[(costs.size() - 1) * 99 / 100];
+        summary.costMaxNs = costs.back();
+    }
+    return summary;
+}
+
+} // namespace potato_bonemeal_blocker
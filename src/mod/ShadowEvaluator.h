@@ -0,0 +1,151 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace potato_bonemeal_blocker {
+
+/**
+ * @brief Dry-run evaluation of a candidate rule set next to the live rules
+ *
+ * One interaction in every sample interval (a power of two) is judged again
+ * by the live rules and by the candidate rules compiled into
+ * RuleSnapshot::shadow. The candidate never cancels anything: both decisions
+ * and the candidate's evaluation time go into a fixed ring of RING_SIZE
+ * samples, summarized on demand by /potatoblocker shadow.
+ *
+ * The cost is bounded by Settings::maxOverhead. A sampled event also times
+ * the live handler, which stands for the handler time of the unsampled events
+ * in its interval. After every ADAPT_SAMPLES samples the interval is set to
+ * the smallest power of two, no smaller than Settings::sampleInterval, that
+ * keeps the shadow work of that window under the allowed share of handler time.
+ *
+ * Only touched from the server thread.
+ */
+class ShadowEvaluator {
+public:
+    /// Samples kept for the summary
+    static constexpr std::size_t RING_SIZE = 1024;
+
+    /// Largest sample interval, configured or adapted
+    static constexpr std::uint32_t MAX_SAMPLE_INTERVAL = 65536;
+
+    /// Samples between two adjustments of the sample interval
+    static constexpr std::uint32_t ADAPT_SAMPLES = 64;
+
+    /**
+     * @brief Sampling and overhead bound
+     */
+    struct Settings {
+        bool          enabled        = false;
+        std::uint32_t sampleInterval = 16;   ///< Evaluate at most every Nth event, rounded up to a power of two
+        double        maxOverhead    = 0.02; ///< Share of handler time the shadow work may take (0..1]
+
+        bool operator==(const Settings&) const = default;
+    };
+
+    /**
+     * @brief One interaction judged by both rule sets
+     */
+    struct Sample {
+        std::int64_t  timeMs    = 0; ///< Monotonic time of the event
+        std::uint32_t runtimeId = 0; ///< Runtime ID of the target block permutation
+        std::uint32_t costNs    = 0; ///< Time the candidate took to decide
+        std::int32_t  dimension = 0;
+        std::int32_t  x         = 0;
+        std::int32_t  y         = 0;
+        std::int32_t  z         = 0;
+        std::int16_t  itemId    = 0;
+        bool          live      = false; ///< The live rules block the attempt
+        bool          candidate = false; ///< The candidate rules would block it
+    };
+
+    /**
+     * @brief Counts since the last reset and the candidate's cost over the ring
+     */
+    struct Summary {
+        std::uint64_t       events        = 0; ///< Interactions seen by the handler
+        std::uint64_t       samples       = 0; ///< Interactions judged by both rule sets
+        std::uint64_t       skipped       = 0; ///< Sampled interactions without a block reference
+        std::uint64_t       agreed        = 0;
+        std::uint64_t       liveOnly      = 0; ///< Blocked by the live rules, allowed by the candidate
+        std::uint64_t       candidateOnly = 0; ///< Allowed by the live rules, blocked by the candidate
+        std::uint32_t       interval      = 0; ///< Current sample interval
+        double              overhead      = 0; ///< Shadow time over the estimated handler time
+        std::size_t         ringSamples   = 0; ///< Samples the cost quantiles are taken from
+        std::uint32_t       costP50Ns     = 0;
+        std::uint32_t       costP99Ns     = 0;
+        std::uint32_t       costMaxNs     = 0;
+        std::vector<Sample> disagreements; ///< Newest first
+    };
+
+    /**
+     * @brief Replace the settings; changed settings restart the counts and the ring
+     * @param settings The new settings
+     */
+    void configure(const Settings& settings) noexcept;
+
+    /**
+     * @brief Drop all samples and counts, e.g. when the candidate rules change
+     */
+    void reset() noexcept;
+
+    [[nodiscard]] bool            isEnabled() const noexcept { return mSettings.enabled; }
+    [[nodiscard]] const Settings& getSettings() const noexcept { return mSettings; }
+    [[nodiscard]] std::uint32_t   getInterval() const noexcept { return mMask + 1; }
+
+    /**
+     * @brief Count an interaction and decide whether it is evaluated in shadow mode
+     * @return true once per sample interval
+     */
+    [[nodiscard]] bool shouldSample() noexcept { return (++mEvents & mMask) == 0; }
+
+    /**
+     * @brief Store a sample judged by both rule sets
+     * @param sample The decisions and the candidate's cost
+     * @param handlerNs Time the live handler took on the sampled event
+     * @param shadowNs Time the shadow evaluation took, timing included
+     */
+    void record(const Sample& sample, std::uint64_t handlerNs, std::uint64_t shadowNs) noexcept;
+
+    /**
+     * @brief Count a sampled interaction the candidate could not judge
+     * @param handlerNs Time the live handler took on the sampled event
+     * @param shadowNs Time spent finding out
+     */
+    void skip(std::uint64_t handlerNs, std::uint64_t shadowNs) noexcept;
+
+    /**
+     * @brief Summarize the samples
+     * @param limit Most disagreements to include
+     * @return The summary
+     */
+    [[nodiscard]] Summary summarize(std::size_t limit) const;
+
+private:
+    /**
+     * @brief Add a sampled event's times to the overhead estimate and adjust the interval after a full window
+     */
+    void account(std::uint64_t handlerNs, std::uint64_t shadowNs) noexcept;
+
+    Settings                      mSettings;
+    std::uint32_t                 mMask            = 15; ///< Sample interval minus one
+    std::uint32_t                 mMinMask         = 15; ///< Configured sample interval minus one
+    std::uint64_t                 mEvents          = 0;
+    std::uint64_t                 mSamples         = 0;
+    std::uint64_t                 mSkipped         = 0;
+    std::uint64_t                 mLiveOnly        = 0;
+    std::uint64_t                 mCandidateOnly   = 0;
+    std::uint64_t                 mShadowNs        = 0; ///< Total shadow time
+    std::uint64_t                 mHandlerNs       = 0; ///< Estimated total handler time
+    std::uint64_t                 mWindowShadowNs  = 0;
+    std::uint64_t                 mWindowHandlerNs = 0;
+    std::uint32_t                 mWindowSamples   = 0;
+    std::array<Sample, RING_SIZE> mRing{};
+    std::size_t                   mNext   = 0;
+    std::size_t                   mFilled = 0;
+};
+
+} // namespace potato_bonemeal_blocker
@@ -0,0 +1,125 @@
+#include "mod/SharedMemory.h"
+
+#include <algorithm>
+#include <cstdint>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace potato_bonemeal_blocker {
+
+namespace {
+
+#if !defined(_WIN32)
+std::string posixName(std::string_view name) { return "/" + std::string(name); }
+#endif
+
+} // namespace
+
+bool SharedMemory::isValidName(std::string_view name) noexcept {
+    return !name.empty() && name.size() <= 64 && std::all_of(name.begin(), name.end(), [](char c) {
+        return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '-' || c == '_';
+    });
+}
+
+bool SharedMemory::open(std::string_view name, std::size_t size, std::string& error) noexcept {
+    close();
+    try {
+        if (!isValidName(name)) {
+            error = "invalid segment name";
+            return false;
+        }
+
+#if defined(_WIN32)
+        const auto   wideName = L"Local\\" + std::wstring(name.begin(), name.end());
+        const HANDLE mapping  = CreateFileMappingW(
+            INVALID_HANDLE_VALUE,
+            nullptr,
+            PAGE_READWRITE,
+            static_cast<DWORD>(static_cast<std::uint64_t>(size) >> 32),
+            static_cast<DWORD>(size),
+            wideName.c_str()
+        );
+        if (mapping == nullptr) {
+            error = "CreateFileMapping failed with error " + std::to_string(GetLastError());
+            return false;
+        }
+
+        // An existing mapping keeps its size; a view larger than it fails here
+        void* view = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, size);
+        if (view == nullptr) {
+            error = "MapViewOfFile failed with error " + std::to_string(GetLastError());
+            CloseHandle(mapping);
+            return false;
+        }
+        mHandle = mapping;
+        mData   = view;
+        mSize   = size;
+#else
+        const int fd = ::shm_open(posixName(name).c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+        if (fd < 0) {
+            error = std::string("shm_open failed: ") + std::strerror(errno);
+            return false;
+        }
+
+        // Growing is idempotent, so processes racing to create the segment all succeed
+        struct stat info{};
+        if (::fstat(fd, &info) != 0
+            || (static_cast<std::size_t>(info.st_size) < size && ::ftruncate(fd, static_cast<off_t>(size)) != 0)) {
+            error = std::string("cannot size the segment: ") + std::strerror(errno);
+            ::close(fd);
+            return false;
+        }
+        void* view = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (view == MAP_FAILED) {
+            error = std::string("mmap failed: ") + std::strerror(errno);
+            return false;
+        }
+        mData = view;
+        mSize = size;
+#endif
+        return true;
+    } catch (const std::exception& e) {
+        error = e.what();
+        return false;
+    }
+}
+
+void SharedMemory::close() noexcept {
+    if (mData != nullptr) {
+#if defined(_WIN32)
+        UnmapViewOfFile(mData);
+        CloseHandle(mHandle);
+#else
+        ::munmap(mData, mSize);
+#endif
+    }
+    mData   = nullptr;
+    mSize   = 0;
+    mHandle = nullptr;
+}
+
+void SharedMemory::remove(std::string_view name) noexcept {
+#if !defined(_WIN32)
+    try {
+        if (isValidName(name)) {
+            ::shm_unlink(posixName(name).c_str());
+        }
+    } catch (...) {
+        // Nothing to remove
+    }
+#else
+    (void)name;
+#endif
+}
+
+} // namespace potato_bonemeal_blocker
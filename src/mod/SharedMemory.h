@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace potato_bonemeal_blocker {
+
+/**
+ * @brief Named read-write memory shared by every process on the host that opens the same name
+ *
+ * Uses a pagefile-backed CreateFileMapping in the Local\ namespace on Windows
+ * and shm_open elsewhere. New segments are zero-filled; whoever opens a name
+ * first creates it, everyone else maps the existing one. The creator is not
+ * told apart, so the contents must carry their own initialization protocol.
+ *
+ * On Windows the segment disappears with the last handle; POSIX segments stay
+ * in /dev/shm until remove() is called.
+ */
+class SharedMemory {
+public:
+    SharedMemory() = default;
+    ~SharedMemory() { close(); }
+
+    SharedMemory(const SharedMemory&)            = delete;
+    SharedMemory& operator=(const SharedMemory&) = delete;
+
+    /**
+     * @brief Map a named segment, creating it if it does not exist yet
+     * @param name Segment name: letters, digits, '-' and '_'
+     * @param size Size of the segment; an existing segment must be at least this large
+     * @param error Receives a description of the problem on failure
+     * @return true if the segment is mapped
+     */
+    bool open(std::string_view name, std::size_t size, std::string& error) noexcept;
+
+    /**
+     * @brief Unmap the segment; it stays available to other processes
+     */
+    void close() noexcept;
+
+    /**
+     * @brief Delete a named segment so the next open() creates a fresh one
+     *
+     * Processes that still map it keep their mapping. No-op on Windows.
+     *
+     * @param name Segment name
+     */
+    static void remove(std::string_view name) noexcept;
+
+    /**
+     * @brief Check whether a name can be used for a segment
+     * @param name Segment name
+     * @return true for 1 to 64 letters, digits, '-' and '_'
+     */
+    [[nodiscard]] static bool isValidName(std::string_view name) noexcept;
+
+    [[nodiscard]] bool        isOpen() const noexcept { return mData != nullptr; }
+    [[nodiscard]] void*       data() const noexcept { return mData; }
+    [[nodiscard]] std::size_t size() const noexcept { return mSize; }
+
+private:
+    void*       mData   = nullptr;
+    std::size_t mSize   = 0;
+    void*       mHandle = nullptr; ///< File mapping handle on Windows
+};
+
+} // namespace potato_bonemeal_blocker
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace potato_bonemeal_blocker {
+
+/**
+ * @brief Publishes immutable snapshots to lock-free readers, RCU style
+ *
+ * Readers take the current snapshot with one acquire load and use it without
+ * any lock or reference count. A writer publishes a replacement with one
+ * release store and retires the old snapshot instead of deleting it.
+ *
+ * Reclamation is quiescent-state based: every reader runs on the server thread
+ * and never keeps a snapshot pointer past the event or task it is handling, so
+ * once the server tick a snapshot was retired in has finished, no reader can
+ * still hold it. reclaim() is called from a later tick with that tick number.
+ *
+ * publish() and reclaim() must be called from the server thread.
+ *
+ * @tparam T The snapshot type
+ */
+template <typename T>
+class SnapshotCell {
+public:
+    SnapshotCell() = default;
+    ~SnapshotCell() { reset(); }
+
+    SnapshotCell(const SnapshotCell&)            = delete;
+    SnapshotCell& operator=(const SnapshotCell&) = delete;
+
+    /**
+     * @brief Get the current snapshot
+     * @return The snapshot, or nullptr if none is published; valid until the end of the current tick
+     */
+    [[nodiscard]] const T* load() const noexcept { return mCurrent.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Replace the current snapshot
+     * @param snapshot The new snapshot, may be nullptr
+     * @param tick The current server tick; the old snapshot is freed by a reclaim() after it
+     */
+    void publish(std::unique_ptr<const T> snapshot, std::uint64_t tick) {
+        // Reserve first so retiring the old snapshot cannot fail after the swap
+        mRetired.reserve(mRetired.size() + 1);
+        const auto* previous = mCurrent.exchange(snapshot.release(), std::memory_order_acq_rel);
+        if (previous) {
+            mRetired.push_back(Retired{std::unique_ptr<const T>(previous), tick});
+        }
+        ++mGeneration;
+    }
+
+    /**
+     * @brief Free snapshots retired before the given tick
+     * @param tick The current server tick
+     * @return Number of snapshots freed
+     */
+    std::size_t reclaim(std::uint64_t tick) noexcept {
+        const auto before = mRetired.size();
+        std::erase_if(mRetired, [tick](const Retired& retired) { return retired.tick < tick; });
+        return before - mRetired.size();
+    }
+
+    /**
+     * @brief Unpublish and free everything; only safe once no reader can run
+     */
+    void reset() noexcept {
+        delete mCurrent.exchange(nullptr, std::memory_order_acq_rel);
+        mRetired.clear();
+    }
+
+    /**
+     * @brief Get the number of snapshots published so far
+     * @return Publication count
+     */
+    [[nodiscard]] std::uint64_t getGeneration() const noexcept { return mGeneration; }
+
+    /**
+     * @brief Get the number of retired snapshots waiting for reclamation
+     * @return Retired snapshot count
+     */
+    [[nodiscard]] std::size_t getRetiredCount() const noexcept { return mRetired.size(); }
+
+private:
+    struct Retired {
+        std::unique_ptr<const T> snapshot;
+        std::uint64_t            tick = 0; ///< Server tick the snapshot was replaced in
+    };
+
+    std::atomic<const T*> mCurrent{nullptr};
+    std::vector<Retired>  mRetired;
+    std::uint64_t         mGeneration = 0;
+};
+
+} // namespace potato_bonemeal_blocker
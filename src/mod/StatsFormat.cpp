@@ -0,0 +1,80 @@
+#include "mod/StatsFormat.h"
+
+#include <algorithm>
+#include <cstring>
+#include <unordered_map>
+
+namespace potato_bonemeal_blocker {
+
+bool StatsReader::open(const std::filesystem::path& path) {
+    mRecords = {};
+    mError.clear();
+
+    if (!mFile.open(path)) {
+        mError = "cannot open " + path.string();
+        return false;
+    }
+
+    const auto bytes = mFile.data();
+    if (bytes.size() < sizeof(StatsHeader)) {
+        mError = "file is too short for a statistics header";
+        return false;
+    }
+    std::memcpy(&mHeader, bytes.data(), sizeof(StatsHeader));
+
+    if (mHeader.magic != StatsHeader::MAGIC) {
+        mError = "not a statistics file";
+        return false;
+    }
+    if (mHeader.version > StatsHeader::VERSION) {
+        mError = "unsupported statistics version " + std::to_string(mHeader.version);
+        return false;
+    }
+    if (mHeader.recordSize != sizeof(StatsRecord) || mHeader.headerSize < sizeof(StatsHeader)
+        || mHeader.headerSize % alignof(StatsRecord) != 0 || mHeader.headerSize > bytes.size()) {
+        mError = "unexpected header or record size";
+        return false;
+    }
+
+    const auto payload = bytes.subspan(mHeader.headerSize);
+    mRecords = {reinterpret_cast<const StatsRecord*>(payload.data()), payload.size() / sizeof(StatsRecord)};
+    return true;
+}
+
+std::vector<StatsTotal>
+StatsReader::top(StatsKind kind, std::uint32_t sinceHour, std::size_t limit, std::uint32_t lagHours) const {
+    // Every record before one of hour h was written by the end of hour h + 1 + lagHours, so its hour is no later
+    std::unordered_map<std::int64_t, std::uint64_t> sums;
+    for (auto it = mRecords.rbegin(); it != mRecords.rend(); ++it) {
+        if (std::uint64_t{it->hour} + 1 + lagHours < sinceHour) {
+            break;
+        }
+        if (it->kind == kind && it->hour >= sinceHour) {
+            sums[it->key] += it->count;
+        }
+    }
+
+    std::vector<StatsTotal> totals;
+    totals.reserve(sums.size());
+    for (const auto& [key, count] : sums) {
+        totals.push_back(StatsTotal{key, count});
+    }
+    const auto kept = std::min(limit, totals.size());
+    std::partial_sort(totals.begin(), totals.begin() + kept, totals.end(), [](const auto& a, const auto& b) {
+        return a.count > b.count || (a.count == b.count && a.key < b.key);
+    });
+    totals.resize(kept);
+    return totals;
+}
+
+std::uint64_t StatsReader::total(StatsKind kind) const noexcept {
+    std::uint64_t sum = 0;
+    for (const auto& record : mRecords) {
+        if (record.kind == kind) {
+            sum += record.count;
+        }
+    }
+    return sum;
+}
+
+} // namespace potato_bonemeal_blocker
@@ -0,0 +1,175 @@
+#pragma once
+
+#include "MappedFile.h"
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace potato_bonemeal_blocker {
+
+/**
+ * Blocked-attempt statistics format, version 1
+ *
+ * A statistics file is a StatsHeader followed by densely packed StatsRecords,
+ * little-endian and naturally aligned like interaction traces, so queries can
+ * read the records in place from a memory mapping.
+ *
+ * The file is append-only. Every record carries the attempts counted for one
+ * player or chunk within one hour since the previous record for that key and
+ * hour, so totals are the sums over all matching records.
+ */
+
+static_assert(std::endian::native == std::endian::little, "Statistics files use native little-endian layout");
+
+/**
+ * @brief What a statistics record is keyed by
+ */
+enum class StatsKind : std::uint8_t {
+    PLAYER, // Actor unique ID of the player
+    CHUNK   // Chunk column, packed by packChunkKey()
+};
+
+/**
+ * @brief Fixed file header
+ */
+struct StatsHeader {
+    static constexpr std::array<char, 8> MAGIC   = {'P', 'B', 'B', 'S', 'T', 'A', 'T', 'S'};
+    static constexpr std::uint16_t       VERSION = 1;
+
+    std::array<char, 8> magic          = MAGIC;
+    std::uint16_t       version        = VERSION;
+    std::uint16_t       headerSize     = 0;
+    std::uint16_t       recordSize     = 0;
+    std::uint16_t       reserved       = 0;
+    std::int64_t        createdEpochMs = 0; ///< Wall-clock time the file was created
+    std::uint64_t       reserved2      = 0;
+};
+
+/**
+ * @brief Blocked attempts of one key within one hour
+ */
+struct StatsRecord {
+    std::int64_t  key         = 0; ///< Player unique ID or packed chunk key
+    std::int64_t  lastEpochMs = 0; ///< Wall-clock time of the latest counted attempt
+    std::uint32_t hour        = 0; ///< Hours since the Unix epoch
+    std::uint32_t count       = 0; ///< Attempts counted since the previous record for this key and hour
+    StatsKind     kind        = StatsKind::PLAYER;
+    std::uint8_t  reserved[7] = {};
+};
+
+static_assert(sizeof(StatsHeader) == 32 && std::is_trivially_copyable_v<StatsHeader>);
+static_assert(sizeof(StatsRecord) == 32 && std::is_trivially_copyable_v<StatsRecord>);
+
+/**
+ * @brief Pack a chunk column into a statistics key
+ * @return 8 bits dimension, 24 bits per chunk coordinate; never negative
+ */
+[[nodiscard]] constexpr std::int64_t packChunkKey(int dimension, int chunkX, int chunkZ) noexcept {
+    return static_cast<std::int64_t>(
+        (static_cast<std::uint64_t>(dimension & 0xFF) << 48)
+        | (static_cast<std::uint64_t>(static_cast<std::uint32_t>(chunkX) & 0xFFFFFF) << 24)
+        | static_cast<std::uint64_t>(static_cast<std::uint32_t>(chunkZ) & 0xFFFFFF)
+    );
+}
+
+[[nodiscard]] constexpr int chunkKeyDimension(std::int64_t key) noexcept {
+    return static_cast<int>((key >> 48) & 0xFF);
+}
+
+[[nodiscard]] constexpr int chunkKeyX(std::int64_t key) noexcept {
+    // Sign-extend the 24-bit coordinate
+    return static_cast<int>(static_cast<std::uint32_t>((key >> 24) & 0xFFFFFF) << 8) >> 8;
+}
+
+[[nodiscard]] constexpr int chunkKeyZ(std::int64_t key) noexcept {
+    return static_cast<int>(static_cast<std::uint32_t>(key & 0xFFFFFF) << 8) >> 8;
+}
+
+/**
+ * @brief Hours since the Unix epoch, the time bucket of statistics records
+ * @param epochMs Wall-clock milliseconds
+ */
+[[nodiscard]] constexpr std::uint32_t epochHour(std::int64_t epochMs) noexcept {
+    return static_cast<std::uint32_t>(epochMs / 3'600'000);
+}
+
+/**
+ * @brief Summed attempts of one key
+ */
+struct StatsTotal {
+    std::int64_t  key   = 0;
+    std::uint64_t count = 0;
+
+    bool operator==(const StatsTotal&) const = default;
+};
+
+/**
+ * @brief Zero-copy reader for statistics files
+ */
+class StatsReader {
+public:
+    /**
+     * @brief Map and validate a statistics file
+     * @param path The statistics file
+     * @return true on success; getError() describes failures
+     */
+    bool open(const std::filesystem::path& path);
+
+    /**
+     * @brief Get the validated header
+     * @return The file header
+     */
+    [[nodiscard]] const StatsHeader& getHeader() const noexcept { return mHeader; }
+
+    /**
+     * @brief Get the records, read in place from the mapping
+     * @return All whole records in the file
+     */
+    [[nodiscard]] std::span<const StatsRecord> getRecords() const noexcept { return mRecords; }
+
+    /**
+     * @brief Get the reason the last open() failed
+     * @return Error description, empty after a successful open()
+     */
+    [[nodiscard]] std::string_view getError() const noexcept { return mError; }
+
+    /**
+     * @brief Sum the attempts of every key of one kind
+     *
+     * Records are appended in flush order, so a record is written at most
+     * `lagHours` after the end of its hour. The scan walks back from the end of
+     * the file and stops at the first record old enough that nothing before it
+     * can be of `sinceHour` or later, so its cost follows the window, not the
+     * file size.
+     *
+     * @param kind Players or chunks
+     * @param sinceHour Only records of this hour or later are counted
+     * @param limit Maximum number of keys returned
+     * @param lagHours Hours a record may be written after its hour ended, e.g. the flush interval rounded up
+     * @return The keys with the most attempts, highest first
+     */
+    [[nodiscard]] std::vector<StatsTotal>
+    top(StatsKind kind, std::uint32_t sinceHour, std::size_t limit, std::uint32_t lagHours = 1) const;
+
+    /**
+     * @brief Sum the attempts of all records of one kind
+     * @param kind Players or chunks; every attempt is counted once per kind
+     * @return Total attempts in the file
+     */
+    [[nodiscard]] std::uint64_t total(StatsKind kind) const noexcept;
+
+private:
+    MappedFile                   mFile;
+    StatsHeader                  mHeader;
+    std::span<const StatsRecord> mRecords;
+    std::string                  mError;
+};
+
+} // namespace potato_bonemeal_blocker
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <charconv>
+#include <cstdint>
+#include <initializer_list>
+#include <string_view>
+#include <type_traits>
+
+namespace potato_bonemeal_blocker {
+
+/**
+ * @brief One argument for appendFormatted(): either text or an integer
+ */
+class FormatArg {
+public:
+    FormatArg(std::string_view text) noexcept : mText(text) {} // NOLINT(google-explicit-constructor)
+    FormatArg(const char* text) noexcept : mText(text) {}      // NOLINT(google-explicit-constructor)
+
+    template <class T>
+        requires std::is_integral_v<T>
+    FormatArg(T value) noexcept // NOLINT(google-explicit-constructor)
+    : mIsInteger(true),
+      mInteger(static_cast<std::int64_t>(value)) {}
+
+    /**
+     * @brief Append the argument's text to an output buffer
+     * @param out Any container with append(const char*, size_t)
+     */
+    template <class Out>
+    void appendTo(Out& out) const {
+        if (!mIsInteger) {
+            out.append(mText.data(), mText.size());
+            return;
+        }
+        char buffer[24];
+        const auto result = std::to_chars(buffer, buffer + sizeof(buffer), mInteger);
+        out.append(buffer, static_cast<std::size_t>(result.ptr - buffer));
+    }
+
+private:
+    std::string_view mText;
+    bool             mIsInteger = false;
+    std::int64_t     mInteger   = 0;
+};
+
+/**
+ * @brief Substitute `{}` placeholders of a runtime pattern, e.g. a localized message
+ *
+ * Unlike std::format the pattern does not need to be known at compile time,
+ * and no intermediate strings are built. Surplus placeholders are kept verbatim.
+ *
+ * @param out Any container with append(const char*, size_t)
+ * @param pattern Pattern containing `{}` placeholders
+ * @param args Arguments substituted in order
+ */
+template <class Out>
+void appendFormatted(Out& out, std::string_view pattern, std::initializer_list<FormatArg> args) {
+    auto arg = args.begin();
+    while (!pattern.empty()) {
+        const auto placeholder = pattern.find("{}");
+        if (placeholder == std::string_view::npos || arg == args.end()) {
+            out.append(pattern.data(), pattern.size());
+            return;
+        }
+        out.append(pattern.data(), placeholder);
+        (arg++)->appendTo(out);
+        pattern.remove_prefix(placeholder + 2);
+    }
+}
+
+} // namespace potato_bonemeal_blocker
@@ -0,0 +1,48 @@
+#include "mod/TimerWheel.h"
+
+#include <algorithm>
+
+namespace potato_bonemeal_blocker {
+
+void TimerWheel::reset(std::uint64_t now) noexcept {
+    for (auto& level : mSlots) {
+        for (auto& slot : level) {
+            slot.clear();
+        }
+    }
+    mNow     = now;
+    mPending = 0;
+}
+
+void TimerWheel::schedule(std::uint64_t due, std::uint32_t id) {
+    // Overdue timers fire on the next unit
+    place(Timer{std::max(due, mNow + 1), id});
+    ++mPending;
+}
+
+void TimerWheel::place(const Timer& timer) {
+    // Timers beyond the wheel wait in the top level; a cascaded timer due now lands in the slot about to fire
+    const auto delay = std::min(timer.due - mNow, MAX_DELAY);
+    const auto slot  = mNow + delay;
+    for (unsigned level = 0; level < LEVELS; ++level) {
+        if (delay < (std::uint64_t{1} << (SLOT_BITS * (level + 1))) || level == LEVELS - 1) {
+            mSlots[level][(slot >> (SLOT_BITS * level)) & (SLOTS - 1)].push_back(timer);
+            return;
+        }
+    }
+}
+
+void TimerWheel::cascade() {
+    for (unsigned level = 1; level < LEVELS; ++level) {
+        // A level only moves on when every level below it has wrapped
+        if ((mNow & ((std::uint64_t{1} << (SLOT_BITS * level)) - 1)) != 0) {
+            return;
+        }
+        auto timers = std::exchange(mSlots[level][(mNow >> (SLOT_BITS * level)) & (SLOTS - 1)], {});
+        for (const auto& timer : timers) {
+            place(timer);
+        }
+    }
+}
+
+} // namespace potato_bonemeal_blocker
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace potato_bonemeal_blocker {
+
+/**
+ * @brief Hierarchical timer wheel over an abstract integer clock
+ *
+ * Four levels of 64 slots. Level 0 holds timers due within the next 64 units,
+ * one slot per unit; each higher level covers 64 times the span of the one
+ * below. Advancing by one unit fires one level-0 slot, and whenever a level
+ * wraps, the next slot of the level above is redistributed into the lower
+ * ones. Scheduling and advancing are O(1) however many timers are pending.
+ *
+ * Timers further out than MAX_DELAY are parked in the top level and re-placed
+ * when it cascades. Timers carry a caller-defined ID; there is no cancellation,
+ * callers reset() the wheel and schedule again instead.
+ */
+class TimerWheel {
+public:
+    static constexpr unsigned      SLOT_BITS = 6;
+    static constexpr std::size_t   SLOTS     = std::size_t{1} << SLOT_BITS;
+    static constexpr unsigned      LEVELS    = 4;
+    static constexpr std::uint64_t MAX_DELAY = (std::uint64_t{1} << (SLOT_BITS * LEVELS)) - 1;
+
+    /**
+     * @brief Drop every timer and set the current time
+     * @param now Current time
+     */
+    void reset(std::uint64_t now) noexcept;
+
+    /**
+     * @brief Add a timer
+     * @param due Time the timer fires at; a time already passed fires on the next advance()
+     * @param id Passed to the fire callback
+     */
+    void schedule(std::uint64_t due, std::uint32_t id);
+
+    /**
+     * @brief Move the current time forward, firing every timer due up to it
+     * @param now New current time; an earlier time is ignored
+     * @param fire Called with the ID of each due timer; may schedule new timers
+     */
+    template <typename Fire>
+    void advance(std::uint64_t now, Fire&& fire) {
+        while (mNow < now) {
+            if (mPending == 0) {
+                mNow = now;
+                return;
+            }
+            ++mNow;
+            cascade();
+
+            auto due = std::exchange(mSlots[0][mNow & (SLOTS - 1)], {});
+            mPending -= due.size();
+            for (const auto& timer : due) {
+                fire(timer.id);
+            }
+        }
+    }
+
+    [[nodiscard]] std::uint64_t getTime() const noexcept { return mNow; }
+    [[nodiscard]] std::size_t   getPending() const noexcept { return mPending; }
+
+private:
+    struct Timer {
+        std::uint64_t due;
+        std::uint32_t id;
+    };
+
+    /**
+     * @brief Put a timer into the slot for its distance from the current time
+     * @param timer The timer, due no earlier than the current time
+     */
+    void place(const Timer& timer);
+
+    /**
+     * @brief Redistribute the slots of every level that wrapped at the current time
+     */
+    void cascade();
+
+    std::array<std::array<std::vector<Timer>, SLOTS>, LEVELS> mSlots;
+    std::uint64_t                                            mNow     = 0;
+    std::size_t                                              mPending = 0;
+};
+
+} // namespace potato_bonemeal_blocker
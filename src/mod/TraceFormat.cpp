@@ -0,0 +1,112 @@
+#include "mod/TraceFormat.h"
+
+#include <charconv>
+#include <cstring>
+#include <fstream>
+
+namespace potato_bonemeal_blocker {
+
+namespace {
+
+/**
+ * @brief Split off the next space-separated field
+ */
+std::string_view nextField(std::string_view& line) noexcept {
+    const auto end   = line.find(' ');
+    const auto field = line.substr(0, end);
+    line.remove_prefix(end == std::string_view::npos ? line.size() : end + 1);
+    return field;
+}
+
+template <class T>
+std::optional<T> parseNumber(std::string_view text) noexcept {
+    T    value{};
+    auto result = std::from_chars(text.data(), text.data() + text.size(), value);
+    if (result.ec != std::errc{} || result.ptr != text.data() + text.size()) {
+        return std::nullopt;
+    }
+    return value;
+}
+
+} // namespace
+
+bool TraceReader::open(const std::filesystem::path& path) {
+    mRecords = {};
+    mError.clear();
+
+    if (!mFile.open(path)) {
+        mError = "cannot open " + path.string();
+        return false;
+    }
+
+    const auto bytes = mFile.data();
+    if (bytes.size() < sizeof(TraceHeader)) {
+        mError = "file is too short for a trace header";
+        return false;
+    }
+    std::memcpy(&mHeader, bytes.data(), sizeof(TraceHeader));
+
+    if (mHeader.magic != TraceHeader::MAGIC) {
+        mError = "not a trace file";
+        return false;
+    }
+    if (mHeader.version > TraceHeader::VERSION) {
+        mError = "unsupported trace version " + std::to_string(mHeader.version);
+        return false;
+    }
+    if (mHeader.recordSize != sizeof(TraceRecord) || mHeader.headerSize < sizeof(TraceHeader)
+        || mHeader.headerSize % alignof(TraceRecord) != 0 || mHeader.headerSize > bytes.size()) {
+        mError = "unexpected header or record size";
+        return false;
+    }
+
+    // Mappings are page aligned, so records after an aligned header can be used in place
+    const auto payload = bytes.subspan(mHeader.headerSize);
+    mRecords = {reinterpret_cast<const TraceRecord*>(payload.data()), payload.size() / sizeof(TraceRecord)};
+    return true;
+}
+
+bool TracePalette::load(const std::filesystem::path& path) {
+    std::ifstream file(path);
+    if (!file) {
+        return false;
+    }
+
+    mItems.clear();
+    mBlocks.clear();
+
+    std::string buffer;
+    while (std::getline(file, buffer)) {
+        std::string_view line = buffer;
+        if (!line.empty() && line.back() == '\r') {
+            line.remove_suffix(1);
+        }
+
+        const auto kind = nextField(line);
+        if (kind == "item") {
+            const auto id = parseNumber<std::int16_t>(nextField(line));
+            if (id && !line.empty()) {
+                mItems.emplace(std::string(line), *id);
+            }
+        } else if (kind == "block") {
+            const auto runtimeId = parseNumber<std::uint32_t>(nextField(line));
+            const auto stage     = parseNumber<unsigned>(nextField(line));
+            if (runtimeId && stage && *stage != UNKNOWN_GROWTH_STAGE && !line.empty()) {
+                mBlocks.emplace(std::make_pair(std::string(line), static_cast<std::uint8_t>(*stage)), *runtimeId);
+            }
+        }
+    }
+    return true;
+}
+
+std::optional<std::int16_t> TracePalette::findItem(std::string_view name) const {
+    const auto it = mItems.find(std::string(name));
+    return it == mItems.end() ? std::nullopt : std::optional<std::int16_t>(it->second);
+}
+
+std::optional<std::uint32_t> TracePalette::findBlock(std::string_view name, std::uint8_t growthStage) const {
+    const auto it = mBlocks.find(std::make_pair(std::string(name), growthStage));
+    return it == mBlocks.end() ? std::nullopt : std::optional<std::uint32_t>(it->second);
+}
+
+} // namespace potato_bonemeal_blocker
@@ -0,0 +1,176 @@
+#pragma once
+
+#include "MappedFile.h"
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+
+namespace potato_bonemeal_blocker {
+
+/**
+ * Interaction trace format, version 1
+ *
+ * A trace is a TraceHeader followed by densely packed TraceRecords, all
+ * little-endian and naturally aligned so the record array can be used in
+ * place from a memory mapping. The record count is derived from the file
+ * size, so a trace cut short by a crash stays readable up to the last whole
+ * record.
+ *
+ * Records store numeric item and block runtime IDs only. The names behind
+ * them are written once per ID to a text palette next to the trace
+ * (`<trace>.palette`), which lets offline tools compile rule sets against
+ * the IDs of the server that recorded the trace.
+ */
+
+static_assert(std::endian::native == std::endian::little, "Trace files are written in native little-endian layout");
+
+/**
+ * @brief What the handler did with a recorded interaction
+ */
+enum class TraceDecision : std::uint8_t {
+    IGNORED, // Held item is not covered by any rule
+    ALLOWED, // Item is covered but the target block is not protected
+    BLOCKED  // Event was cancelled
+};
+
+/**
+ * @brief Fixed file header
+ */
+struct TraceHeader {
+    static constexpr std::array<char, 8> MAGIC   = {'P', 'B', 'B', 'T', 'R', 'A', 'C', 'E'};
+    static constexpr std::uint16_t       VERSION = 1;
+
+    std::array<char, 8> magic        = MAGIC;
+    std::uint16_t       version      = VERSION;
+    std::uint16_t       headerSize   = 0;
+    std::uint16_t       recordSize   = 0;
+    std::uint16_t       reserved     = 0;
+    std::int64_t        startEpochMs = 0; ///< Wall-clock time of the first record's zero offset
+    std::uint64_t       reserved2    = 0;
+};
+
+/**
+ * @brief One captured PlayerInteractBlockEvent
+ */
+struct TraceRecord {
+    /// Block runtime ID stored when the handler did not look the block up
+    static constexpr std::uint32_t UNKNOWN_BLOCK = 0xFFFFFFFF;
+
+    std::uint32_t timeMs         = 0;             ///< Milliseconds since TraceHeader::startEpochMs
+    std::uint32_t blockRuntimeId = UNKNOWN_BLOCK; ///< Target block permutation
+    std::int64_t  playerId       = 0;             ///< Actor unique ID of the player
+    std::int32_t  x              = 0;
+    std::int32_t  y              = 0;
+    std::int32_t  z              = 0;
+    std::int16_t  itemId         = 0; ///< Numeric ID of the held item
+    std::int8_t   dimension      = 0;
+    TraceDecision decision       = TraceDecision::IGNORED;
+};
+
+static_assert(sizeof(TraceHeader) == 32 && std::is_trivially_copyable_v<TraceHeader>);
+static_assert(sizeof(TraceRecord) == 32 && std::is_trivially_copyable_v<TraceRecord>);
+
+/// Growth stage written to the palette for block permutations without a legacy data value
+inline constexpr std::uint8_t UNKNOWN_GROWTH_STAGE = 0xFF;
+
+/**
+ * @brief Get the palette path belonging to a trace file
+ * @param tracePath Path of the trace
+ * @return `<tracePath>.palette`
+ */
+[[nodiscard]] inline std::filesystem::path palettePathFor(const std::filesystem::path& tracePath) {
+    auto path = tracePath;
+    path += ".palette";
+    return path;
+}
+
+/**
+ * @brief Zero-copy reader for trace files
+ */
+class TraceReader {
+public:
+    /**
+     * @brief Map and validate a trace file
+     * @param path The trace file
+     * @return true on success; getError() describes failures
+     */
+    bool open(const std::filesystem::path& path);
+
+    /**
+     * @brief Get the validated header
+     * @return The trace header
+     */
+    [[nodiscard]] const TraceHeader& getHeader() const noexcept { return mHeader; }
+
+    /**
+     * @brief Get the records, read in place from the mapping
+     * @return All whole records in the file
+     */
+    [[nodiscard]] std::span<const TraceRecord> getRecords() const noexcept { return mRecords; }
+
+    /**
+     * @brief Get the reason the last open() failed
+     * @return Error description, empty after a successful open()
+     */
+    [[nodiscard]] std::string_view getError() const noexcept { return mError; }
+
+private:
+    MappedFile                   mFile;
+    TraceHeader                  mHeader;
+    std::span<const TraceRecord> mRecords;
+    std::string                  mError;
+};
+
+/**
+ * @brief Item and block names recorded alongside a trace
+ *
+ * The palette is a text file with one entry per line:
+ * - `item <id> <name>`
+ * - `block <runtimeId> <growthStage> <name>`
+ */
+class TracePalette {
+public:
+    /**
+     * @brief Load a palette file, replacing the current entries
+     * @param path The palette file
+     * @return true if the file could be read
+     */
+    bool load(const std::filesystem::path& path);
+
+    /**
+     * @brief Look up the recorded ID of an item
+     * @param name The namespaced item name
+     * @return The item ID, or std::nullopt if the trace never saw the item
+     */
+    [[nodiscard]] std::optional<std::int16_t> findItem(std::string_view name) const;
+
+    /**
+     * @brief Look up the recorded runtime ID of a block permutation
+     * @param name The namespaced block name
+     * @param growthStage The growth stage (legacy data value)
+     * @return The runtime ID, or std::nullopt if the trace never saw the permutation
+     */
+    [[nodiscard]] std::optional<std::uint32_t> findBlock(std::string_view name, std::uint8_t growthStage) const;
+
+    /**
+     * @brief Get the number of loaded entries
+     * @return Item and block entry count
+     */
+    [[nodiscard]] std::size_t size() const noexcept { return mItems.size() + mBlocks.size(); }
+
+private:
+    std::unordered_map<std::string, std::int16_t>              mItems;
+    std::map<std::pair<std::string, std::uint8_t>, std::uint32_t> mBlocks;
+};
+
+} // namespace potato_bonemeal_blocker
@@ -0,0 +1,172 @@
+#include "mod/TraceWriter.h"
+#include "mod/TextFormat.h"
+
+#include <algorithm>
+#include <fstream>
+
+namespace potato_bonemeal_blocker {
+
+bool TraceWriter::start(const std::filesystem::path& path) {
+    if (mCapturing) {
+        return false;
+    }
+
+    std::ofstream trace(path, std::ios::binary | std::ios::trunc);
+    std::ofstream palette(palettePathFor(path), std::ios::binary | std::ios::trunc);
+    if (!trace || !palette) {
+        return false;
+    }
+
+    TraceHeader header;
+    header.headerSize   = sizeof(TraceHeader);
+    header.recordSize   = sizeof(TraceRecord);
+    header.startEpochMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+                              std::chrono::system_clock::now().time_since_epoch()
+    )
+                              .count();
+    trace.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    trace.flush();
+    if (!trace) {
+        return false;
+    }
+
+    // Both record buffers are allocated up front; appends never reallocate
+    mActive.clear();
+    mActive.reserve(BUFFER_RECORDS);
+    mPending.clear();
+    mPending.reserve(BUFFER_RECORDS);
+    mActivePalette.clear();
+    mPendingPalette.clear();
+    std::fill(mSeenItems.begin(), mSeenItems.end(), 0);
+    mSeenBlocks.clear();
+    mPendingReady = false;
+    mStopping     = false;
+    mWritten.store(0, std::memory_order_relaxed);
+    mDropped.store(0, std::memory_order_relaxed);
+
+    mPath      = path;
+    mStartTime = std::chrono::steady_clock::now();
+    mThread    = std::thread([this, trace = std::move(trace), palette = std::move(palette)]() mutable {
+        run(trace, palette);
+    });
+    mCapturing = true;
+    return true;
+}
+
+void TraceWriter::stop() noexcept {
+    if (!mCapturing) {
+        return;
+    }
+    mCapturing = false;
+
+    {
+        // The last buffer is never dropped: wait for the writer to take the previous one
+        std::unique_lock lock(mMutex);
+        mCondition.wait(lock, [this] { return !mPendingReady; });
+        mActive.swap(mPending);
+        mActivePalette.swap(mPendingPalette);
+        mPendingReady = true;
+        mStopping     = true;
+    }
+    mCondition.notify_all();
+
+    if (mThread.joinable()) {
+        mThread.join();
+    }
+}
+
+void TraceWriter::addItemName(std::int16_t itemId, std::string_view name) {
+    const auto index = static_cast<std::uint16_t>(itemId);
+    mSeenItems[index >> 6] |= std::uint64_t{1} << (index & 63);
+    appendFormatted(mActivePalette, "item {} {}\n", {itemId, name});
+}
+
+void TraceWriter::addBlockName(std::uint32_t runtimeId, std::string_view name, std::uint8_t growthStage) {
+    const auto word = runtimeId >> 6;
+    if (word >= mSeenBlocks.size()) {
+        mSeenBlocks.resize(word + 1, 0);
+    }
+    mSeenBlocks[word] |= std::uint64_t{1} << (runtimeId & 63);
+    appendFormatted(mActivePalette, "block {} {} {}\n", {runtimeId, growthStage, name});
+}
+
+void TraceWriter::flush() noexcept {
+    if (!mCapturing || (mActive.empty() && mActivePalette.empty())) {
+        return;
+    }
+    // A partial buffer simply waits for the next flush if the writer is busy
+    tryHandOff();
+}
+
+bool TraceWriter::tryHandOff() noexcept {
+    {
+        const std::lock_guard lock(mMutex);
+        if (mPendingReady) {
+            return false;
+        }
+        mActive.swap(mPending);
+        mActivePalette.swap(mPendingPalette);
+        mPendingReady = true;
+    }
+    mCondition.notify_all();
+    return true;
+}
+
+void TraceWriter::handOff() noexcept {
+    if (tryHandOff()) {
+        return;
+    }
+
+    // The writer is still a full buffer behind: drop the records but keep the palette entries
+    mDropped.fetch_add(mActive.size(), std::memory_order_relaxed);
+    mActive.clear();
+    if (!mActivePalette.empty()) {
+        try {
+            const std::lock_guard lock(mMutex);
+            mPendingPalette += mActivePalette;
+            mActivePalette.clear();
+        } catch (...) {
+            // Kept in the active palette and handed off with the next buffer
+        }
+    }
+}
+
+void TraceWriter::run(std::ofstream& trace, std::ofstream& palette) noexcept {
+    std::vector<TraceRecord> records;
+    std::string              paletteText;
+    try {
+        records.reserve(BUFFER_RECORDS);
+    } catch (...) {
+        // The buffer then grows on demand
+    }
+
+    for (;;) {
+        bool stopping = false;
+        {
+            std::unique_lock lock(mMutex);
+            mCondition.wait(lock, [this] { return mPendingReady || mStopping; });
+            records.swap(mPending);
+            paletteText.swap(mPendingPalette);
+            mPendingReady = false;
+            stopping      = mStopping;
+        }
+        mCondition.notify_all();
+
+        palette.write(paletteText.data(), static_cast<std::streamsize>(paletteText.size()));
+        palette.flush();
+        trace.write(
+            reinterpret_cast<const char*>(records.data()),
+            static_cast<std::streamsize>(records.size() * sizeof(TraceRecord))
+        );
+        trace.flush();
+        (trace ? mWritten : mDropped).fetch_add(records.size(), std::memory_order_relaxed);
+
+        records.clear();
+        paletteText.clear();
+        if (stopping) {
+            break;
+        }
+    }
+}
+
+} // namespace potato_bonemeal_blocker
@@ -0,0 +1,158 @@
+#pragma once
+
+#include "TraceFormat.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <iosfwd>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace potato_bonemeal_blocker {
+
+/**
+ * @brief Captures interaction records into a trace file
+ *
+ * The game thread appends records to a preallocated buffer; full buffers
+ * (and partial ones on flush()) are swapped with a spare and written by a
+ * background thread, so capture costs one buffered append per event. If the
+ * writer thread falls a whole buffer behind, the newer buffer is dropped and
+ * counted rather than blocking the game thread.
+ *
+ * All methods except the counters must be called from the game thread.
+ */
+class TraceWriter {
+public:
+    /// Records per buffer handed to the writer thread
+    static constexpr std::size_t BUFFER_RECORDS = 4096;
+
+    TraceWriter() = default;
+    ~TraceWriter() { stop(); }
+
+    TraceWriter(const TraceWriter&)            = delete;
+    TraceWriter& operator=(const TraceWriter&) = delete;
+
+    /**
+     * @brief Create the trace file and start capturing
+     * @param path The trace file; its palette is written to palettePathFor(path)
+     * @return true if the file was created, false if it failed or a capture is running
+     */
+    bool start(const std::filesystem::path& path);
+
+    /**
+     * @brief Write all buffered records and close the trace
+     */
+    void stop() noexcept;
+
+    /**
+     * @brief Check whether a capture is running
+     * @return true between start() and stop()
+     */
+    [[nodiscard]] bool isCapturing() const noexcept { return mCapturing; }
+
+    /**
+     * @brief Get the file of the running (or last) capture
+     * @return The trace path
+     */
+    [[nodiscard]] const std::filesystem::path& getPath() const noexcept { return mPath; }
+
+    /**
+     * @brief Check whether an item ID still needs a palette entry
+     * @param itemId The numeric item ID
+     * @return true the first time the ID is seen in this capture
+     */
+    [[nodiscard]] bool needsItemName(std::int16_t itemId) const noexcept {
+        const auto index = static_cast<std::uint16_t>(itemId);
+        return ((mSeenItems[index >> 6] >> (index & 63)) & 1) == 0;
+    }
+
+    /**
+     * @brief Check whether a block runtime ID still needs a palette entry
+     * @param runtimeId The block runtime ID
+     * @return true the first time the ID is seen in this capture
+     */
+    [[nodiscard]] bool needsBlockName(std::uint32_t runtimeId) const noexcept {
+        const auto word = runtimeId >> 6;
+        return word >= mSeenBlocks.size() || ((mSeenBlocks[word] >> (runtimeId & 63)) & 1) == 0;
+    }
+
+    /**
+     * @brief Add the palette entry of an item
+     * @param itemId The numeric item ID
+     * @param name The namespaced item name
+     */
+    void addItemName(std::int16_t itemId, std::string_view name);
+
+    /**
+     * @brief Add the palette entry of a block permutation
+     * @param runtimeId The block runtime ID
+     * @param name The namespaced block name
+     * @param growthStage Legacy data value, or UNKNOWN_GROWTH_STAGE
+     */
+    void addBlockName(std::uint32_t runtimeId, std::string_view name, std::uint8_t growthStage);
+
+    /**
+     * @brief Append a record; the timestamp is filled in from the capture clock
+     * @param record The record to append
+     */
+    void append(TraceRecord record) noexcept {
+        record.timeMs = static_cast<std::uint32_t>(
+            std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - mStartTime)
+                .count()
+        );
+        mActive.push_back(record);
+        if (mActive.size() == BUFFER_RECORDS) [[unlikely]] {
+            handOff();
+        }
+    }
+
+    /**
+     * @brief Hand buffered records to the writer thread without waiting for a full buffer
+     */
+    void flush() noexcept;
+
+    /**
+     * @brief Get the number of records written to disk
+     * @return Records written by the current or last capture
+     */
+    [[nodiscard]] std::uint64_t getWrittenCount() const noexcept { return mWritten.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Get the number of records dropped because the writer fell behind
+     * @return Records dropped by the current or last capture
+     */
+    [[nodiscard]] std::uint64_t getDroppedCount() const noexcept { return mDropped.load(std::memory_order_relaxed); }
+
+private:
+    bool tryHandOff() noexcept;
+    void handOff() noexcept;
+    void run(std::ofstream& trace, std::ofstream& palette) noexcept;
+
+    // Game thread
+    std::vector<TraceRecord>              mActive;
+    std::string                           mActivePalette;
+    std::vector<std::uint64_t>            mSeenItems = std::vector<std::uint64_t>((std::size_t{1} << 16) / 64, 0);
+    std::vector<std::uint64_t>            mSeenBlocks;
+    std::chrono::steady_clock::time_point mStartTime;
+    std::filesystem::path                 mPath;
+    bool                                  mCapturing = false;
+
+    // Shared with the writer thread
+    std::mutex                 mMutex;
+    std::condition_variable    mCondition;
+    std::vector<TraceRecord>   mPending;
+    std::string                mPendingPalette;
+    bool                       mPendingReady = false;
+    bool                       mStopping     = false;
+    std::thread                mThread;
+    std::atomic<std::uint64_t> mWritten{0};
+    std::atomic<std::uint64_t> mDropped{0};
+};
+
+} // namespace potato_bonemeal_blocker
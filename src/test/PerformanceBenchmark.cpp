@@ -0,0 +1,1370 @@
+// Standalone performance benchmark for the Potato Bone Meal Blocker.
+// Runs the real plugin against the mock LeviLamina layer in src/test/mock.
+//
+// Build and run with:
+//   xmake f -m release && xmake build potato-bonemeal-blocker-benchmark
+//   xmake run potato-bonemeal-blocker-benchmark [--events N] [--bone-meal R] [--potato R] [--fallback R] [--players N]
+
+#include "mod/AsyncLogSink.h"
+#include "mod/BlockLookupCache.h"
+#include "mod/BlockedStats.h"
+#include "mod/Config.h"
+#include "mod/FeedbackPackets.h"
+#include "mod/FrameArena.h"
+#include "mod/HostShare.h"
+#include "mod/Language.h"
+#include "mod/PotatoBoneMealBlocker.h"
+#include "mod/PolicySchedule.h"
+#include "mod/RegionIndex.h"
+#include "mod/SharedMemory.h"
+#include "mod/TextFormat.h"
+#include "mod/TimerWheel.h"
+
+#include "ll/api/event/EventBus.h"
+#include "ll/api/event/player/PlayerDisconnectEvent.h"
+#include "ll/api/event/player/PlayerInteractBlockEvent.h"
+#include "ll/api/event/player/PlayerJoinEvent.h"
+#include "ll/api/event/player/PlayerPlaceBlockEvent.h"
+#include "ll/api/mod/NativeMod.h"
+#include "ll/api/service/Bedrock.h"
+#include "ll/api/thread/ServerThreadExecutor.h"
+#include "mc/util/Random.h"
+#include "mc/world/item/FertilizerType.h"
+#include "mc/world/level/block/CropBlock.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <new>
+#include <optional>
+#include <random>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+std::atomic<std::uint64_t> gAllocations{0};
+thread_local bool          tCountAllocations = false;
+int                        gFailures         = 0; ///< Checks that failed; the run exits non-zero
+
+void* countedAlloc(std::size_t size) noexcept {
+    if (tCountAllocations) {
+        gAllocations.fetch_add(1, std::memory_order_relaxed);
+    }
+    return std::malloc(size == 0 ? 1 : size);
+}
+
+// Out of line, so GCC does not see free() inlined where it assumes the built-in operator new allocated
+#if defined(_MSC_VER)
+__declspec(noinline)
+#else
+__attribute__((noinline))
+#endif
+void freeAllocation(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+} // namespace
+
+// Count heap allocations made by the benchmark thread, arrays included; background threads are ignored
+void* operator new(std::size_t size) {
+    if (void* ptr = countedAlloc(size)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    if (void* ptr = countedAlloc(size)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return countedAlloc(size); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return countedAlloc(size); }
+
+void operator delete(void* ptr) noexcept { freeAllocation(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { freeAllocation(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { freeAllocation(ptr); }
+void operator delete[](void* ptr) noexcept { freeAllocation(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { freeAllocation(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { freeAllocation(ptr); }
+
+namespace {
+
+using namespace potato_bonemeal_blocker;
+
+/**
+ * @brief Prevents the optimizer from discarding benchmarked results
+ */
+template <class T>
+void doNotOptimize(const T& value) {
+#if defined(_MSC_VER)
+    static volatile const void* sink;
+    sink = &value;
+#else
+    asm volatile("" : : "r,m"(value) : "memory");
+#endif
+}
+
+/**
+ * @brief Run a benchmark and print ns/op, allocations/op and throughput
+ * @param name Benchmark name
+ * @param iterations Number of iterations
+ * @param body Callable executed once per iteration, receives the iteration index
+ * @return Heap allocations per iteration after the warm-up
+ */
+template <class Fn>
+double runBenchmark(std::string_view name, std::uint64_t iterations, Fn&& body) {
+    for (std::uint64_t i = 0; i < iterations / 10; ++i) {
+        body(i); // warm-up
+    }
+
+    tCountAllocations            = true;
+    const auto allocationsBefore = gAllocations.load(std::memory_order_relaxed);
+    const auto start             = std::chrono::steady_clock::now();
+    for (std::uint64_t i = 0; i < iterations; ++i) {
+        body(i);
+    }
+    const auto elapsed     = std::chrono::steady_clock::now() - start;
+    const auto allocations = gAllocations.load(std::memory_order_relaxed) - allocationsBefore;
+    tCountAllocations      = false;
+
+    const auto ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+    const auto perOp = ns / static_cast<double>(iterations);
+    std::printf(
+        "%-48.*s %10.2f ns/op %8.3f allocs/op %10.2f Mop/s\n",
+        static_cast<int>(name.size()),
+        name.data(),
+        perOp,
+        static_cast<double>(allocations) / static_cast<double>(iterations),
+        perOp > 0 ? 1000.0 / perOp : 0.0
+    );
+    return static_cast<double>(allocations) / static_cast<double>(iterations);
+}
+
+/**
+ * @brief Fail the run if a path that must be allocation-free in steady state allocated
+ * @param what Description of the path
+ * @param allocationsPerOp Result of runBenchmark()
+ */
+void expectNoAllocations(std::string_view what, double allocationsPerOp) {
+    if (allocationsPerOp > 0.0) {
+        std::printf(
+            "    FAIL: %.*s made %.3f heap allocations per operation\n",
+            static_cast<int>(what.size()),
+            what.data(),
+            allocationsPerOp
+        );
+        ++gFailures;
+    }
+}
+
+/**
+ * @brief Wait until the plugin's log sink has written every queued record
+ */
+void waitForLogSink() {
+    const auto& sink = PotatoBoneMealBlocker::getInstance().getLogSink();
+    while (sink.getPendingCount() != 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    // The sink reports losses after the batch that emptied the ring
+    std::this_thread::sleep_for(2 * AsyncLogSink::Settings{}.flushInterval);
+}
+
+/**
+ * @brief The nested-map message store Language used before the flat table
+ */
+class NestedMapLanguage {
+public:
+    NestedMapLanguage() {
+        mMessages["blocked_message"] = {
+            {Language::LanguageCode::CHINESE_SIMPLIFIED, "§c骨粉不能用于土豆作物！"},
+            {Language::LanguageCode::ENGLISH,            "§cBone meal cannot be used on potato crops!"}
+        };
+        mMessages["info_message"] = {
+            {Language::LanguageCode::CHINESE_SIMPLIFIED, "§e你仍然可以在其他作物上使用骨粉。"},
+            {Language::LanguageCode::ENGLISH,            "§eYou can still use bone meal on other crops."}
+        };
+    }
+
+    std::string_view getMessage(std::string_view key) const noexcept {
+        const auto keyStr     = std::string(key);
+        const auto messageIt  = mMessages.find(keyStr);
+        if (messageIt != mMessages.end()) {
+            const auto langIt = messageIt->second.find(mCurrentLanguage);
+            if (langIt != messageIt->second.end()) {
+                return langIt->second;
+            }
+        }
+        return "Message not found";
+    }
+
+    std::string getBlockedMessage() const noexcept { return std::string(getMessage("blocked_message")); }
+    std::string getInfoMessage() const noexcept { return std::string(getMessage("info_message")); }
+
+private:
+    Language::LanguageCode mCurrentLanguage = Language::LanguageCode::CHINESE_SIMPLIFIED;
+    std::unordered_map<std::string, std::unordered_map<Language::LanguageCode, std::string>> mMessages;
+};
+
+void benchmarkLanguage() {
+    constexpr std::uint64_t iterations = 2'000'000;
+
+    const NestedMapLanguage nested;
+    runBenchmark("language/nested-map blocked+info", iterations, [&](std::uint64_t) {
+        auto blocked = nested.getBlockedMessage();
+        auto info    = nested.getInfoMessage();
+        doNotOptimize(blocked);
+        doNotOptimize(info);
+    });
+
+    const auto& language = Language::getInstance();
+    runBenchmark("language/flat-table blocked+info", iterations, [&](std::uint64_t) {
+        auto blocked = language.getBlockedMessage();
+        auto info    = language.getInfoMessage();
+        doNotOptimize(blocked);
+        doNotOptimize(info);
+    });
+}
+
+/**
+ * @brief Blocked feedback sent as chat messages, each building its own packet, versus cached packets
+ */
+void benchmarkFeedback() {
+    constexpr std::uint64_t iterations = 2'000'000;
+
+    Dimension   dimension(0);
+    Player      player("Feedback", 1, dimension);
+    const auto& language = Language::getInstance();
+    const auto  code     = language.getCurrentLanguage();
+    runBenchmark("feedback/sendMessage blocked+info", iterations, [&](std::uint64_t) {
+        player.sendMessage(language.getMessage(Language::MessageKey::BLOCKED_MESSAGE, code));
+        player.sendMessage(language.getMessage(Language::MessageKey::INFO_MESSAGE, code));
+    });
+
+    FeedbackPackets packets;
+    packets.build(language);
+    runBenchmark("feedback/cached packets blocked+info", iterations, [&](std::uint64_t) {
+        doNotOptimize(packets.send(player, code, true));
+    });
+    doNotOptimize(player.getPacketsReceived());
+
+    // The "blocked N times" summary, formatted per player on every flush
+    runBenchmark("feedback/summary into std::string", iterations, [&](std::uint64_t i) {
+        std::string message;
+        language.formatMessage(message, Language::MessageKey::BLOCKED_SUMMARY, {i});
+        doNotOptimize(message.data());
+    });
+    const auto arenaAllocations = runBenchmark("feedback/summary into frame arena", iterations, [&](std::uint64_t i) {
+        FrameScope  frame;
+        ArenaString message;
+        language.formatMessage(message, Language::MessageKey::BLOCKED_SUMMARY, {i});
+        doNotOptimize(message.data());
+    });
+    expectNoAllocations("formatting into the frame arena", arenaAllocations);
+}
+
+/**
+ * @brief A burst of blocked attempts pushed into a small log queue whose writer cannot keep up, per overflow policy
+ */
+void benchmarkLogSink() {
+    constexpr std::uint64_t iterations = 1'000'000;
+
+    for (const auto policy : {AsyncLogSink::OverflowPolicy::DROP, AsyncLogSink::OverflowPolicy::SAMPLE}) {
+        AsyncLogSink::Settings settings;
+        settings.capacity      = 1024;
+        settings.policy        = policy;
+        settings.sampleRate    = 8;
+        settings.flushInterval = std::chrono::milliseconds(1);
+
+        // About 2 us per line: far slower than the producer, so the queue runs full
+        AsyncLogSink sink;
+        sink.configure(settings);
+        sink.start([](std::string_view line) {
+            const auto until = std::chrono::steady_clock::now() + std::chrono::microseconds(2);
+            while (std::chrono::steady_clock::now() < until) {
+                doNotOptimize(line.data());
+            }
+        });
+
+        BlockedAttemptRecord record;
+        record.setPlayerName("Macro");
+        std::uint64_t pushed = 0;
+        std::string   name;
+        appendFormatted(name, "log sink/push burst, {} policy", {AsyncLogSink::policyName(policy)});
+        const auto allocations = runBenchmark(name, iterations, [&](std::uint64_t i) {
+            record.x = static_cast<std::int32_t>(i);
+            doNotOptimize(sink.push(record));
+            ++pushed;
+        });
+        expectNoAllocations("pushing into the log sink", allocations);
+        sink.stop();
+
+        const auto accounted = sink.getWrittenCount() + sink.getDroppedCount() + sink.getSampledOutCount();
+        std::printf(
+            "    %llu written, %llu dropped when full, %llu sampled out\n",
+            static_cast<unsigned long long>(sink.getWrittenCount()),
+            static_cast<unsigned long long>(sink.getDroppedCount()),
+            static_cast<unsigned long long>(sink.getSampledOutCount())
+        );
+        if (accounted != pushed) {
+            std::printf(
+                "    FAIL: %llu of %llu records unaccounted for\n",
+                static_cast<unsigned long long>(pushed - accounted),
+                static_cast<unsigned long long>(pushed)
+            );
+            ++gFailures;
+        }
+        if (policy == AsyncLogSink::OverflowPolicy::SAMPLE && sink.getSampledOutCount() == 0) {
+            std::printf("    FAIL: the SAMPLE policy never thinned out the burst\n");
+            ++gFailures;
+        }
+    }
+}
+
+/**
+ * @brief Mix of interactions fed to the handler
+ */
+struct Workload {
+    std::string   name;
+    double        boneMealRatio = 0.05; ///< Share of interactions made while holding bone meal
+    double        potatoRatio   = 0.5;  ///< Share of interactions that target potato crops
+    double        fallbackRatio = 0.0;  ///< Share of events without event.block()
+    std::size_t   players       = 20;
+    std::uint64_t events        = 1'000'000;
+    double        staffRatio    = 0.0; ///< Share of players with operator permission, exempt from the rules
+    std::size_t   bystanders    = 0;   ///< Extra players holding bone meal without interacting
+    std::size_t   positions     = 4096; ///< Distinct blocks clicked, at most 4096
+};
+
+/**
+ * @brief One pre-generated interaction
+ */
+struct Interaction {
+    std::size_t               player;
+    int                       slot; ///< Hotbar slot selected for the interaction; slot 0 holds bone meal
+    BlockPos                  pos;
+    optional_ref<Block const> block;
+};
+
+/**
+ * @brief Mock world the workloads run in: one dimension, a crop field and a set of players
+ */
+class MockWorld {
+public:
+    /// Chance that a player switches hotbar slots before an interaction
+    static constexpr double SWITCH_RATIO = 1.0 / 16;
+
+    MockWorld() : mDimension(0) {
+        // Every player carries the same hotbar: bone meal first, then other items and an empty slot
+        mHotbar.push_back(*ItemStack::create("minecraft:bone_meal"));
+        mHotbar.push_back(*ItemStack::create("minecraft:wheat_seeds"));
+        mHotbar.push_back(*ItemStack::create("minecraft:diamond_sword"));
+        mHotbar.push_back(*ItemStack::create("minecraft:stick"));
+        mHotbar.push_back(ItemStack{});
+
+        for (std::uint16_t stage = 0; stage < 8; ++stage) {
+            mPotatoes.push_back(&Block::tryGetFromRegistry("minecraft:potatoes", stage).value());
+            mOtherBlocks.push_back(&Block::tryGetFromRegistry("minecraft:carrots", stage).value());
+        }
+        mOtherBlocks.push_back(&Block::tryGetFromRegistry("minecraft:dirt").value());
+        mOtherBlocks.push_back(&Block::tryGetFromRegistry("minecraft:farmland").value());
+    }
+
+    /**
+     * @brief Create the players of a workload, register them with the mock level and announce their join
+     *
+     * Players join with a non-covered item selected; bystanders join holding bone meal.
+     *
+     * @param count Number of interacting players
+     * @param staffRatio Share of the players given operator permission
+     * @param bystanders Additional players holding bone meal who never interact
+     */
+    void spawnPlayers(std::size_t count, double staffRatio, std::size_t bystanders = 0) {
+        auto  level    = ll::service::getLevel();
+        auto& eventBus = ll::event::EventBus::getInstance();
+        for (auto& player : mPlayers) {
+            ll::event::PlayerDisconnectEvent event(*player);
+            eventBus.publish(event);
+            level->removePlayer(*player);
+        }
+        mPlayers.clear();
+
+        const auto staff = static_cast<std::size_t>(static_cast<double>(count) * staffRatio);
+        for (std::size_t i = 0; i < count + bystanders; ++i) {
+            mPlayers.push_back(std::make_unique<Player>("Farmer" + std::to_string(i), 1000 + i, mDimension));
+            auto& player = *mPlayers.back();
+            if (i < staff) {
+                player.setCommandPermissionLevel(CommandPermissionLevel::GameDirectors);
+            }
+            player.selectSlot(i < count ? 1 : 0);
+            for (std::size_t slot = 0; slot < mHotbar.size(); ++slot) {
+                player.setHotbarItem(static_cast<int>(slot), mHotbar[slot]);
+            }
+            level->addPlayer(player);
+            ll::event::PlayerJoinEvent event(player);
+            eventBus.publish(event);
+        }
+
+        // Let the plugin's periodic tasks run, e.g. to release listeners nobody needs any more
+        ll::thread::ServerThreadExecutor::getDefault().runTicks(40);
+    }
+
+    /**
+     * @brief Generate a repeating sequence of interactions for a workload
+     * @param workload The workload mix
+     * @return Interactions cycled through by the benchmark loop
+     */
+    std::vector<Interaction> generate(const Workload& workload) {
+        spawnPlayers(workload.players, workload.staffRatio, workload.bystanders);
+
+        std::mt19937_64                        random(42);
+        std::uniform_real_distribution<double> unit(0.0, 1.0);
+        std::vector<Interaction>               interactions(4096);
+
+        // Players keep their selected slot for a while, as they do in game
+        const auto pickSlot = [&] {
+            return unit(random) < workload.boneMealRatio ? 0 : 1 + static_cast<int>(random() % (mHotbar.size() - 1));
+        };
+        std::vector<int> selected(workload.players);
+        for (auto& slot : selected) {
+            slot = pickSlot();
+        }
+
+        auto&                     blockSource = mDimension.getBlockSourceFromMainChunkSource();
+        std::vector<Block const*> blocks(workload.positions);
+        for (std::size_t i = 0; i < interactions.size(); ++i) {
+            auto& interaction  = interactions[i];
+            interaction.player = random() % workload.players;
+            if (unit(random) < SWITCH_RATIO) {
+                selected[interaction.player] = pickSlot();
+            }
+            interaction.slot = selected[interaction.player];
+            const auto  position = i % workload.positions;
+            interaction.pos      = BlockPos{static_cast<int>(position % 64), 64, static_cast<int>(position / 64)};
+
+            // Positions clicked again keep the block they were given first
+            auto& block = blocks[position];
+            if (!block) {
+                block = unit(random) < workload.potatoRatio ? mPotatoes[random() % mPotatoes.size()]
+                                                            : mOtherBlocks[random() % mOtherBlocks.size()];
+                blockSource.setBlock(interaction.pos, *block);
+            }
+            interaction.block = unit(random) < workload.fallbackRatio ? nullptr : optional_ref<Block const>(*block);
+        }
+        return interactions;
+    }
+
+    [[nodiscard]] Player&    player(std::size_t index) const { return *mPlayers[index]; }
+    [[nodiscard]] Dimension& dimension() noexcept { return mDimension; }
+
+private:
+    Dimension                            mDimension;
+    std::vector<ItemStack>               mHotbar;
+    std::vector<Block const*>            mPotatoes;
+    std::vector<Block const*>            mOtherBlocks;
+    std::vector<std::unique_ptr<Player>> mPlayers;
+};
+
+void benchmarkHandler(MockWorld& world, const Workload& workload) {
+    const auto interactions = world.generate(workload);
+    auto&      eventBus     = ll::event::EventBus::getInstance();
+    auto&      plugin       = PotatoBoneMealBlocker::getInstance();
+
+    const auto blockedBefore       = plugin.getBlockedCount();
+    const auto subscriptionsBefore = plugin.getInteractSubscriptions();
+    const bool subscribedBefore    = plugin.isInteractListenerRegistered();
+    const auto allocations = runBenchmark("handler/" + workload.name, workload.events, [&](std::uint64_t i) {
+        const auto& interaction = interactions[i & (interactions.size() - 1)];
+        auto&       player      = world.player(interaction.player);
+        if (player.getSelectedItemSlot() != interaction.slot) {
+            player.selectSlot(interaction.slot);
+        }
+        ll::event::PlayerInteractBlockEvent event(
+            player,
+            player.getSelectedItem(),
+            interaction.pos,
+            1,
+            interaction.block
+        );
+        eventBus.publish(event);
+        doNotOptimize(event.isCancelled());
+    });
+    std::printf(
+        "    blocked %llu of %llu events; interaction listener %s, %llu subscriptions during the run\n",
+        static_cast<unsigned long long>(plugin.getBlockedCount() - blockedBefore),
+        static_cast<unsigned long long>(workload.events + workload.events / 10),
+        subscribedBefore ? "subscribed" : "unsubscribed at start",
+        static_cast<unsigned long long>(plugin.getInteractSubscriptions() - subscriptionsBefore)
+    );
+    expectNoAllocations("the handler", allocations);
+}
+
+/**
+ * @brief Random ticks over a large crop field, with and without the growth governor
+ */
+void benchmarkGrowth() {
+    constexpr int           FIELD_X    = 1000;
+    constexpr int           FIELD_Z    = 400;
+    constexpr std::uint64_t iterations = 2'000'000;
+
+    // Alternating rows of potatoes (governed) and wheat: 400,000 crops over 1,600 chunks
+    Dimension dimension(0);
+    auto&     region  = dimension.getBlockSourceFromMainChunkSource();
+    const auto& potato = Block::tryGetFromRegistry("minecraft:potatoes", 0).value();
+    const auto& wheat  = Block::tryGetFromRegistry("minecraft:wheat", 0).value();
+    for (int x = 0; x < FIELD_X; ++x) {
+        for (int z = 0; z < FIELD_Z; ++z) {
+            region.setBlock(BlockPos{x, 64, z}, z % 2 == 0 ? potato : wheat);
+        }
+    }
+
+    std::mt19937_64       random(7);
+    std::vector<BlockPos> ticks(1 << 16);
+    for (auto& pos : ticks) {
+        pos = BlockPos{static_cast<int>(random() % FIELD_X), 64, static_cast<int>(random() % FIELD_Z)};
+    }
+
+    Random     tickRandom;
+    const auto runTicks = [&](std::string_view name) {
+        runBenchmark(name, iterations, [&](std::uint64_t i) {
+            const auto& pos   = ticks[i & (ticks.size() - 1)];
+            const auto& block = region.getBlock(pos);
+            static_cast<const CropBlock&>(block.getLegacyBlock()).randomTick(region, pos, tickRandom);
+        });
+    };
+
+    auto& plugin = PotatoBoneMealBlocker::getInstance();
+    plugin.setGrowthMode(GrowthGovernor::Mode::OFF);
+    runTicks("growth/random tick, governor off");
+
+    plugin.setGrowthMode(GrowthGovernor::Mode::THROTTLE);
+    for (int x = 0; x < FIELD_X; ++x) {
+        for (int z = 0; z < FIELD_Z; ++z) {
+            // First tick of every crop registers it, as after a chunk load
+            const BlockPos pos{x, 64, z};
+            static_cast<const CropBlock&>(region.getBlock(pos).getLegacyBlock()).randomTick(region, pos, tickRandom);
+        }
+    }
+    runTicks("growth/random tick, throttle (400k crops)");
+
+    const auto& governor = plugin.getGrowthGovernor();
+    std::printf(
+        "    %zu crops tracked in %zu chunks, %llu ticks suppressed\n",
+        governor.getTrackedCrops(),
+        governor.getTrackedChunks(),
+        static_cast<unsigned long long>(governor.getSuppressedTicks())
+    );
+    plugin.setGrowthMode(GrowthGovernor::Mode::OFF);
+}
+
+/**
+ * @brief A redstone dispenser farm: single shots through the growth pipeline, then whole ticks with the flush
+ */
+void benchmarkDispensers(MockWorld& world) {
+    constexpr int ORIGIN      = -10'000; // Away from the blocks the other benchmarks place
+    constexpr int FARM_CHUNKS = 8;
+
+    // Four dispensers per chunk over 8x8 chunks, each aimed at a potato, and as many aimed at wheat
+    auto&                 region = world.dimension().getBlockSourceFromMainChunkSource();
+    const auto&           potato = Block::tryGetFromRegistry("minecraft:potatoes", 0).value();
+    const auto&           wheat  = Block::tryGetFromRegistry("minecraft:wheat", 0).value();
+    std::vector<BlockPos> potatoes;
+    std::vector<BlockPos> wheats;
+    for (int cx = 0; cx < FARM_CHUNKS; ++cx) {
+        for (int cz = 0; cz < FARM_CHUNKS; ++cz) {
+            for (int d = 0; d < 4; ++d) {
+                potatoes.push_back(BlockPos{ORIGIN + cx * 16 + d * 4, 64, ORIGIN + cz * 16});
+                wheats.push_back(BlockPos{ORIGIN + cx * 16 + d * 4, 64, ORIGIN + cz * 16 + 8});
+                region.setBlock(potatoes.back(), potato);
+                region.setBlock(wheats.back(), wheat);
+            }
+        }
+    }
+    const auto fire = [&](const BlockPos& pos) {
+        const auto& crop = static_cast<const CropBlock&>(region.getBlock(pos).getLegacyBlock());
+        return crop.fertilize(region, pos, nullptr, FertilizerType::Bonemeal);
+    };
+
+    auto&       plugin   = PotatoBoneMealBlocker::getInstance();
+    const auto& pipeline = plugin.getGrowthPipeline();
+    if (!pipeline.isAttached()) {
+        std::printf("    fertilization hook not installed\n");
+        return;
+    }
+    const auto shot = runBenchmark("fertilizer/dispenser on potatoes", 2'000'000, [&](std::uint64_t i) {
+        doNotOptimize(fire(potatoes[i % potatoes.size()]));
+    });
+    expectNoAllocations("the dispenser path", shot);
+    runBenchmark("fertilizer/dispenser on wheat (not in the rules)", 2'000'000, [&](std::uint64_t i) {
+        doNotOptimize(fire(wheats[i % wheats.size()]));
+    });
+
+    // Every dispenser fires on every tick; the ticker hands the counts to statistics and the log sink
+    waitForLogSink();
+    auto&      executor      = ll::thread::ServerThreadExecutor::getDefault();
+    const auto linesBefore   = plugin.getSelf().getLogger().getLineCount();
+    const auto blockedBefore = plugin.getBlockedCount();
+    runBenchmark("fertilizer/farm tick, 256 dispensers", 2'000, [&](std::uint64_t) {
+        for (const auto& pos : potatoes) {
+            doNotOptimize(fire(pos));
+        }
+        executor.runTicks(1);
+    });
+    waitForLogSink();
+    std::printf(
+        "    %llu shots blocked, %llu allowed; plugin count +%llu, %llu log lines since the farm started\n",
+        static_cast<unsigned long long>(pipeline.getBlockedCount()),
+        static_cast<unsigned long long>(pipeline.getAllowedCount()),
+        static_cast<unsigned long long>(plugin.getBlockedCount() - blockedBefore),
+        static_cast<unsigned long long>(plugin.getSelf().getLogger().getLineCount() - linesBefore)
+    );
+}
+
+/**
+ * @brief Server-thread cost of swapping in a new rule snapshot
+ *
+ * Applying rules compiles and publishes a snapshot; a reload additionally reads
+ * and parses the config file, which the watcher normally does off-thread.
+ */
+void benchmarkReload() {
+    auto&      plugin   = PotatoBoneMealBlocker::getInstance();
+    const auto original = plugin.getRules();
+    auto       extended = original;
+    extended.push_back(GrowthRule{"minecraft:bone_meal", "minecraft:carrots", 4});
+
+    runBenchmark("config/apply rules", 200, [&](std::uint64_t i) {
+        doNotOptimize(plugin.setRules(i % 2 == 0 ? extended : original));
+    });
+    runBenchmark("config/reload from file", 200, [&](std::uint64_t) { doNotOptimize(plugin.reloadConfig()); });
+    std::printf(
+        "    snapshot generation %llu, %zu awaiting reclamation\n",
+        static_cast<unsigned long long>(plugin.getRuleSnapshots().getGeneration()),
+        plugin.getRuleSnapshots().getRetiredCount()
+    );
+}
+
+/**
+ * @brief Region lookup with 10k regions: the chunk-grid index against a linear scan, then the whole handler
+ */
+void benchmarkRegions(MockWorld& world) {
+    constexpr std::uint32_t REGION_COUNT = 10'000;
+    constexpr int           AREA         = 4'000; // Regions are spread over a 4000x4000 block area
+
+    std::mt19937_64                  random(11);
+    std::vector<RegionIndex::Region> regions(REGION_COUNT);
+    for (std::uint32_t i = 0; i < REGION_COUNT; ++i) {
+        const int x     = static_cast<int>(random() % AREA) - AREA / 2;
+        const int z     = static_cast<int>(random() % AREA) - AREA / 2;
+        const int sizeX = 8 + static_cast<int>(random() % 40);
+        const int sizeZ = 8 + static_cast<int>(random() % 40);
+        regions[i]      = RegionIndex::Region{
+            RegionBox{0, x, -64, z, x + sizeX, 319, z + sizeZ},
+            static_cast<std::int32_t>(random() % 4),
+            i
+        };
+    }
+    std::vector<BlockPos> probes(1 << 16);
+    for (auto& pos : probes) {
+        pos = BlockPos{static_cast<int>(random() % AREA) - AREA / 2, 64, static_cast<int>(random() % AREA) - AREA / 2};
+    }
+
+    RegionIndex index;
+    index.build(regions);
+    std::uint64_t hits = 0;
+    runBenchmark("regions/chunk grid, 10k regions", 10'000'000, [&](std::uint64_t i) {
+        const auto& pos = probes[i & (probes.size() - 1)];
+        hits += index.find(0, pos.x, pos.y, pos.z) != RegionIndex::NO_REGION;
+    });
+    runBenchmark("regions/linear scan, 10k regions", 20'000, [&](std::uint64_t i) {
+        const auto& pos  = probes[i & (probes.size() - 1)];
+        const auto* best = static_cast<const RegionIndex::Region*>(nullptr);
+        for (const auto& region : regions) {
+            if (region.box.contains(pos.x, pos.y, pos.z) && (!best || region.priority > best->priority)) {
+                best = &region;
+            }
+        }
+        doNotOptimize(best);
+    });
+    std::printf(
+        "    %zu chunks indexed, %.1f%% of probes inside a region\n",
+        index.getChunkCount(),
+        100.0 * static_cast<double>(hits) / 11'000'000.0
+    );
+
+    // The same regions through the config file; the west half of the farm is an allow-all spawn area
+    auto&      plugin     = PotatoBoneMealBlocker::getInstance();
+    const auto configPath = plugin.getSelf().getConfigDir() / PotatoBoneMealBlocker::CONFIG_FILE_NAME;
+    const auto original   = plugin.getConfig();
+    auto       config     = original;
+    config.regions.push_back(RegionConfig{"spawn", RegionBox{0, 0, -64, 0, 31, 319, 63}, 10, {}});
+    for (const auto& region : regions) {
+        config.regions.push_back(RegionConfig{
+            "market",
+            region.box,
+            region.priority,
+            region.value % 2 == 0 ? std::vector<GrowthRule>{} : original.rules
+        });
+    }
+    if (saveConfig(configPath, config) && plugin.reloadConfig()) {
+        benchmarkHandler(world, Workload{"raid inside 10k regions", 1.0, 1.0});
+        benchmarkHandler(world, Workload{"farming inside 10k regions", 0.05, 0.5});
+    }
+    saveConfig(configPath, original);
+    plugin.reloadConfig();
+}
+
+/**
+ * @brief The raid preset with auto-clicker detection on: every raider is flagged within their first attempts
+ */
+void benchmarkClickRate(MockWorld& world) {
+    auto&      plugin     = PotatoBoneMealBlocker::getInstance();
+    const auto configPath = plugin.getSelf().getConfigDir() / PotatoBoneMealBlocker::CONFIG_FILE_NAME;
+    const auto original   = plugin.getConfig();
+    auto       config     = original;
+    config.clickRate.enabled = true;
+
+    const auto& detector      = plugin.getClickRateDetector();
+    const auto  flagsBefore   = detector.getFlagCount();
+    const auto  droppedBefore = detector.getDroppedCount();
+    if (saveConfig(configPath, config) && plugin.reloadConfig()) {
+        benchmarkHandler(world, Workload{"raid, auto-clicker detection on", 1.0, 1.0});
+        std::printf(
+            "    %llu players flagged, %llu interactions dropped before rule evaluation\n",
+            static_cast<unsigned long long>(detector.getFlagCount() - flagsBefore),
+            static_cast<unsigned long long>(detector.getDroppedCount() - droppedBefore)
+        );
+    }
+    saveConfig(configPath, original);
+    plugin.reloadConfig();
+}
+
+/**
+ * @brief The farming and raid presets with a candidate rule set evaluated in shadow mode
+ *
+ * The candidate protects potatoes only from growth stage 4 and adds carrots,
+ * so the raid produces disagreements in both directions.
+ */
+void benchmarkShadow(MockWorld& world) {
+    auto&      plugin     = PotatoBoneMealBlocker::getInstance();
+    const auto configPath = plugin.getSelf().getConfigDir() / PotatoBoneMealBlocker::CONFIG_FILE_NAME;
+    const auto original   = plugin.getConfig();
+    auto       config     = original;
+    config.shadow.enabled = true;
+    config.shadowRules    = {
+        GrowthRule{"minecraft:bone_meal", "minecraft:potatoes", 4},
+        GrowthRule{"minecraft:bone_meal", "minecraft:carrots",  0}
+    };
+
+    const auto& shadow = plugin.getShadowEvaluator();
+    if (saveConfig(configPath, config) && plugin.reloadConfig()) {
+        for (const auto& workload :
+             {Workload{"farming, shadow rules sampled", 0.05, 0.5}, Workload{"raid, shadow rules sampled", 1.0, 0.5}}) {
+            benchmarkHandler(world, workload);
+            const auto summary = shadow.summarize(0);
+            std::printf(
+                "    %llu of %llu events sampled, now 1 in %u; %llu agree, %llu live only, %llu candidate only; "
+                "candidate p50 %u ns; overhead %.2f%% (limit %.2f%%)\n",
+                static_cast<unsigned long long>(summary.samples),
+                static_cast<unsigned long long>(summary.events),
+                summary.interval,
+                static_cast<unsigned long long>(summary.agreed),
+                static_cast<unsigned long long>(summary.liveOnly),
+                static_cast<unsigned long long>(summary.candidateOnly),
+                summary.costP50Ns,
+                summary.overhead * 100.0,
+                shadow.getSettings().maxOverhead * 100.0
+            );
+        }
+    }
+    saveConfig(configPath, original);
+    plugin.reloadConfig();
+}
+
+/**
+ * @brief The fallback raid preset against a block API that throws on every lookup
+ *
+ * The fault breaker opens after its budget of faults; the rest of the run
+ * measures events passing an open breaker, and the next release tick drops
+ * the listener.
+ */
+void benchmarkFaultBreaker(MockWorld& world) {
+    auto&       plugin  = PotatoBoneMealBlocker::getInstance();
+    auto&       region  = world.dimension().getBlockSourceFromMainChunkSource();
+    const auto& breaker = plugin.getFaultBreaker();
+    auto&       logger  = plugin.getSelf().getLogger();
+
+    // Blocked attempts of earlier workloads are still being logged
+    waitForLogSink();
+    const auto faultsBefore = breaker.getCount(HandlerFault::BLOCK_LOOKUP);
+    const auto tripsBefore  = breaker.getTripCount();
+    const auto linesBefore  = logger.getLineCount();
+    region.setBroken(true);
+    benchmarkHandler(world, Workload{"raid, block lookups throwing", 1.0, 1.0, 1.0});
+    ll::thread::ServerThreadExecutor::getDefault().runTicks(40);
+    region.setBroken(false);
+
+    const auto trips = breaker.getTripCount() - tripsBefore;
+    const auto lines = logger.getLineCount() - linesBefore;
+    std::printf(
+        "    %llu block lookup faults, breaker tripped %llu times, %llu log lines; listener %s\n",
+        static_cast<unsigned long long>(breaker.getCount(HandlerFault::BLOCK_LOOKUP) - faultsBefore),
+        static_cast<unsigned long long>(trips),
+        static_cast<unsigned long long>(lines),
+        plugin.isInteractListenerRegistered() ? "still registered" : "unregistered"
+    );
+    if (trips != 1 || plugin.isInteractListenerRegistered()) {
+        std::printf("    FAIL: the fault breaker did not open and drop the listener\n");
+        ++gFailures;
+    }
+    // The first-fault warning and the trip alert, not a line per faulting click
+    if (lines > 2) {
+        std::printf(
+            "    FAIL: faults logged %llu lines instead of one warning and one alert\n",
+            static_cast<unsigned long long>(lines)
+        );
+        ++gFailures;
+    }
+    plugin.resetFaultBreaker();
+}
+
+/**
+ * @brief The farming workload with a host share open, next to a second instance simulated in this process
+ *
+ * Checks that the ticker adds every blocked attempt to the host totals and
+ * that a configuration the other instance publishes is applied locally.
+ */
+void benchmarkHostShare(MockWorld& world) {
+    auto&      plugin     = PotatoBoneMealBlocker::getInstance();
+    const auto configPath = plugin.getSelf().getConfigDir() / PotatoBoneMealBlocker::CONFIG_FILE_NAME;
+    const auto original   = plugin.getConfig();
+    auto       config     = original;
+    config.hostShare      = {true, "pbb-benchmark"};
+    SharedMemory::remove(config.hostShare.name);
+
+    const auto  now   = [] {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch())
+            .count();
+    };
+    const auto& share = plugin.getHostShare();
+    HostShare   other;
+    std::string error;
+    if (saveConfig(configPath, config) && plugin.reloadConfig() && other.open(config.hostShare.name, now(), error)) {
+        const auto blockedBefore = plugin.getBlockedCount();
+        benchmarkHandler(world, Workload{"farming, host share open", 0.05, 0.5});
+        ll::thread::ServerThreadExecutor::getDefault().runTicks(20);
+        const auto blocked = plugin.getBlockedCount() - blockedBefore;
+
+        auto published                  = config;
+        published.shadow.sampleInterval = 32;
+        published.hostShare             = {};
+        const auto generation           = other.publishConfig(renderConfig(published));
+        ll::thread::ServerThreadExecutor::getDefault().runTicks(20);
+
+        const auto totals = other.getTotals(now());
+        std::printf(
+            "    %llu of %llu blocked attempts on the host totals, %u instances; "
+            "shared config generation %llu %s\n",
+            static_cast<unsigned long long>(totals.blocked),
+            static_cast<unsigned long long>(blocked),
+            totals.instances,
+            static_cast<unsigned long long>(generation),
+            plugin.getConfig().shadow.sampleInterval == 32 ? "applied" : "not applied"
+        );
+        if (totals.blocked != blocked || totals.instances != 2 || plugin.getConfig().shadow.sampleInterval != 32
+            || !plugin.getConfig().hostShare.enabled) {
+            std::printf("    FAIL: the host share lost counts or did not apply the shared configuration\n");
+            ++gFailures;
+        }
+    } else {
+        std::printf("    FAIL: could not open the host share: %s\n", error.c_str());
+        ++gFailures;
+    }
+    other.close();
+    saveConfig(configPath, original);
+    plugin.reloadConfig();
+    if (share.isOpen()) {
+        std::printf("    FAIL: the host share stayed open after it was disabled\n");
+        ++gFailures;
+    }
+    SharedMemory::remove(config.hostShare.name);
+}
+
+/**
+ * @brief Fallback lookups on blocks no rule names, then the two ways a cached block is dropped
+ *
+ * Repeat clicks on the same positions are served by the block lookup cache;
+ * a placement event drops an entry at once, and a change no event reports
+ * is seen after BlockLookupCache::TTL_TICKS.
+ */
+void benchmarkBlockCache(MockWorld& world) {
+    auto&       plugin = PotatoBoneMealBlocker::getInstance();
+    auto&       region = world.dimension().getBlockSourceFromMainChunkSource();
+    const auto& cache  = plugin.getBlockLookupCache();
+
+    const auto lookupsBefore = region.getLookupCount();
+    const auto hitsBefore    = cache.getHitCount();
+    const auto missesBefore  = cache.getMissCount();
+    benchmarkHandler(world, Workload{"fallback lookups on 256 other blocks", 1.0, 0.0, 1.0, 20, 1'000'000, 0.0, 0, 256});
+    std::printf(
+        "    %llu cache hits, %llu misses, %llu chunk source lookups\n",
+        static_cast<unsigned long long>(cache.getHitCount() - hitsBefore),
+        static_cast<unsigned long long>(cache.getMissCount() - missesBefore),
+        static_cast<unsigned long long>(region.getLookupCount() - lookupsBefore)
+    );
+
+    auto&      player   = world.player(0);
+    const auto pos      = BlockPos{0, 64, 0};
+    const auto interact = [&] {
+        player.selectSlot(0);
+        ll::event::PlayerInteractBlockEvent event(player, player.getSelectedItem(), pos, 1, nullptr);
+        ll::event::EventBus::getInstance().publish(event);
+        return event.isCancelled();
+    };
+    const auto& dirt   = Block::tryGetFromRegistry("minecraft:dirt").value();
+    const auto& potato = Block::tryGetFromRegistry("minecraft:potatoes", 0).value();
+
+    // Placed by a player: the next click sees the potato
+    region.setBlock(pos, dirt);
+    interact();
+    region.setBlock(pos, potato);
+    ll::event::PlayerPlacedBlockEvent placed(player, pos);
+    ll::event::EventBus::getInstance().publish(placed);
+    const bool afterEvent = interact();
+
+    // Changed without an event: the stale entry is served until it expires
+    region.setBlock(pos, dirt);
+    interact();
+    region.setBlock(pos, potato);
+    const bool beforeExpiry = interact();
+    ll::thread::ServerThreadExecutor::getDefault().runTicks(BlockLookupCache::TTL_TICKS);
+    const bool afterExpiry = interact();
+    std::printf(
+        "    potato placed over cached dirt: %s after the event; %s, then %s after %llu ticks without one\n",
+        afterEvent ? "blocked" : "allowed",
+        beforeExpiry ? "blocked" : "allowed",
+        afterExpiry ? "blocked" : "allowed",
+        static_cast<unsigned long long>(BlockLookupCache::TTL_TICKS)
+    );
+    if (!afterEvent || !afterExpiry) {
+        std::printf("    FAIL: the block lookup cache served a block that was replaced\n");
+        ++gFailures;
+    }
+}
+
+/**
+ * @brief The timer wheel alone, the schedule against a brute-force check over two simulated weeks, and the
+ * handler with 64 schedules configured
+ */
+void benchmarkSchedule(MockWorld& world) {
+    constexpr std::uint64_t timers = 1'000'000;
+
+    // Every timer must fire exactly at its due time, however far out it was scheduled
+    TimerWheel                 wheel;
+    std::vector<std::uint64_t> due;
+    std::mt19937_64            random(11);
+    std::uint64_t              fired = 0;
+    std::uint64_t              wrong = 0;
+    const auto                 fire  = [&](std::uint32_t id) {
+        ++fired;
+        wrong += due[id] != wheel.getTime() ? 1 : 0;
+    };
+    due.reserve(timers + timers / 10);
+    wheel.reset(0);
+    runBenchmark("schedule/timer wheel, schedule and advance", timers, [&](std::uint64_t) {
+        const auto now = wheel.getTime();
+        due.push_back(now + 1 + random() % (2 * PolicySchedule::WEEK_SECONDS));
+        wheel.schedule(due.back(), static_cast<std::uint32_t>(due.size() - 1));
+        wheel.advance(now + 1, fire);
+    });
+    wheel.advance(wheel.getTime() + 2 * PolicySchedule::WEEK_SECONDS, fire);
+    std::printf(
+        "    %llu of %zu timers fired, %llu not at their due time\n",
+        static_cast<unsigned long long>(fired),
+        due.size(),
+        static_cast<unsigned long long>(wrong)
+    );
+    if (fired != due.size() || wheel.getPending() != 0 || wrong != 0) {
+        std::printf("    FAIL: the timer wheel lost or misplaced timers\n");
+        ++gFailures;
+    }
+
+    // Second by second, the wheel-driven schedule must agree with evaluating every window
+    std::vector<PolicySchedule::Policy> policies(4);
+    policies[0] = {"harvest", {6}, 18 * 60, -1, 180, {}};
+    policies[1] = {"mornings", {1, 2, 3, 4, 5}, 6 * 60, -1, 120, {}};
+    policies[2] = {"restart", {}, -1, 0, 60, {}};
+    policies[3] = {"midnight", {}, 23 * 60 + 30, -1, 60, {}};
+    PolicySchedule        schedule;
+    PolicySchedule::Clock clock{1'000, 0, 5 * PolicySchedule::DAY_SECONDS + 12'345};
+    schedule.configure(policies, clock);
+    std::uint64_t disagreements = 0;
+    runBenchmark("schedule/advance one second, 4 policies", 2 * PolicySchedule::WEEK_SECONDS, [&](std::uint64_t) {
+        ++clock.monotonicSeconds;
+        ++clock.uptimeSeconds;
+        clock.weekSeconds = (clock.weekSeconds + 1) % PolicySchedule::WEEK_SECONDS;
+        schedule.advance(clock);
+        const auto* active   = schedule.getActive();
+        const auto  expected = PolicySchedule::findActive(policies, clock);
+        const auto  actual   = active ? static_cast<int>(active - schedule.getPolicies().data()) : PolicySchedule::NONE;
+        disagreements += expected != actual ? 1 : 0;
+    });
+    std::printf(
+        "    %llu switches of the policy in force, %llu seconds disagreeing with a full evaluation\n",
+        static_cast<unsigned long long>(schedule.getChangeCount()),
+        static_cast<unsigned long long>(disagreements)
+    );
+    if (disagreements != 0) {
+        std::printf("    FAIL: the schedule missed a window boundary\n");
+        ++gFailures;
+    }
+
+    // 63 weekly schedules behind one that allows everything from the start: the handler reads one snapshot
+    auto&      plugin     = PotatoBoneMealBlocker::getInstance();
+    const auto configPath = plugin.getSelf().getConfigDir() / PotatoBoneMealBlocker::CONFIG_FILE_NAME;
+    const auto original   = plugin.getConfig();
+    auto       config     = original;
+    config.schedules.push_back({"open-season", {}, -1, 0, 10'080, {}});
+    for (int i = 1; i < 64; ++i) {
+        config.schedules.push_back(
+            {"weekly-" + std::to_string(i), {static_cast<std::uint8_t>(i % 7)}, i * 20, -1, 10, original.rules}
+        );
+    }
+    const auto blockedBefore = plugin.getBlockedCount();
+    if (saveConfig(configPath, config) && plugin.reloadConfig()) {
+        benchmarkHandler(world, Workload{"raid, allow-all schedule in force of 64", 1.0, 1.0});
+    }
+    const auto blocked = plugin.getBlockedCount() - blockedBefore;
+    saveConfig(configPath, original);
+    plugin.reloadConfig();
+    if (blocked != 0) {
+        std::printf("    FAIL: %llu attempts blocked while no rule was in force\n", static_cast<unsigned long long>(blocked));
+        ++gFailures;
+    }
+}
+
+/**
+ * @brief A crop census around three players over a potato field, against scanning the same chunks in one tick
+ */
+void benchmarkCensus(MockWorld& world) {
+    constexpr int ORIGIN = 10'000; // Away from the blocks the handler workloads place
+    constexpr int FIELD  = 160;
+
+    // Farmland under alternating rows of potatoes (counted) and wheat (not in the rules)
+    auto&           region = world.dimension().getBlockSourceFromMainChunkSource();
+    const auto&     soil   = Block::tryGetFromRegistry("minecraft:farmland").value();
+    std::mt19937_64 random(21);
+    std::uint64_t   planted = 0;
+    for (int x = ORIGIN; x < ORIGIN + FIELD; ++x) {
+        for (int z = ORIGIN; z < ORIGIN + FIELD; ++z) {
+            const auto stage = static_cast<std::uint16_t>(random() % 8);
+            region.setBlock(BlockPos{x, 63, z}, soil);
+            region.setBlock(
+                BlockPos{x, 64, z},
+                Block::tryGetFromRegistry(z % 2 == 0 ? "minecraft:potatoes" : "minecraft:wheat", stage).value()
+            );
+            planted += z % 2 == 0 ? 1 : 0;
+        }
+    }
+
+    // Two players share most of their chunks, the third stands at the far corner
+    world.spawnPlayers(3, 0.0);
+    world.player(0).teleport(BlockPos{ORIGIN + 24, 64, ORIGIN + 24});
+    world.player(1).teleport(BlockPos{ORIGIN + 56, 64, ORIGIN + 40});
+    world.player(2).teleport(BlockPos{ORIGIN + FIELD - 8, 64, ORIGIN + FIELD - 8});
+
+    auto&                             plugin = PotatoBoneMealBlocker::getInstance();
+    std::optional<CropCensus::Report> report;
+    const auto chunks = plugin.startCensus([&](const CropCensus::Report& result) { report = result; });
+    if (chunks == 0) {
+        std::printf("    census did not start\n");
+        return;
+    }
+
+    auto&                    executor = ll::thread::ServerThreadExecutor::getDefault();
+    std::chrono::nanoseconds longestTick{0};
+    std::uint64_t            ticks = 0;
+    while (!report && ticks < 100'000) {
+        const auto start = std::chrono::steady_clock::now();
+        executor.runTicks(1);
+        longestTick = std::max<std::chrono::nanoseconds>(longestTick, std::chrono::steady_clock::now() - start);
+        ++ticks;
+    }
+    if (!report || !report->error.empty()) {
+        std::printf("    census did not finish\n");
+        return;
+    }
+
+    // What a census that scanned every chunk within one tick would stall the server for
+    const auto           start   = std::chrono::steady_clock::now();
+    const auto&          potato  = Block::tryGetFromRegistry("minecraft:potatoes").value().getLegacyBlock();
+    const auto&          dim     = world.dimension();
+    std::uint64_t        scanned = 0;
+    std::vector<BlockPos> columns;
+    for (std::size_t i = 0; i < 3; ++i) {
+        const auto feet = world.player(i).getFeetBlockPos();
+        for (int cx = (feet.x >> 4) - 4; cx <= (feet.x >> 4) + 4; ++cx) {
+            for (int cz = (feet.z >> 4) - 4; cz <= (feet.z >> 4) + 4; ++cz) {
+                if (std::find(columns.begin(), columns.end(), BlockPos{cx, 0, cz}) == columns.end()) {
+                    columns.push_back(BlockPos{cx, 0, cz});
+                }
+            }
+        }
+    }
+    for (const auto& column : columns) {
+        for (int x = column.x * 16; x < column.x * 16 + 16; ++x) {
+            for (int z = column.z * 16; z < column.z * 16 + 16; ++z) {
+                for (int y = dim.getMinHeight(); y < dim.getHeight(); ++y) {
+                    scanned += &region.getBlock(BlockPos{x, y, z}).getLegacyBlock() == &potato ? 1 : 0;
+                }
+            }
+        }
+    }
+    const auto stall = std::chrono::steady_clock::now() - start;
+
+    const auto toMs = [](auto duration) {
+        return static_cast<double>(std::chrono::duration_cast<std::chrono::microseconds>(duration).count()) / 1000.0;
+    };
+    std::printf(
+        "%-48s %10.2f ms longest tick, %llu ticks copying, counted in %.2f ms by %zu workers\n",
+        "census/3 players, 160x160 potato and wheat field",
+        toMs(longestTick),
+        static_cast<unsigned long long>(report->snapshotTicks),
+        toMs(report->countTime),
+        report->workers
+    );
+    std::printf(
+        "    %llu crops in %zu of %zu chunks (%llu in range of %llu planted), %zu of %zu subchunks skipped by palette; "
+        "one-tick scan: %.2f ms\n",
+        static_cast<unsigned long long>(report->total),
+        report->chunksWithCrops,
+        report->chunks,
+        static_cast<unsigned long long>(scanned),
+        static_cast<unsigned long long>(planted),
+        report->skippedSubchunks,
+        report->subchunks,
+        toMs(stall)
+    );
+}
+
+/**
+ * @brief Statistics aggregation with the key set inside and far above the memory cap, then a query of the file
+ */
+void benchmarkStats() {
+    constexpr std::uint64_t iterations = 2'000'000;
+    constexpr std::int64_t  PLAYERS    = 2'000;
+    constexpr int           AREA       = 4'000; // 250x250 chunks
+
+    std::mt19937_64 random(13);
+    struct Attempt {
+        std::int64_t player;
+        int          x;
+        int          z;
+    };
+    std::vector<Attempt> attempts(1 << 16);
+    for (auto& attempt : attempts) {
+        attempt = Attempt{
+            static_cast<std::int64_t>(random() % PLAYERS),
+            static_cast<int>(random() % AREA) - AREA / 2,
+            static_cast<int>(random() % AREA) - AREA / 2
+        };
+    }
+
+    const auto path = PotatoBoneMealBlocker::getInstance().getSelf().getDataDir() / "benchmark-stats.pbbs";
+    for (const std::size_t maxKeys : {65536, 8192}) {
+        std::error_code ec;
+        std::filesystem::remove(path, ec);
+
+        BlockedStats stats;
+        if (!stats.start(path, BlockedStats::Settings{std::chrono::seconds(1), maxKeys})) {
+            std::printf("    cannot open %s\n", path.string().c_str());
+            return;
+        }
+
+        // Time advances 1 ms per attempt, so hour buckets roll over during the run
+        std::int64_t epochMs = std::int64_t{1'700'000'000'000};
+        std::string  name;
+        appendFormatted(name, "stats/record, 2k players, 62k chunks, cap {}", {maxKeys});
+        runBenchmark(name, iterations, [&](std::uint64_t i) {
+            const auto& attempt = attempts[i & (attempts.size() - 1)];
+            stats.record(attempt.player, 0, attempt.x, attempt.z, epochMs++);
+        });
+        stats.stop();
+
+        StatsReader reader;
+        if (!reader.open(path)) {
+            return;
+        }
+        std::printf(
+            "    %llu records written, %llu keys evicted, %llu updates dropped; file holds %llu player and %llu chunk "
+            "attempts\n",
+            static_cast<unsigned long long>(stats.getWrittenRecords()),
+            static_cast<unsigned long long>(stats.getEvictedKeys()),
+            static_cast<unsigned long long>(stats.getDroppedCount()),
+            static_cast<unsigned long long>(reader.total(StatsKind::PLAYER)),
+            static_cast<unsigned long long>(reader.total(StatsKind::CHUNK))
+        );
+        // Every update is either in the file or counted as dropped; within the cap nothing is dropped
+        const auto attempted = 2 * (iterations + iterations / 10);
+        const auto accounted =
+            reader.total(StatsKind::PLAYER) + reader.total(StatsKind::CHUNK) + stats.getDroppedCount();
+        if (accounted != attempted || (maxKeys == 65536 && stats.getDroppedCount() != 0)) {
+            std::printf("    FAIL: attempts went missing with the cap at %zu keys\n", maxKeys);
+            ++gFailures;
+        }
+        if (maxKeys == 65536) {
+            runBenchmark("stats/top chunks over the mapped file", 5, [&](std::uint64_t) {
+                doNotOptimize(reader.top(StatsKind::CHUNK, 0, 10));
+            });
+        }
+    }
+
+    // Six weeks of flushes: the 24-hour query must only read the tail, and find what a full scan finds
+    constexpr std::uint32_t HOURS            = 1'000;
+    constexpr std::uint32_t RECORDS_PER_HOUR = 1'000;
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        StatsHeader   header;
+        header.headerSize = sizeof(StatsHeader);
+        header.recordSize = sizeof(StatsRecord);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        std::vector<StatsRecord> records(RECORDS_PER_HOUR);
+        for (std::uint32_t hour = 0; hour < HOURS; ++hour) {
+            for (auto& record : records) {
+                record.key   = packChunkKey(0, static_cast<int>(random() % 256), static_cast<int>(random() % 256));
+                record.hour  = 400'000 + hour;
+                record.count = 1 + static_cast<std::uint32_t>(random() % 8);
+                record.kind  = StatsKind::CHUNK;
+            }
+            file.write(
+                reinterpret_cast<const char*>(records.data()),
+                static_cast<std::streamsize>(records.size() * sizeof(StatsRecord))
+            );
+        }
+    }
+    StatsReader reader;
+    if (!reader.open(path)) {
+        return;
+    }
+    const auto since = 400'000 + HOURS - 24;
+    runBenchmark("stats/top chunks, all 1000 hours", 5, [&](std::uint64_t) {
+        doNotOptimize(reader.top(StatsKind::CHUNK, 0, 10));
+    });
+    runBenchmark("stats/top chunks, last 24 of 1000 hours", 20, [&](std::uint64_t) {
+        doNotOptimize(reader.top(StatsKind::CHUNK, since, 10));
+    });
+    if (reader.top(StatsKind::CHUNK, since, 10) != reader.top(StatsKind::CHUNK, since, 10, HOURS)) {
+        std::printf("    FAIL: the windowed query missed records a full scan counts\n");
+        ++gFailures;
+    }
+}
+
+std::optional<double> parseNumber(std::string_view text) {
+    char*      end   = nullptr;
+    const auto value = std::strtod(std::string(text).c_str(), &end);
+    return end != nullptr && *end == '\0' ? std::optional<double>(value) : std::nullopt;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    // A custom mix given on the command line replaces the presets
+    Workload custom{"custom"};
+    bool     hasCustom = false;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        const std::string_view option = argv[i];
+        const auto             value  = parseNumber(argv[i + 1]);
+        if (!value) {
+            std::fprintf(stderr, "Invalid value for %s\n", argv[i]);
+            return EXIT_FAILURE;
+        }
+        hasCustom = true;
+        if (option == "--events") {
+            custom.events = static_cast<std::uint64_t>(*value);
+        } else if (option == "--bone-meal") {
+            custom.boneMealRatio = *value;
+        } else if (option == "--potato") {
+            custom.potatoRatio = *value;
+        } else if (option == "--fallback") {
+            custom.fallbackRatio = *value;
+        } else if (option == "--players") {
+            custom.players = static_cast<std::size_t>(*value);
+        } else if (option == "--staff") {
+            custom.staffRatio = *value;
+        } else {
+            std::fprintf(stderr, "Unknown option %s\n", argv[i]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    auto& plugin = PotatoBoneMealBlocker::getInstance();
+    if (!plugin.load() || !plugin.enable()) {
+        std::fprintf(stderr, "Plugin failed to enable against the mock layer\n");
+        return EXIT_FAILURE;
+    }
+
+    // Events arrive far faster than any player could click, so the presets measure the full rule path
+    // with auto-clicker detection off; benchmarkClickRate() measures it separately
+    const auto configPath = plugin.getSelf().getConfigDir() / PotatoBoneMealBlocker::CONFIG_FILE_NAME;
+    const auto original   = plugin.getConfig();
+    auto       config     = original;
+    config.clickRate.enabled = false;
+    if (!saveConfig(configPath, config) || !plugin.reloadConfig()) {
+        std::fprintf(stderr, "Could not disable auto-clicker detection\n");
+        return EXIT_FAILURE;
+    }
+
+    MockWorld world;
+    if (hasCustom) {
+        benchmarkHandler(world, custom);
+    } else {
+        benchmarkLanguage();
+        benchmarkFeedback();
+        benchmarkLogSink();
+        benchmarkHandler(world, Workload{"idle (no bone meal)", 0.0, 0.5});
+        benchmarkHandler(world, Workload{"idle, one bystander holds bone meal", 0.0, 0.5, 0.0, 20, 1'000'000, 0.0, 1});
+        benchmarkHandler(world, Workload{"farming (5% bone meal)", 0.05, 0.5});
+        benchmarkHandler(world, Workload{"raid (all bone meal on potatoes)", 1.0, 1.0});
+        benchmarkHandler(world, Workload{"raid with fallback lookups", 1.0, 1.0, 1.0});
+        benchmarkHandler(world, Workload{"bone meal on other crops", 1.0, 0.0});
+        benchmarkHandler(world, Workload{"raid with 25% exempt staff", 1.0, 1.0, 0.0, 20, 1'000'000, 0.25});
+        benchmarkClickRate(world);
+        benchmarkShadow(world);
+        benchmarkFaultBreaker(world);
+        benchmarkBlockCache(world);
+        benchmarkSchedule(world);
+
+        benchmarkGrowth();
+        benchmarkDispensers(world);
+        benchmarkReload();
+        benchmarkRegions(world);
+        benchmarkCensus(world);
+        benchmarkHostShare(world);
+        benchmarkStats();
+
+        // Same farming mix with every interaction captured to a trace
+        const auto tracePath = plugin.getSelf().getDataDir() / "benchmark.pbbt";
+        if (plugin.startCapture(tracePath)) {
+            benchmarkHandler(world, Workload{"farming with trace capture", 0.05, 0.5});
+            plugin.stopCapture();
+        }
+    }
+
+    saveConfig(configPath, original);
+    plugin.disable();
+    if (gFailures > 0) {
+        std::fprintf(stderr, "%d benchmark checks failed\n", gFailures);
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
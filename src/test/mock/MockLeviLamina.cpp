@@ -0,0 +1,157 @@
+// Registries and singletons behind the mock LeviLamina headers.
+// The block and item tables list a small vanilla subset with stable IDs.
+
+#include "ll/api/mod/NativeMod.h"
+#include "ll/api/service/Bedrock.h"
+#include "mc/world/item/ItemStack.h"
+#include "mc/world/level/BlockSource.h"
+#include "mc/world/level/block/Block.h"
+#include "mc/world/level/block/BlockLegacy.h"
+#include "mc/world/level/block/CropBlock.h"
+
+#include <deque>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+struct BlockRegistry {
+    std::vector<std::unique_ptr<BlockLegacy>> legacies;
+    std::deque<Block>                         blocks; // deque keeps Block addresses stable
+
+    BlockRegistry() {
+        struct Entry {
+            std::string_view name;
+            std::uint16_t    states;
+            bool             crop;
+        };
+        // Crops carry their growth stage in the legacy data value
+        constexpr Entry entries[] = {
+            {"minecraft:air",         1, false},
+            {"minecraft:stone",       1, false},
+            {"minecraft:dirt",        1, false},
+            {"minecraft:grass_block", 1, false},
+            {"minecraft:farmland",    8, false},
+            {"minecraft:potatoes",    8, true },
+            {"minecraft:carrots",     8, true },
+            {"minecraft:wheat",       8, true },
+            {"minecraft:beetroot",    8, true },
+            {"minecraft:oak_sapling", 2, false},
+        };
+        std::uint32_t runtimeId = 0;
+        for (const auto& entry : entries) {
+            if (entry.crop) {
+                legacies.push_back(std::make_unique<CropBlock>(std::string(entry.name)));
+            } else {
+                legacies.push_back(std::make_unique<BlockLegacy>(std::string(entry.name)));
+            }
+            for (std::uint16_t data = 0; data < entry.states; ++data) {
+                blocks.emplace_back(std::string(entry.name), data, runtimeId++, *legacies.back());
+            }
+        }
+    }
+};
+
+BlockRegistry& blockRegistry() {
+    static BlockRegistry instance;
+    return instance;
+}
+
+struct ItemEntry {
+    std::string_view name;
+    short            id;
+};
+
+constexpr ItemEntry ITEMS[] = {
+    {"minecraft:bone_meal",     411},
+    {"minecraft:wheat_seeds",   295},
+    {"minecraft:potato",        392},
+    {"minecraft:carrot",        391},
+    {"minecraft:stick",         280},
+    {"minecraft:diamond_sword", 276},
+    {"minecraft:dirt",          -3 },
+};
+
+} // namespace
+
+const ItemStack ItemStack::EMPTY_ITEM{};
+
+std::optional<ItemStack> ItemStack::create(std::string const& type, int count) {
+    for (const auto& item : ITEMS) {
+        if (item.name == type) {
+            return ItemStack(type, item.id, count);
+        }
+    }
+    return std::nullopt;
+}
+
+optional_ref<Block const> Block::tryGetFromRegistry(std::uint32_t runtimeId) {
+    auto& blocks = blockRegistry().blocks;
+    return runtimeId < blocks.size() ? optional_ref<Block const>(blocks[runtimeId]) : nullptr;
+}
+
+optional_ref<Block const> Block::tryGetFromRegistry(std::string_view name) { return tryGetFromRegistry(name, 0); }
+
+optional_ref<Block const> Block::tryGetFromRegistry(std::string_view name, std::uint16_t legacyData) {
+    for (const auto& block : blockRegistry().blocks) {
+        if (block.getTypeName() == name && block.getData() == legacyData) {
+            return block;
+        }
+    }
+    return nullptr;
+}
+
+Block const& BlockSource::getBlock(BlockPos const& pos) const {
+    ++mLookups;
+    if (mBroken) {
+        throw std::runtime_error("BlockSource::getBlock is broken");
+    }
+    const auto it = mBlocks.find(key(pos));
+    return it == mBlocks.end() ? blockRegistry().blocks.front() : *it->second;
+}
+
+void BlockSource::setBlock(BlockPos const& pos, Block const& block) { mBlocks[key(pos)] = &block; }
+
+void CropBlock::$randomTick(BlockSource& region, BlockPos const& pos, Random&) const {
+    const auto& block = region.getBlock(pos);
+    if (&block.getLegacyBlock() != this || block.getData() >= 7) {
+        return;
+    }
+    // Growth stages of a crop have consecutive runtime IDs in the mock registry
+    region.setBlock(pos, Block::tryGetFromRegistry(block.getRuntimeId() + 1).value());
+}
+
+bool CropBlock::$onFertilized(BlockSource& region, BlockPos const& pos, Actor*, FertilizerType) const {
+    const auto& block = region.getBlock(pos);
+    if (&block.getLegacyBlock() != this || block.getData() >= 7) {
+        return false;
+    }
+    region.setBlock(pos, Block::tryGetFromRegistry(block.getRuntimeId() + 1).value());
+    return true;
+}
+
+namespace ll::mod {
+
+NativeMod::NativeMod(std::string name)
+: mName(std::move(name)),
+  mModDir(std::filesystem::temp_directory_path() / "potato-bonemeal-blocker-mock") {
+    std::filesystem::create_directories(getDataDir());
+    std::filesystem::create_directories(getConfigDir());
+}
+
+NativeMod* NativeMod::current() {
+    static NativeMod instance("PotatoBoneMealBlocker");
+    return &instance;
+}
+
+} // namespace ll::mod
+
+namespace ll::service {
+
+optional_ref<Level> getLevel() {
+    static Level level;
+    return level;
+}
+
+} // namespace ll::service
@@ -0,0 +1,30 @@
+#pragma once
+
+// Mock of LeviLamina's optional_ref<T> for the Linux benchmark build
+
+#include <stdexcept>
+
+template <class T>
+class optional_ref {
+public:
+    constexpr optional_ref() noexcept = default;
+    constexpr optional_ref(std::nullptr_t) noexcept {}
+    constexpr optional_ref(T& value) noexcept : mPtr(&value) {}
+    constexpr optional_ref(T* value) noexcept : mPtr(value) {}
+
+    [[nodiscard]] constexpr bool has_value() const noexcept { return mPtr != nullptr; }
+    constexpr explicit operator bool() const noexcept { return has_value(); }
+
+    [[nodiscard]] constexpr T& value() const {
+        if (!mPtr) {
+            throw std::runtime_error("bad optional_ref access");
+        }
+        return *mPtr;
+    }
+    constexpr T& operator*() const noexcept { return *mPtr; }
+    constexpr T* operator->() const noexcept { return mPtr; }
+    [[nodiscard]] constexpr T* as_ptr() const noexcept { return mPtr; }
+
+private:
+    T* mPtr = nullptr;
+};
@@ -0,0 +1,13 @@
+#pragma once
+
+// Mock of LeviLamina's game-tick durations for the Linux benchmark build
+
+#include <chrono>
+#include <cstdint>
+#include <ratio>
+
+namespace ll::chrono {
+
+using ticks = std::chrono::duration<std::int64_t, std::ratio<1, 20>>;
+
+} // namespace ll::chrono
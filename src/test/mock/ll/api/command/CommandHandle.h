@@ -0,0 +1,73 @@
+#pragma once
+
+// Mock of LeviLamina's command builder for the Linux benchmark build.
+// Overloads record their literal path and handler so harnesses can invoke them.
+
+#include "mc/server/commands/CommandOrigin.h"
+#include "mc/server/commands/CommandOutput.h"
+
+#include <functional>
+#include <type_traits>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ll::command {
+
+class CommandHandle;
+
+class Overload {
+public:
+    explicit Overload(CommandHandle& handle) : mHandle(&handle) {}
+
+    Overload& text(std::string_view literal) {
+        mPath += mPath.empty() ? "" : " ";
+        mPath += literal;
+        return *this;
+    }
+    Overload& required(std::string_view) { return *this; }
+    Overload& optional(std::string_view) { return *this; }
+
+    template <class F>
+    Overload& execute(F&& fn);
+
+private:
+    CommandHandle* mHandle;
+    std::string    mPath;
+};
+
+class CommandHandle {
+public:
+    using Handler = std::function<void(CommandOrigin const&, CommandOutput&)>;
+
+    template <class Params = void>
+    Overload overload() {
+        return Overload{*this};
+    }
+
+    /// Invoke a registered overload by its literal path, e.g. "stats"
+    bool invoke(std::string_view path, CommandOrigin const& origin, CommandOutput& output) const {
+        for (const auto& [overloadPath, handler] : mHandlers) {
+            if (overloadPath == path) {
+                handler(origin, output);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void addHandler(std::string path, Handler handler) { mHandlers.emplace_back(std::move(path), std::move(handler)); }
+
+private:
+    std::vector<std::pair<std::string, Handler>> mHandlers;
+};
+
+template <class F>
+Overload& Overload::execute(F&& fn) {
+    if constexpr (std::is_invocable_v<F, CommandOrigin const&, CommandOutput&>) {
+        mHandle->addHandler(mPath, std::forward<F>(fn));
+    }
+    return *this;
+}
+
+} // namespace ll::command
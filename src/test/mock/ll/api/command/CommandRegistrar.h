@@ -0,0 +1,33 @@
+#pragma once
+
+// Mock of LeviLamina's command registrar for the Linux benchmark build
+
+#include "ll/api/command/CommandHandle.h"
+#include "mc/server/commands/CommandPermissionLevel.h"
+
+#include <map>
+#include <string>
+
+namespace ll::command {
+
+class CommandRegistrar {
+public:
+    static CommandRegistrar& getInstance() {
+        static CommandRegistrar instance;
+        return instance;
+    }
+
+    CommandHandle& getOrCreateCommand(
+        std::string const& name,
+        std::string const& description = {},
+        CommandPermissionLevel         = CommandPermissionLevel::Any
+    ) {
+        (void)description;
+        return mCommands[name];
+    }
+
+private:
+    std::map<std::string, CommandHandle> mCommands;
+};
+
+} // namespace ll::command
@@ -0,0 +1,81 @@
+#pragma once
+
+// Mock of LeviLamina's coroutine tasks for the Linux benchmark build.
+// Launched coroutines are stepped by ServerThreadExecutor::runTicks(); a
+// co_await on a tick duration suspends the coroutine for that many ticks.
+
+#include "ll/api/chrono/GameChrono.h"
+#include "ll/api/thread/ServerThreadExecutor.h"
+
+#include <chrono>
+#include <coroutine>
+#include <exception>
+#include <memory>
+#include <utility>
+
+namespace ll::coro {
+
+template <class T = void>
+class CoroTask {
+public:
+    struct promise_type {
+        std::int64_t waitTicks = 0;
+
+        CoroTask get_return_object() noexcept {
+            return CoroTask{std::coroutine_handle<promise_type>::from_promise(*this)};
+        }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        void                return_void() noexcept {}
+        void                unhandled_exception() noexcept { std::terminate(); }
+
+        template <class Rep, class Period>
+        std::suspend_always await_transform(std::chrono::duration<Rep, Period> duration) noexcept {
+            waitTicks = std::chrono::ceil<chrono::ticks>(duration).count();
+            return {};
+        }
+    };
+
+    explicit CoroTask(std::coroutine_handle<promise_type> handle) noexcept : mHandle(handle) {}
+    CoroTask(CoroTask&& other) noexcept
+    : mHandle(std::exchange(other.mHandle, {})),
+      mKeepAlive(std::move(other.mKeepAlive)) {}
+    CoroTask(const CoroTask&) = delete;
+    ~CoroTask() {
+        if (mHandle) {
+            mHandle.destroy();
+        }
+    }
+
+    /// Keep an object (the coroutine lambda and its captures) alive as long as the coroutine
+    void keepAlive(std::shared_ptr<void> object) noexcept { mKeepAlive = std::move(object); }
+
+    void launch(thread::ServerThreadExecutor const& executor) && {
+        executor.schedule([handle = std::exchange(mHandle, {}), keepAlive = std::move(mKeepAlive)]() {
+            if (--handle.promise().waitTicks > 0) {
+                return true;
+            }
+            handle.resume();
+            if (handle.done()) {
+                handle.destroy();
+                return false;
+            }
+            return true;
+        });
+    }
+
+private:
+    std::coroutine_handle<promise_type> mHandle;
+    std::shared_ptr<void>               mKeepAlive;
+};
+
+template <class F>
+auto keepThis(F&& fn) {
+    // The coroutine frame refers to the lambda's captures, so the lambda must outlive it
+    auto owned = std::make_shared<std::decay_t<F>>(std::forward<F>(fn));
+    auto task  = (*owned)();
+    task.keepAlive(std::move(owned));
+    return task;
+}
+
+} // namespace ll::coro
@@ -0,0 +1,22 @@
+#pragma once
+
+// Mock of LeviLamina's event base classes for the Linux benchmark build
+
+namespace ll::event {
+
+class Event {
+public:
+    virtual ~Event() = default;
+};
+
+class Cancellable {
+public:
+    void cancel() noexcept { mCancelled = true; }
+    void setCancelled(bool cancelled = true) noexcept { mCancelled = cancelled; }
+    [[nodiscard]] bool isCancelled() const noexcept { return mCancelled; }
+
+private:
+    bool mCancelled = false;
+};
+
+} // namespace ll::event
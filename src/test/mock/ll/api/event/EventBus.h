@@ -0,0 +1,62 @@
+#pragma once
+
+// Mock of LeviLamina's EventBus for the Linux benchmark build.
+// Dispatch mirrors the real bus closely enough to measure listener overhead:
+// a lookup by event type followed by a virtual call per listener.
+
+#include "ll/api/event/ListenerBase.h"
+
+#include <algorithm>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+namespace ll::event {
+
+class EventBus {
+public:
+    static EventBus& getInstance() {
+        static EventBus instance;
+        return instance;
+    }
+
+    template <class E, class F>
+    ListenerPtr emplaceListener(F&& fn) {
+        auto listener = std::make_shared<Listener<E>>(std::function<void(E&)>(std::forward<F>(fn)));
+        mListeners[typeid(E)].push_back(listener);
+        return listener;
+    }
+
+    bool removeListener(ListenerPtr const& listener) {
+        for (auto& [type, listeners] : mListeners) {
+            const auto it = std::find(listeners.begin(), listeners.end(), listener);
+            if (it != listeners.end()) {
+                listeners.erase(it);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    template <class E>
+    void publish(E& event) {
+        const auto it = mListeners.find(typeid(E));
+        if (it == mListeners.end()) {
+            return;
+        }
+        for (const auto& listener : it->second) {
+            listener->call(event);
+        }
+    }
+
+    template <class E>
+    [[nodiscard]] std::size_t getListenerCount() const {
+        const auto it = mListeners.find(typeid(E));
+        return it == mListeners.end() ? 0 : it->second.size();
+    }
+
+private:
+    std::unordered_map<std::type_index, std::vector<ListenerPtr>> mListeners;
+};
+
+} // namespace ll::event
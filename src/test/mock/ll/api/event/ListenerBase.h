@@ -0,0 +1,31 @@
+#pragma once
+
+// Mock of LeviLamina's listener handles for the Linux benchmark build
+
+#include "ll/api/event/Event.h"
+
+#include <functional>
+#include <memory>
+
+namespace ll::event {
+
+class ListenerBase {
+public:
+    virtual ~ListenerBase()          = default;
+    virtual void call(Event& event) = 0;
+};
+
+using ListenerPtr = std::shared_ptr<ListenerBase>;
+
+template <class E>
+class Listener final : public ListenerBase {
+public:
+    explicit Listener(std::function<void(E&)> fn) : mFn(std::move(fn)) {}
+
+    void call(Event& event) override { mFn(static_cast<E&>(event)); }
+
+private:
+    std::function<void(E&)> mFn;
+};
+
+} // namespace ll::event
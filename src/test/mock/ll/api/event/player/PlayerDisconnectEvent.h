@@ -0,0 +1,20 @@
+#pragma once
+
+// Mock of LeviLamina's PlayerDisconnectEvent for the Linux benchmark build
+
+#include "ll/api/event/Event.h"
+#include "mc/world/actor/player/Player.h"
+
+namespace ll::event {
+
+class PlayerDisconnectEvent final : public Event {
+public:
+    explicit PlayerDisconnectEvent(Player& player) : mPlayer(player) {}
+
+    [[nodiscard]] Player& self() const { return mPlayer; }
+
+private:
+    Player& mPlayer;
+};
+
+} // namespace ll::event
@@ -0,0 +1,45 @@
+#pragma once
+
+// Mock of LeviLamina's PlayerInteractBlockEvent for the Linux benchmark build
+
+#include "ll/api/base/OptionalRef.h"
+#include "ll/api/event/Event.h"
+#include "mc/world/actor/player/Player.h"
+#include "mc/world/item/ItemStack.h"
+#include "mc/world/level/BlockPos.h"
+#include "mc/world/level/block/Block.h"
+
+#include <cstdint>
+
+namespace ll::event {
+
+class PlayerInteractBlockEvent final : public Event, public Cancellable {
+public:
+    PlayerInteractBlockEvent(
+        Player&                   player,
+        ItemStack const&          item,
+        BlockPos const&           pos,
+        std::uint8_t              face,
+        optional_ref<Block const> block
+    )
+    : mPlayer(player),
+      mItem(item),
+      mPos(pos),
+      mFace(face),
+      mBlock(block) {}
+
+    [[nodiscard]] Player&                   self() const { return mPlayer; }
+    [[nodiscard]] ItemStack const&          item() const { return mItem; }
+    [[nodiscard]] BlockPos const&           blockPos() const { return mPos; }
+    [[nodiscard]] std::uint8_t const&       face() const { return mFace; }
+    [[nodiscard]] optional_ref<Block const> block() const { return mBlock; }
+
+private:
+    Player&                   mPlayer;
+    ItemStack const&          mItem;
+    BlockPos                  mPos;
+    std::uint8_t              mFace;
+    optional_ref<Block const> mBlock;
+};
+
+} // namespace ll::event
@@ -0,0 +1,20 @@
+#pragma once
+
+// Mock of LeviLamina's PlayerJoinEvent for the Linux benchmark build
+
+#include "ll/api/event/Event.h"
+#include "mc/world/actor/player/Player.h"
+
+namespace ll::event {
+
+class PlayerJoinEvent final : public Event {
+public:
+    explicit PlayerJoinEvent(Player& player) : mPlayer(player) {}
+
+    [[nodiscard]] Player& self() const { return mPlayer; }
+
+private:
+    Player& mPlayer;
+};
+
+} // namespace ll::event
@@ -0,0 +1,24 @@
+#pragma once
+
+// Mock of LeviLamina's block placement events for the Linux benchmark build
+
+#include "ll/api/event/Event.h"
+#include "mc/world/actor/player/Player.h"
+#include "mc/world/level/BlockPos.h"
+
+namespace ll::event {
+
+/// Fired after a player placed a block
+class PlayerPlacedBlockEvent final : public Event {
+public:
+    PlayerPlacedBlockEvent(Player& player, BlockPos const& pos) : mPlayer(player), mPos(pos) {}
+
+    [[nodiscard]] Player&         self() const { return mPlayer; }
+    [[nodiscard]] BlockPos const& pos() const { return mPos; }
+
+private:
+    Player&  mPlayer;
+    BlockPos mPos;
+};
+
+} // namespace ll::event
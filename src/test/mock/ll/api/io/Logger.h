@@ -0,0 +1,67 @@
+#pragma once
+
+// Mock of LeviLamina's logger for the Linux benchmark build.
+// Lines are counted and only printed when echo is enabled.
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <sstream>
+#include <string>
+#include <string_view>
+
+namespace ll::io {
+
+class Logger {
+public:
+    template <class... Args>
+    void info(std::string_view fmt, Args&&... args) {
+        write("INFO", fmt, std::forward<Args>(args)...);
+    }
+    template <class... Args>
+    void warn(std::string_view fmt, Args&&... args) {
+        write("WARN", fmt, std::forward<Args>(args)...);
+    }
+    template <class... Args>
+    void error(std::string_view fmt, Args&&... args) {
+        write("ERROR", fmt, std::forward<Args>(args)...);
+    }
+    template <class... Args>
+    void debug(std::string_view fmt, Args&&... args) {
+        write("DEBUG", fmt, std::forward<Args>(args)...);
+    }
+
+    void setEcho(bool echo) noexcept { mEcho.store(echo); }
+
+    [[nodiscard]] std::uint64_t getLineCount() const noexcept { return mLines.load(); }
+
+private:
+    template <class... Args>
+    void write(std::string_view level, std::string_view fmt, Args&&... args) {
+        mLines.fetch_add(1, std::memory_order_relaxed);
+        if (!mEcho.load(std::memory_order_relaxed)) {
+            return;
+        }
+        std::ostringstream out;
+        out << level << ' ';
+        ((fmt = emit(out, fmt), out << args), ...);
+        out << fmt;
+        std::fprintf(stderr, "%s\n", out.str().c_str());
+    }
+
+    // Writes the text before the next "{}" and returns the remainder
+    static std::string_view emit(std::ostringstream& out, std::string_view fmt) {
+        const auto placeholder = fmt.find("{}");
+        if (placeholder == std::string_view::npos) {
+            out << fmt;
+            return {};
+        }
+        out << fmt.substr(0, placeholder);
+        return fmt.substr(placeholder + 2);
+    }
+
+    std::atomic<bool>          mEcho{false};
+    std::atomic<std::uint64_t> mLines{0};
+};
+
+} // namespace ll::io
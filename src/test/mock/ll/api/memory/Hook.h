@@ -0,0 +1,80 @@
+#pragma once
+
+// Mock of LeviLamina's function hooks for the Linux benchmark build.
+// Hookable mock functions dispatch through HookSlot<&Type::$function> instead of
+// patching machine code; only the instance-hook macro used by the plugin exists.
+
+#include <utility>
+
+namespace ll::memory {
+
+enum class HookPriority : int {
+    Highest = 0,
+    High    = 100,
+    Normal  = 200,
+    Low     = 300,
+    Lowest  = 400,
+};
+
+namespace mock {
+
+template <auto Target>
+struct HookSlot;
+
+template <class Class, class Ret, class... Args, Ret (Class::*Target)(Args...) const>
+struct HookSlot<Target> {
+    using Detour = Ret (*)(Class const*, Args...);
+
+    static inline Detour detour = nullptr;
+
+    template <class Hook, auto HookFn>
+    static bool install() {
+        detour = [](Class const* self, Args... args) -> Ret {
+            return (const_cast<Hook*>(static_cast<Hook const*>(self))->*HookFn)(std::forward<Args>(args)...);
+        };
+        return true;
+    }
+
+    static bool uninstall() {
+        detour = nullptr;
+        return true;
+    }
+};
+
+template <class Class, class Ret, class... Args, Ret (Class::*Target)(Args...)>
+struct HookSlot<Target> {
+    using Detour = Ret (*)(Class*, Args...);
+
+    static inline Detour detour = nullptr;
+
+    template <class Hook, auto HookFn>
+    static bool install() {
+        detour = [](Class* self, Args... args) -> Ret {
+            return (static_cast<Hook*>(self)->*HookFn)(std::forward<Args>(args)...);
+        };
+        return true;
+    }
+
+    static bool uninstall() {
+        detour = nullptr;
+        return true;
+    }
+};
+
+} // namespace mock
+
+} // namespace ll::memory
+
+#define LL_TYPE_INSTANCE_HOOK(DEF_TYPE, PRIORITY, TYPE, IDENTIFIER, RET_TYPE, ...)                                     \
+    struct DEF_TYPE : public TYPE {                                                                                    \
+        static bool hook() {                                                                                           \
+            return ::ll::memory::mock::HookSlot<IDENTIFIER>::template install<DEF_TYPE, &DEF_TYPE::detour>();          \
+        }                                                                                                              \
+        static bool unhook() { return ::ll::memory::mock::HookSlot<IDENTIFIER>::uninstall(); }                       \
+        template <class... Args>                                                                                       \
+        RET_TYPE origin(Args&&... args) {                                                                              \
+            return (this->*IDENTIFIER)(std::forward<Args>(args)...);                                                   \
+        }                                                                                                              \
+        RET_TYPE detour(__VA_ARGS__);                                                                                  \
+    };                                                                                                                 \
+    RET_TYPE DEF_TYPE::detour(__VA_ARGS__)
@@ -0,0 +1,32 @@
+#pragma once
+
+// Mock of LeviLamina's NativeMod for the Linux benchmark build.
+// Directories live under the system temporary directory.
+
+#include "ll/api/io/Logger.h"
+
+#include <filesystem>
+#include <string>
+
+namespace ll::mod {
+
+class NativeMod {
+public:
+    explicit NativeMod(std::string name);
+
+    static NativeMod* current();
+
+    [[nodiscard]] std::string const&           getName() const { return mName; }
+    [[nodiscard]] io::Logger&                  getLogger() const { return mLogger; }
+    [[nodiscard]] std::filesystem::path const& getModDir() const { return mModDir; }
+    [[nodiscard]] std::filesystem::path        getDataDir() const { return mModDir / "data"; }
+    [[nodiscard]] std::filesystem::path        getConfigDir() const { return mModDir / "config"; }
+    [[nodiscard]] std::filesystem::path        getLangDir() const { return mModDir / "lang"; }
+
+private:
+    std::string           mName;
+    std::filesystem::path mModDir;
+    mutable io::Logger    mLogger;
+};
+
+} // namespace ll::mod
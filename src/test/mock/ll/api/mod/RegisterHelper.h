@@ -0,0 +1,5 @@
+#pragma once
+
+// Mock of LeviLamina's mod registration helper: the benchmark drives the mod directly
+
+#define LL_REGISTER_MOD(CLAZZ, BUILDER)
@@ -0,0 +1,13 @@
+#pragma once
+
+// Mock of LeviLamina's service accessors for the Linux benchmark build
+
+#include "ll/api/base/OptionalRef.h"
+#include "mc/world/level/Level.h"
+
+namespace ll::service {
+
+/// Returns the process-wide mock level
+optional_ref<Level> getLevel();
+
+} // namespace ll::service
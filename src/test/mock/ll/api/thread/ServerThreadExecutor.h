@@ -0,0 +1,43 @@
+#pragma once
+
+// Mock of LeviLamina's server thread executor for the Linux benchmark build.
+// There is no game loop: harnesses advance time with runTicks(), which steps
+// every launched coroutine whose wait has elapsed.
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace ll::thread {
+
+class ServerThreadExecutor {
+public:
+    /// One scheduled coroutine; called once per tick, returns false when it has finished
+    using Step = std::function<bool()>;
+
+    static ServerThreadExecutor const& getDefault() {
+        static ServerThreadExecutor instance;
+        return instance;
+    }
+
+    void schedule(Step step) const { mSteps.push_back(std::move(step)); }
+
+    /// Harness entry point: run a number of game ticks
+    void runTicks(std::uint64_t count) const {
+        for (std::uint64_t tick = 0; tick < count; ++tick) {
+            // Steps scheduled during this tick start on the next one
+            const auto scheduled = mSteps.size();
+            for (std::size_t i = 0; i < scheduled; ++i) {
+                if (mSteps[i] && !mSteps[i]()) {
+                    mSteps[i] = nullptr;
+                }
+            }
+            std::erase_if(mSteps, [](const Step& step) { return !step; });
+        }
+    }
+
+private:
+    mutable std::vector<Step> mSteps;
+};
+
+} // namespace ll::thread
@@ -0,0 +1,14 @@
+#pragma once
+
+// Mock of the Bedrock ActorUniqueID for the Linux benchmark build
+
+#include <cstdint>
+
+struct ActorUniqueID {
+    std::int64_t id = -1;
+
+    constexpr ActorUniqueID() noexcept = default;
+    constexpr explicit ActorUniqueID(std::int64_t value) noexcept : id(value) {}
+
+    constexpr bool operator==(const ActorUniqueID&) const noexcept = default;
+};
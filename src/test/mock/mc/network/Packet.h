@@ -0,0 +1,13 @@
+#pragma once
+
+// Mock of the Bedrock Packet base for the Linux benchmark build
+
+#include <string>
+
+class Packet {
+public:
+    virtual ~Packet() = default;
+
+    /// Stand-in for serialization into a BinaryStream, done by the network system on every send
+    virtual void write(std::string& stream) const = 0;
+};
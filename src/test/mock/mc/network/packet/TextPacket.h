@@ -0,0 +1,45 @@
+#pragma once
+
+// Mock of the Bedrock TextPacket for the Linux benchmark build
+
+#include "mc/network/Packet.h"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+enum class TextPacketType : std::uint8_t {
+    Raw = 0,
+};
+
+class TextPacket : public Packet {
+public:
+    /// Same fields as the game's packet, so building one costs what it does in game
+    static TextPacket createRawMessage(std::string_view message) {
+        TextPacket packet;
+        packet.mType    = TextPacketType::Raw;
+        packet.mMessage = std::string(message);
+        return packet;
+    }
+
+    void write(std::string& stream) const override {
+        stream.push_back(static_cast<char>(mType));
+        stream.append(mAuthor);
+        stream.append(mMessage);
+        for (const auto& param : mParams) {
+            stream.append(param);
+        }
+        stream.push_back(static_cast<char>(mLocalize));
+        stream.append(mXuid);
+        stream.append(mPlatformId);
+    }
+
+    TextPacketType           mType = TextPacketType::Raw;
+    std::string              mAuthor;
+    std::string              mMessage;
+    std::vector<std::string> mParams;
+    bool                     mLocalize = false;
+    std::string              mXuid;
+    std::string              mPlatformId;
+};
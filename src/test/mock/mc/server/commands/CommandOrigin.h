@@ -0,0 +1,12 @@
+#pragma once
+
+// Mock of the Bedrock CommandOrigin for the Linux benchmark build
+
+class Actor;
+
+class CommandOrigin {
+public:
+    virtual ~CommandOrigin() = default;
+
+    [[nodiscard]] virtual Actor* getEntity() const { return nullptr; }
+};
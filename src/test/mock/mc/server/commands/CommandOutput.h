@@ -0,0 +1,22 @@
+#pragma once
+
+// Mock of the Bedrock CommandOutput for the Linux benchmark build
+
+#include <string>
+#include <vector>
+
+class CommandOutput {
+public:
+    void success(std::string const& message) { mLines.push_back(message); }
+    void error(std::string const& message) {
+        mLines.push_back(message);
+        mSuccess = false;
+    }
+
+    [[nodiscard]] std::vector<std::string> const& getLines() const noexcept { return mLines; }
+    [[nodiscard]] bool                            isSuccess() const noexcept { return mSuccess; }
+
+private:
+    std::vector<std::string> mLines;
+    bool                     mSuccess = true;
+};
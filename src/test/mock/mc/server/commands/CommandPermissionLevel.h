@@ -0,0 +1,12 @@
+#pragma once
+
+// Mock of the Bedrock command permission levels for the Linux benchmark build
+
+enum class CommandPermissionLevel : signed char {
+    Any           = 0,
+    GameDirectors = 1,
+    Admin         = 2,
+    Host          = 3,
+    Owner         = 4,
+    Internal      = 5,
+};
@@ -0,0 +1,20 @@
+#pragma once
+
+// Mock of the Bedrock Random for the Linux benchmark build
+
+#include <cstdint>
+
+class Random {
+public:
+    explicit Random(std::uint32_t seed = 1) noexcept : mState(seed == 0 ? 1 : seed) {}
+
+    std::uint32_t nextInt() noexcept {
+        mState ^= mState << 13;
+        mState ^= mState >> 17;
+        mState ^= mState << 5;
+        return mState;
+    }
+
+private:
+    std::uint32_t mState;
+};
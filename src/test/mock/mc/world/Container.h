@@ -0,0 +1,5 @@
+#pragma once
+
+// Mock of the Bedrock Container for the Linux benchmark build; only passed by reference to listeners
+
+class Container {};
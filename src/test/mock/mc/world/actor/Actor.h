@@ -0,0 +1,10 @@
+#pragma once
+
+// Mock of the Bedrock Actor for the Linux benchmark build
+
+class Actor {
+public:
+    virtual ~Actor() = default;
+
+    [[nodiscard]] virtual bool isPlayer() const { return false; }
+};
@@ -0,0 +1,101 @@
+#pragma once
+
+// Mock of the Bedrock Player for the Linux benchmark build
+
+#include "ll/api/memory/Hook.h"
+#include "mc/legacy/ActorUniqueID.h"
+#include "mc/world/actor/Actor.h"
+#include "mc/network/packet/TextPacket.h"
+#include "mc/server/commands/CommandPermissionLevel.h"
+#include "mc/world/Container.h"
+#include "mc/world/item/ItemStack.h"
+#include "mc/world/level/BlockPos.h"
+#include "mc/world/level/dimension/Dimension.h"
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+
+class Player : public Actor {
+public:
+    Player(std::string name, std::int64_t uniqueId, Dimension& dimension)
+    : mName(std::move(name)),
+      mUniqueId(uniqueId),
+      mDimension(&dimension) {}
+
+    [[nodiscard]] bool isPlayer() const override { return true; }
+
+    [[nodiscard]] std::string const&   getRealName() const { return mName; }
+    [[nodiscard]] std::string          getXuid() const { return std::to_string(2535400000000000 + mUniqueId.id); }
+    [[nodiscard]] ActorUniqueID const& getOrCreateUniqueID() const { return mUniqueId; }
+    [[nodiscard]] DimensionType        getDimensionId() const { return mDimension->getDimensionId(); }
+    [[nodiscard]] Dimension&           getDimension() const { return *mDimension; }
+    [[nodiscard]] BlockPos             getFeetBlockPos() const { return mPosition; }
+
+    /// Harness helper standing in for movement
+    void teleport(BlockPos const& pos) { mPosition = pos; }
+
+    [[nodiscard]] CommandPermissionLevel getCommandPermissionLevel() const { return mPermissionLevel; }
+    void                                 setCommandPermissionLevel(CommandPermissionLevel level) { mPermissionLevel = level; }
+
+    [[nodiscard]] ItemStack const& getSelectedItem() const { return mHotbar[mSelectedSlot]; }
+    [[nodiscard]] int              getSelectedItemSlot() const { return mSelectedSlot; }
+
+    /// Vanilla behaviour: select a hotbar slot
+    ItemStack const& setSelectedSlot(int slot) {
+        mSelectedSlot = slot;
+        return mHotbar[mSelectedSlot];
+    }
+
+    /// Vanilla behaviour: inventory listener callback, nothing to do in the mock
+    void $inventoryChanged(Container&, int, ItemStack const&, ItemStack const&, bool) {}
+
+    /// Entry point used by harnesses in place of a hotbar packet, honours installed hooks
+    void selectSlot(int slot) {
+        if (const auto detour = ll::memory::mock::HookSlot<&Player::setSelectedSlot>::detour) {
+            detour(this, slot);
+            return;
+        }
+        setSelectedSlot(slot);
+    }
+
+    /// Entry point used by harnesses in place of inventory transactions, honours installed hooks
+    void setHotbarItem(int slot, ItemStack item) {
+        const auto oldItem = std::exchange(mHotbar[slot], std::move(item));
+        if (const auto detour = ll::memory::mock::HookSlot<&Player::$inventoryChanged>::detour) {
+            detour(this, mInventory, slot, oldItem, mHotbar[slot], false);
+            return;
+        }
+        $inventoryChanged(mInventory, slot, oldItem, mHotbar[slot], false);
+    }
+
+    /// LeviLamina builds a raw TextPacket for every message
+    void sendMessage(std::string_view message) {
+        auto packet = TextPacket::createRawMessage(message);
+        sendNetworkPacket(packet);
+    }
+
+    /// Serializes the packet into a reused buffer, as the network system does on every send
+    void sendNetworkPacket(Packet& packet) const {
+        ++mPacketsReceived;
+        mStream.clear();
+        packet.write(mStream);
+    }
+
+    /// Number of packets sent to this player, used by benchmarks
+    [[nodiscard]] std::uint64_t getPacketsReceived() const noexcept { return mPacketsReceived; }
+
+private:
+    std::string              mName;
+    ActorUniqueID            mUniqueId;
+    Dimension*               mDimension;
+    BlockPos                 mPosition{0, 64, 0};
+    std::array<ItemStack, 9> mHotbar;
+    int                      mSelectedSlot = 0;
+    Container                mInventory;
+    CommandPermissionLevel   mPermissionLevel = CommandPermissionLevel::Any;
+    mutable std::uint64_t    mPacketsReceived = 0;
+    mutable std::string      mStream;
+};
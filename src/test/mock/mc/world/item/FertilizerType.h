@@ -0,0 +1,9 @@
+#pragma once
+
+// Mock of the Bedrock FertilizerType for the Linux benchmark build
+
+enum class FertilizerType : int {
+    None     = 0,
+    Bonemeal = 1,
+    Rapid    = 2,
+};
@@ -0,0 +1,28 @@
+#pragma once
+
+// Mock of the Bedrock ItemStack for the Linux benchmark build
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+class ItemStack {
+public:
+    ItemStack() = default;
+    ItemStack(std::string typeName, short id, int count) : mTypeName(std::move(typeName)), mId(id), mCount(count) {}
+
+    static std::optional<ItemStack> create(std::string const& type, int count = 1);
+
+    [[nodiscard]] short       getId() const { return mId; }
+    [[nodiscard]] std::string getTypeName() const { return mTypeName; }
+    [[nodiscard]] bool        isNull() const { return mId == 0 || mCount == 0; }
+    [[nodiscard]] int         getCount() const { return mCount; }
+
+    static const ItemStack EMPTY_ITEM;
+
+private:
+    std::string mTypeName = "minecraft:air";
+    short       mId       = 0;
+    int         mCount    = 0;
+};
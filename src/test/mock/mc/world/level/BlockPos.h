@@ -0,0 +1,15 @@
+#pragma once
+
+// Mock of the Bedrock BlockPos for the Linux benchmark build
+
+class BlockPos {
+public:
+    int x = 0;
+    int y = 0;
+    int z = 0;
+
+    constexpr BlockPos() noexcept = default;
+    constexpr BlockPos(int px, int py, int pz) noexcept : x(px), y(py), z(pz) {}
+
+    constexpr bool operator==(const BlockPos&) const noexcept = default;
+};
@@ -0,0 +1,40 @@
+#pragma once
+
+// Mock of the Bedrock BlockSource for the Linux benchmark build
+
+#include "mc/world/level/BlockPos.h"
+#include "mc/world/level/block/Block.h"
+#include "mc/world/level/dimension/DimensionType.h"
+
+#include <cstdint>
+#include <stdexcept>
+#include <unordered_map>
+
+class BlockSource {
+public:
+    explicit BlockSource(DimensionType dimension = 0) noexcept : mDimension(dimension) {}
+
+    [[nodiscard]] DimensionType getDimensionId() const noexcept { return mDimension; }
+
+    [[nodiscard]] Block const& getBlock(BlockPos const& pos) const;
+
+    void setBlock(BlockPos const& pos, Block const& block);
+
+    /// Number of getBlock() calls, used by benchmarks to verify cache behaviour
+    [[nodiscard]] std::uint64_t getLookupCount() const noexcept { return mLookups; }
+
+    /// Make getBlock() throw, standing in for an API broken by a game update
+    void setBroken(bool broken) noexcept { mBroken = broken; }
+
+private:
+    static std::uint64_t key(BlockPos const& pos) noexcept {
+        return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(pos.x)) << 36)
+             ^ (static_cast<std::uint64_t>(static_cast<std::uint32_t>(pos.z)) << 12)
+             ^ static_cast<std::uint64_t>(static_cast<std::uint32_t>(pos.y));
+    }
+
+    DimensionType                                   mDimension;
+    std::unordered_map<std::uint64_t, Block const*> mBlocks;
+    mutable std::uint64_t                           mLookups = 0;
+    bool                                            mBroken  = false;
+};
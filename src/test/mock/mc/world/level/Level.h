@@ -0,0 +1,31 @@
+#pragma once
+
+// Mock of the Bedrock Level for the Linux benchmark build
+
+#include "mc/legacy/ActorUniqueID.h"
+#include "mc/world/actor/player/Player.h"
+
+#include <functional>
+#include <unordered_map>
+
+class Level {
+public:
+    [[nodiscard]] Player* getPlayer(ActorUniqueID const& id) const {
+        const auto it = mPlayers.find(id.id);
+        return it == mPlayers.end() ? nullptr : it->second;
+    }
+
+    void forEachPlayer(std::function<bool(Player&)> callback) const {
+        for (const auto& [id, player] : mPlayers) {
+            if (!callback(*player)) {
+                return;
+            }
+        }
+    }
+
+    void addPlayer(Player& player) { mPlayers[player.getOrCreateUniqueID().id] = &player; }
+    void removePlayer(Player& player) { mPlayers.erase(player.getOrCreateUniqueID().id); }
+
+private:
+    std::unordered_map<std::int64_t, Player*> mPlayers;
+};
@@ -0,0 +1,36 @@
+#pragma once
+
+// Mock of the Bedrock Block (one object per block permutation) for the Linux benchmark build.
+// The registry is filled with a handful of vanilla crops and blocks by MockLeviLamina.cpp.
+
+#include "ll/api/base/OptionalRef.h"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+class BlockLegacy;
+
+class Block {
+public:
+    Block(std::string typeName, std::uint16_t data, std::uint32_t runtimeId, BlockLegacy const& legacy)
+    : mTypeName(std::move(typeName)),
+      mData(data),
+      mRuntimeId(runtimeId),
+      mLegacy(&legacy) {}
+
+    [[nodiscard]] std::string const&   getTypeName() const { return mTypeName; }
+    [[nodiscard]] std::uint32_t const& getRuntimeId() const { return mRuntimeId; }
+    [[nodiscard]] std::uint16_t        getData() const { return mData; }
+    [[nodiscard]] BlockLegacy const&   getLegacyBlock() const { return *mLegacy; }
+
+    static optional_ref<Block const> tryGetFromRegistry(std::uint32_t runtimeId);
+    static optional_ref<Block const> tryGetFromRegistry(std::string_view name);
+    static optional_ref<Block const> tryGetFromRegistry(std::string_view name, std::uint16_t legacyData);
+
+private:
+    std::string        mTypeName;
+    std::uint16_t      mData;
+    std::uint32_t      mRuntimeId;
+    BlockLegacy const* mLegacy;
+};
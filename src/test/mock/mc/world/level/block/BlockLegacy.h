@@ -0,0 +1,19 @@
+#pragma once
+
+// Mock of the Bedrock BlockLegacy (one object per block type) for the Linux benchmark build
+
+#include <string>
+
+class BlockLegacy {
+public:
+    explicit BlockLegacy(std::string typeName) : mTypeName(std::move(typeName)) {}
+    virtual ~BlockLegacy() = default;
+
+    BlockLegacy(const BlockLegacy&)            = delete;
+    BlockLegacy& operator=(const BlockLegacy&) = delete;
+
+    [[nodiscard]] std::string const& getTypeName() const { return mTypeName; }
+
+private:
+    std::string mTypeName;
+};
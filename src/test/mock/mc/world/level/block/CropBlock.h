@@ -0,0 +1,39 @@
+#pragma once
+
+// Mock of the Bedrock CropBlock for the Linux benchmark build
+
+#include "ll/api/memory/Hook.h"
+#include "mc/util/Random.h"
+#include "mc/world/actor/Actor.h"
+#include "mc/world/item/FertilizerType.h"
+#include "mc/world/level/BlockPos.h"
+#include "mc/world/level/BlockSource.h"
+#include "mc/world/level/block/BlockLegacy.h"
+
+class CropBlock : public BlockLegacy {
+public:
+    using BlockLegacy::BlockLegacy;
+
+    /// Vanilla behaviour: advance the crop at pos by one growth stage
+    void $randomTick(BlockSource& region, BlockPos const& pos, Random& random) const;
+
+    /// Entry point used by harnesses in place of the game's random tick, honours installed hooks
+    void randomTick(BlockSource& region, BlockPos const& pos, Random& random) const {
+        if (const auto detour = ll::memory::mock::HookSlot<&CropBlock::$randomTick>::detour) {
+            detour(this, region, pos, random);
+            return;
+        }
+        $randomTick(region, pos, random);
+    }
+
+    /// Vanilla behaviour: advance the crop at pos by one growth stage; false if it is fully grown
+    bool $onFertilized(BlockSource& region, BlockPos const& pos, Actor* actor, FertilizerType type) const;
+
+    /// Entry point used by harnesses in place of bone meal from a player or dispenser, honours installed hooks
+    bool fertilize(BlockSource& region, BlockPos const& pos, Actor* actor, FertilizerType type) const {
+        if (const auto detour = ll::memory::mock::HookSlot<&CropBlock::$onFertilized>::detour) {
+            return detour(this, region, pos, actor, type);
+        }
+        return $onFertilized(region, pos, actor, type);
+    }
+};
@@ -0,0 +1,22 @@
+#pragma once
+
+// Mock of the Bedrock Dimension for the Linux benchmark build
+
+#include "mc/world/level/BlockSource.h"
+#include "mc/world/level/dimension/DimensionType.h"
+
+class Dimension {
+public:
+    explicit Dimension(DimensionType id) noexcept : mId(id), mBlockSource(id) {}
+
+    [[nodiscard]] DimensionType getDimensionId() const noexcept { return mId; }
+    BlockSource&                getBlockSourceFromMainChunkSource() const { return mBlockSource; }
+
+    /// Vanilla build limits: the overworld spans -64..319, the nether and the end 0..255
+    [[nodiscard]] short getMinHeight() const noexcept { return mId == 0 ? -64 : 0; }
+    [[nodiscard]] short getHeight() const noexcept { return mId == 0 ? 320 : 256; }
+
+private:
+    DimensionType       mId;
+    mutable BlockSource mBlockSource;
+};
@@ -0,0 +1,11 @@
+#pragma once
+
+// Mock of AutomaticID<Dimension, int> for the Linux benchmark build
+
+struct DimensionType {
+    int id = 0;
+
+    constexpr DimensionType() noexcept = default;
+    constexpr DimensionType(int value) noexcept : id(value) {}
+    constexpr operator int() const noexcept { return id; }
+};
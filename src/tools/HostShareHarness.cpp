@@ -0,0 +1,189 @@
+// Multi-process test of the host-wide shared segment used by `host_share`.
+//
+// Forks several worker processes that open one segment, publish blocked-attempt
+// counts and overwrite the shared configuration document while reading it back,
+// then checks that no count was lost and no reader ever saw a torn document.
+//
+// Usage:
+//   potato-bonemeal-blocker-host-share-harness [--processes N] [--iterations N] [--config-every N]
+
+#include "mod/HostShare.h"
+#include "mod/SharedMemory.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+using namespace potato_bonemeal_blocker;
+
+int usage() {
+    std::fprintf(
+        stderr,
+        "Usage: potato-bonemeal-blocker-host-share-harness [--processes N] [--iterations N] [--config-every N]\n"
+    );
+    return EXIT_FAILURE;
+}
+
+std::int64_t epochMillis() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch())
+        .count();
+}
+
+/**
+ * @brief Build the document a worker publishes: one repeated letter, so any mix of two documents shows
+ */
+std::string makeDocument(std::uint64_t worker, std::uint64_t round) {
+    const auto letter = static_cast<char>('a' + (worker * 31 + round) % 26);
+    const auto length = 1 + (worker * 7919 + round * 104729) % (64 * 1024);
+    return std::string(length, letter);
+}
+
+/**
+ * @brief Check that a document read back is one published document
+ */
+bool isWholeDocument(std::string_view text) {
+    return text.empty() || std::all_of(text.begin(), text.end(), [&](char c) { return c == text.front(); });
+}
+
+/**
+ * @brief Body of one worker process
+ * @return Process exit code
+ */
+int runWorker(std::string_view name, std::uint64_t worker, std::uint64_t iterations, std::uint64_t configEvery) {
+    HostShare   share;
+    std::string error;
+    if (!share.open(name, epochMillis(), error)) {
+        std::fprintf(stderr, "worker %llu: %s\n", static_cast<unsigned long long>(worker), error.c_str());
+        return EXIT_FAILURE;
+    }
+
+    std::string   text;
+    std::uint64_t lastGeneration = 0;
+    std::uint64_t torn           = 0;
+    for (std::uint64_t i = 1; i <= iterations; ++i) {
+        share.publish(1, 1, epochMillis());
+        if (i % configEvery != 0) {
+            continue;
+        }
+        if (share.publishConfig(makeDocument(worker, i / configEvery)) == 0) {
+            std::fprintf(stderr, "worker %llu: could not publish\n", static_cast<unsigned long long>(worker));
+            return EXIT_FAILURE;
+        }
+        const auto generation = share.readConfig(text);
+        if (generation < lastGeneration || !isWholeDocument(text)) {
+            ++torn;
+        }
+        lastGeneration = generation;
+    }
+    if (torn > 0) {
+        std::fprintf(
+            stderr,
+            "worker %llu: %llu torn or stale documents\n",
+            static_cast<unsigned long long>(worker),
+            static_cast<unsigned long long>(torn)
+        );
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::uint64_t processes   = 8;
+    std::uint64_t iterations  = 200'000;
+    std::uint64_t configEvery = 1'000;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        const std::string_view option = argv[i];
+        const auto             value  = std::strtoull(argv[i + 1], nullptr, 10);
+        if (option == "--processes") {
+            processes = std::clamp<std::uint64_t>(value, 1, HostShare::MAX_INSTANCES - 1);
+        } else if (option == "--iterations") {
+            iterations = std::max<std::uint64_t>(value, 1);
+        } else if (option == "--config-every") {
+            configEvery = std::max<std::uint64_t>(value, 1);
+        } else {
+            return usage();
+        }
+    }
+
+#if defined(_WIN32)
+    std::fprintf(stderr, "The harness forks its workers and needs a POSIX system\n");
+    return EXIT_FAILURE;
+#else
+    const auto name = "pbb-harness-" + std::to_string(::getpid());
+    SharedMemory::remove(name);
+
+    // The parent holds a slot too, so the segment outlives every worker
+    HostShare   share;
+    std::string error;
+    if (!share.open(name, epochMillis(), error)) {
+        std::fprintf(stderr, "%s\n", error.c_str());
+        return EXIT_FAILURE;
+    }
+
+    const auto         start = std::chrono::steady_clock::now();
+    std::vector<pid_t> workers;
+    for (std::uint64_t worker = 0; worker < processes; ++worker) {
+        const pid_t pid = ::fork();
+        if (pid == 0) {
+            ::_exit(runWorker(name, worker, iterations, configEvery));
+        }
+        if (pid < 0) {
+            std::fprintf(stderr, "fork failed\n");
+            break;
+        }
+        workers.push_back(pid);
+    }
+
+    int failed = 0;
+    for (const auto pid : workers) {
+        int status = 0;
+        if (::waitpid(pid, &status, 0) != pid || !WIFEXITED(status) || WEXITSTATUS(status) != EXIT_SUCCESS) {
+            ++failed;
+        }
+    }
+    const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::string text;
+    const auto  totals     = share.getTotals(epochMillis());
+    const auto  generation = share.readConfig(text);
+    const auto  expected   = workers.size() * iterations;
+    std::printf(
+        "%zu workers x %llu iterations in %.2f s: %llu blocked, %llu fertilizer blocked (expected %llu each), "
+        "config generation %llu, %u instances still attached\n",
+        workers.size(),
+        static_cast<unsigned long long>(iterations),
+        elapsed,
+        static_cast<unsigned long long>(totals.blocked),
+        static_cast<unsigned long long>(totals.fertilizerBlocked),
+        static_cast<unsigned long long>(expected),
+        static_cast<unsigned long long>(generation),
+        totals.instances
+    );
+
+    const bool ok = failed == 0 && workers.size() == processes && totals.blocked == expected
+                 && totals.fertilizerBlocked == expected && generation == workers.size() * (iterations / configEvery)
+                 && isWholeDocument(text) && totals.instances == 1;
+    share.close();
+    SharedMemory::remove(name);
+    if (!ok) {
+        std::fprintf(stderr, "FAIL: %d workers failed or the shared state is inconsistent\n", failed);
+        return EXIT_FAILURE;
+    }
+    std::printf("OK\n");
+    return EXIT_SUCCESS;
+#endif
+}
@@ -0,0 +1,521 @@
+// Offline analysis of blocked-attempt log lines written by the plugin's log sink.
+//
+// `index` parses server logs in parallel into a columnar index; `query` answers
+// player, bounding box and time range questions from the memory-mapped index.
+//
+// Usage:
+//   potato-bonemeal-blocker-log-analyzer index <out.pbbl> <log>... [--date YYYY-MM-DD] [--lang-dir DIR]
+//                                              [--threads N]
+//   potato-bonemeal-blocker-log-analyzer query <index.pbbl> [--player NAME] [--box x1,z1,x2,z2 | x1,y1,z1,x2,y2,z2]
+//                                              [--from TIME] [--to TIME] [--limit N]
+//
+// Lines are recognized by the English and Chinese `blocked_attempt_log` templates, plus
+// every `.lang` file in --lang-dir. Times are taken as written in the log, without a time
+// zone; lines carrying only a time of day are dated from --date, counting midnight rollovers.
+// TIME is `YYYY-MM-DD`, `YYYY-MM-DD HH:MM[:SS]` or `YYYY-MM-DDTHH:MM[:SS]`.
+
+#include "mod/Language.h"
+#include "mod/MappedFile.h"
+#include "tools/LogIndex.h"
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+using namespace potato_bonemeal_blocker;
+
+constexpr std::int64_t DAY_MS = 86'400'000;
+
+/// A time of day going back by more than this starts the next day
+constexpr std::int64_t ROLLOVER_MS = 3'600'000;
+
+/**
+ * @brief A `blocked_attempt_log` template split at its `{}` placeholders (name, x, y, z)
+ */
+struct LineTemplate {
+    std::vector<std::string> literals; ///< Text before, between and after the four placeholders
+
+    static std::optional<LineTemplate> parse(std::string_view pattern) {
+        LineTemplate result;
+        for (;;) {
+            const auto placeholder = pattern.find("{}");
+            result.literals.emplace_back(pattern.substr(0, placeholder));
+            if (placeholder == std::string_view::npos) {
+                break;
+            }
+            pattern.remove_prefix(placeholder + 2);
+        }
+        // The name must be delimited on both sides to be found in a line
+        if (result.literals.size() != 5 || result.literals[0].empty() || result.literals[1].empty()) {
+            return std::nullopt;
+        }
+        return result;
+    }
+
+    /**
+     * @brief Match the message part of a line
+     * @return Name and coordinates, or false if the line is not this template
+     */
+    bool match(std::string_view line, std::string_view& name, std::int32_t (&xyz)[3]) const noexcept {
+        const auto start = line.find(literals[0]);
+        if (start == std::string_view::npos) {
+            return false;
+        }
+        line.remove_prefix(start + literals[0].size());
+        const auto end = line.find(literals[1]);
+        if (end == std::string_view::npos) {
+            return false;
+        }
+        name = line.substr(0, end);
+        line.remove_prefix(end + literals[1].size());
+        for (int i = 0; i < 3; ++i) {
+            const auto [ptr, ec] = std::from_chars(line.data(), line.data() + line.size(), xyz[i]);
+            if (ec != std::errc{}) {
+                return false;
+            }
+            line.remove_prefix(static_cast<std::size_t>(ptr - line.data()));
+            if (!line.starts_with(literals[i + 2])) {
+                return false;
+            }
+            line.remove_prefix(literals[i + 2].size());
+        }
+        return !name.empty();
+    }
+};
+
+/**
+ * @brief Parse a fixed number of digits
+ */
+bool readDigits(std::string_view text, std::size_t offset, std::size_t count, int& value) noexcept {
+    if (offset + count > text.size()) {
+        return false;
+    }
+    value = 0;
+    for (std::size_t i = offset; i < offset + count; ++i) {
+        if (text[i] < '0' || text[i] > '9') {
+            return false;
+        }
+        value = value * 10 + (text[i] - '0');
+    }
+    return true;
+}
+
+/**
+ * @brief Timestamp at the start of a log line
+ */
+struct LineTime {
+    std::int64_t ms    = 0;     ///< Since the epoch if dated, else since midnight
+    bool         dated = false;
+};
+
+/**
+ * @brief Parse `[YYYY-MM-DD[ T]]HH:MM:SS[.mmm]`, optionally inside a leading `[`
+ */
+std::optional<LineTime> parseLineTime(std::string_view line) noexcept {
+    if (line.starts_with('[')) {
+        line.remove_prefix(1);
+    }
+    LineTime time;
+    int      year = 0, month = 0, day = 0;
+    if (readDigits(line, 0, 4, year) && line.size() > 10 && line[4] == '-' && readDigits(line, 5, 2, month)
+        && line[7] == '-' && readDigits(line, 8, 2, day) && (line[10] == ' ' || line[10] == 'T')) {
+        time.dated = true;
+        time.ms    = daysFromCivil(year, static_cast<unsigned>(month), static_cast<unsigned>(day)) * DAY_MS;
+        line.remove_prefix(11);
+    }
+    int hour = 0, minute = 0, second = 0, millis = 0;
+    if (!readDigits(line, 0, 2, hour) || line.size() < 8 || line[2] != ':' || !readDigits(line, 3, 2, minute)
+        || line[5] != ':' || !readDigits(line, 6, 2, second)) {
+        return std::nullopt;
+    }
+    if (line.size() >= 12 && (line[8] == '.' || line[8] == ':' || line[8] == ',')) {
+        readDigits(line, 9, 3, millis);
+    }
+    time.ms += ((hour * 60LL + minute) * 60 + second) * 1000 + millis;
+    return time;
+}
+
+/**
+ * @brief Rows of one slice of the input, with a slice-local name dictionary
+ */
+struct ParsedChunk {
+    std::vector<LogRow>                            rows;
+    std::vector<bool>                              dated; ///< Per row: LogRow::timeMs is since the epoch
+    std::vector<std::string>                       names;
+    std::unordered_map<std::string, std::uint32_t> ids;
+    std::uint64_t                                  lines = 0;
+};
+
+void parseChunk(std::string_view text, const std::vector<LineTemplate>& templates, ParsedChunk& chunk) {
+    LineTime    last;
+    std::string key; // Reused so known names are looked up without allocating
+    while (!text.empty()) {
+        const auto end  = text.find('\n');
+        auto       line = text.substr(0, end);
+        text.remove_prefix(end == std::string_view::npos ? text.size() : end + 1);
+        ++chunk.lines;
+        if (line.ends_with('\r')) {
+            line.remove_suffix(1);
+        }
+
+        // Continuation lines without a timestamp share the previous line's
+        if (const auto time = parseLineTime(line)) {
+            last = *time;
+        }
+        std::string_view name;
+        std::int32_t     xyz[3];
+        const bool       matched = std::any_of(templates.begin(), templates.end(), [&](const auto& pattern) {
+            return pattern.match(line, name, xyz);
+        });
+        if (!matched) {
+            continue;
+        }
+
+        key.assign(name);
+        auto it = chunk.ids.find(key);
+        if (it == chunk.ids.end()) {
+            it = chunk.ids.emplace(key, static_cast<std::uint32_t>(chunk.names.size())).first;
+            chunk.names.push_back(key);
+        }
+        chunk.rows.push_back(LogRow{last.ms, xyz[0], xyz[1], xyz[2], it->second});
+        chunk.dated.push_back(last.dated);
+    }
+}
+
+/**
+ * @brief Split a buffer into about `parts` slices at line boundaries
+ */
+std::vector<std::string_view> splitLines(std::string_view text, std::size_t parts) {
+    std::vector<std::string_view> slices;
+    const auto                    target = std::max<std::size_t>(text.size() / std::max<std::size_t>(parts, 1), 1);
+    while (!text.empty()) {
+        auto cut = std::min(target, text.size());
+        if (cut < text.size()) {
+            const auto newline = text.find('\n', cut);
+            cut                = newline == std::string_view::npos ? text.size() : newline + 1;
+        }
+        slices.push_back(text.substr(0, cut));
+        text.remove_prefix(cut);
+    }
+    return slices;
+}
+
+/**
+ * @brief Parse `YYYY-MM-DD[( |T)HH:MM[:SS]]` as milliseconds since the epoch
+ */
+std::optional<std::int64_t> parseQueryTime(std::string_view text) {
+    int year = 0, month = 0, day = 0;
+    if (text.size() < 10 || !readDigits(text, 0, 4, year) || text[4] != '-' || !readDigits(text, 5, 2, month)
+        || text[7] != '-' || !readDigits(text, 8, 2, day)) {
+        return std::nullopt;
+    }
+    auto ms = daysFromCivil(year, static_cast<unsigned>(month), static_cast<unsigned>(day)) * DAY_MS;
+    if (text.size() == 10) {
+        return ms;
+    }
+    int hour = 0, minute = 0, second = 0;
+    if ((text[10] != ' ' && text[10] != 'T') || !readDigits(text, 11, 2, hour) || text.size() < 16 || text[13] != ':'
+        || !readDigits(text, 14, 2, minute)) {
+        return std::nullopt;
+    }
+    if (text.size() >= 19 && (text[16] != ':' || !readDigits(text, 17, 2, second))) {
+        return std::nullopt;
+    }
+    return ms + ((hour * 60LL + minute) * 60 + second) * 1000;
+}
+
+/**
+ * @brief Parse a comma-separated list of integers
+ */
+std::vector<std::int32_t> parseIntegers(std::string_view text) {
+    std::vector<std::int32_t> values;
+    while (!text.empty()) {
+        std::int32_t value = 0;
+        const auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+        if (ec != std::errc{}) {
+            return {};
+        }
+        values.push_back(value);
+        text.remove_prefix(static_cast<std::size_t>(ptr - text.data()));
+        if (!text.empty()) {
+            if (text.front() != ',') {
+                return {};
+            }
+            text.remove_prefix(1);
+        }
+    }
+    return values;
+}
+
+double millisSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+int usage() {
+    std::fprintf(
+        stderr,
+        "usage: potato-bonemeal-blocker-log-analyzer index <out.pbbl> <log>... [--date YYYY-MM-DD] [--lang-dir DIR]"
+        " [--threads N]\n"
+        "       potato-bonemeal-blocker-log-analyzer query <index.pbbl> [--player NAME]"
+        " [--box x1,z1,x2,z2 | x1,y1,z1,x2,y2,z2] [--from TIME] [--to TIME] [--limit N]\n"
+    );
+    return EXIT_FAILURE;
+}
+
+int runIndex(int argc, char** argv) {
+    const std::filesystem::path        output = argv[2];
+    std::vector<std::filesystem::path> inputs;
+    std::optional<std::int64_t>        baseDay;
+    std::size_t                        threads  = std::max(1u, std::thread::hardware_concurrency());
+    auto&                              language = Language::getInstance();
+    for (int i = 3; i < argc; ++i) {
+        const std::string_view option = argv[i];
+        if (!option.starts_with("--")) {
+            inputs.emplace_back(argv[i]);
+            continue;
+        }
+        if (i + 1 >= argc) {
+            return usage();
+        }
+        const std::string_view value = argv[++i];
+        if (option == "--date") {
+            baseDay = parseQueryTime(value);
+            if (!baseDay || value.size() != 10) {
+                std::fprintf(stderr, "Invalid date: %s\n", argv[i]);
+                return EXIT_FAILURE;
+            }
+        } else if (option == "--lang-dir") {
+            language.loadDirectory(std::filesystem::path(value));
+        } else if (option == "--threads") {
+            threads = std::max<std::size_t>(1, std::strtoull(argv[i], nullptr, 10));
+        } else {
+            return usage();
+        }
+    }
+    if (inputs.empty()) {
+        return usage();
+    }
+
+    std::vector<LineTemplate> templates;
+    for (std::size_t i = 0; i < language.getLanguageCount(); ++i) {
+        const auto pattern = language.getMessage(
+            Language::MessageKey::BLOCKED_ATTEMPT_LOG,
+            static_cast<Language::LanguageCode>(i)
+        );
+        auto parsed = LineTemplate::parse(pattern);
+        if (!parsed) {
+            std::fprintf(stderr, "Skipping template: %.*s\n", static_cast<int>(pattern.size()), pattern.data());
+            continue;
+        }
+        const auto known = std::any_of(templates.begin(), templates.end(), [&](const auto& existing) {
+            return existing.literals == parsed->literals;
+        });
+        if (!known) {
+            templates.push_back(std::move(*parsed));
+        }
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<LogRow>                            rows;
+    std::vector<std::string>                       names;
+    std::unordered_map<std::string, std::uint32_t> ids;
+    std::uint64_t                                  lines = 0, bytes = 0, undated = 0;
+    auto                                           dayMs   = baseDay.value_or(0);
+    bool                                           haveDay = baseDay.has_value();
+    std::int64_t                                   lastTod = 0;
+
+    // Files one after another, each mapped and split into slices parsed in parallel
+    for (const auto& input : inputs) {
+        MappedFile file;
+        if (!file.open(input)) {
+            std::fprintf(stderr, "Cannot open %s\n", input.string().c_str());
+            return EXIT_FAILURE;
+        }
+        const auto             data = file.data();
+        const std::string_view text(reinterpret_cast<const char*>(data.data()), data.size());
+        bytes += text.size();
+
+        const auto               slices = splitLines(text, threads * 4);
+        std::vector<ParsedChunk> chunks(slices.size());
+        std::atomic<std::size_t> next{0};
+        std::vector<std::thread> workers;
+        for (std::size_t t = 0; t < std::min(threads, slices.size()); ++t) {
+            workers.emplace_back([&] {
+                for (auto slice = next++; slice < slices.size(); slice = next++) {
+                    parseChunk(slices[slice], templates, chunks[slice]);
+                }
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+
+        // Merge in file order: global names, and dates for lines that only carry a time of day
+        for (auto& chunk : chunks) {
+            lines += chunk.lines;
+            std::vector<std::uint32_t> remap(chunk.names.size());
+            for (std::size_t i = 0; i < chunk.names.size(); ++i) {
+                auto [it, inserted] = ids.try_emplace(chunk.names[i], static_cast<std::uint32_t>(names.size()));
+                if (inserted) {
+                    names.push_back(chunk.names[i]);
+                }
+                remap[i] = it->second;
+            }
+            for (std::size_t i = 0; i < chunk.rows.size(); ++i) {
+                auto& row  = chunk.rows[i];
+                row.player = remap[row.player];
+                if (chunk.dated[i]) {
+                    dayMs   = row.timeMs - row.timeMs % DAY_MS;
+                    lastTod = row.timeMs % DAY_MS;
+                    haveDay = true;
+                } else {
+                    if (row.timeMs + ROLLOVER_MS < lastTod) {
+                        dayMs += DAY_MS;
+                    }
+                    lastTod = row.timeMs;
+                    row.timeMs += dayMs;
+                    undated += haveDay ? 0 : 1;
+                }
+                rows.push_back(row);
+            }
+        }
+    }
+    const auto parseMs = millisSince(start);
+
+    std::string error;
+    const auto  rowCount = rows.size();
+    if (!writeLogIndex(output, rows, names, error)) {
+        std::fprintf(stderr, "%s\n", error.c_str());
+        return EXIT_FAILURE;
+    }
+    std::printf(
+        "parsed %llu lines (%.1f MiB) with %zu templates on %zu threads in %.1f ms: %zu attempts by %zu players\n",
+        static_cast<unsigned long long>(lines),
+        static_cast<double>(bytes) / (1024.0 * 1024.0),
+        templates.size(),
+        threads,
+        parseMs,
+        rowCount,
+        names.size()
+    );
+    std::printf("wrote %s in %.1f ms total\n", output.string().c_str(), millisSince(start));
+    if (undated > 0) {
+        std::printf(
+            "%llu lines had no date and were counted from 1970-01-01; pass --date\n",
+            static_cast<unsigned long long>(undated)
+        );
+    }
+    return EXIT_SUCCESS;
+}
+
+int runQuery(int argc, char** argv) {
+    LogIndexReader reader;
+    if (!reader.open(argv[2])) {
+        const auto error = reader.getError();
+        std::fprintf(stderr, "%s: %.*s\n", argv[2], static_cast<int>(error.size()), error.data());
+        return EXIT_FAILURE;
+    }
+
+    LogQuery      query;
+    std::uint64_t limit = 20;
+    for (int i = 3; i + 1 < argc; i += 2) {
+        const std::string_view option = argv[i];
+        const std::string_view value  = argv[i + 1];
+        if (option == "--player") {
+            query.player = reader.findPlayer(value);
+            if (!query.player) {
+                std::printf("no blocked attempts by %s\n", argv[i + 1]);
+                return EXIT_SUCCESS;
+            }
+        } else if (option == "--box") {
+            const auto v = parseIntegers(value);
+            if (v.size() == 4) {
+                query.box.minX = std::min(v[0], v[2]);
+                query.box.maxX = std::max(v[0], v[2]);
+                query.box.minZ = std::min(v[1], v[3]);
+                query.box.maxZ = std::max(v[1], v[3]);
+            } else if (v.size() == 6) {
+                query.box = LogBox{
+                    std::min(v[0], v[3]),
+                    std::max(v[0], v[3]),
+                    std::min(v[1], v[4]),
+                    std::max(v[1], v[4]),
+                    std::min(v[2], v[5]),
+                    std::max(v[2], v[5])
+                };
+            } else {
+                std::fprintf(stderr, "Invalid box: %s\n", argv[i + 1]);
+                return EXIT_FAILURE;
+            }
+        } else if (option == "--from" || option == "--to") {
+            const auto time = parseQueryTime(value);
+            if (!time) {
+                std::fprintf(stderr, "Invalid time: %s\n", argv[i + 1]);
+                return EXIT_FAILURE;
+            }
+            (option == "--from" ? query.fromMs : query.toMs) = *time;
+        } else if (option == "--limit") {
+            limit = std::strtoull(argv[i + 1], nullptr, 10);
+        } else {
+            return usage();
+        }
+    }
+
+    // Count everything, but print only the first rows
+    const auto    start   = std::chrono::steady_clock::now();
+    std::uint64_t printed = 0;
+    std::string   out;
+    const auto    matched = reader.run(query, [&](std::uint64_t row) {
+        if (printed < limit) {
+            ++printed;
+            const auto name = reader.getPlayerName(reader.getPlayer(row));
+            out += formatLogTime(reader.getTime(row));
+            out += ' ';
+            out += name;
+            out += " (" + std::to_string(reader.getX(row)) + ", " + std::to_string(reader.getY(row)) + ", "
+                 + std::to_string(reader.getZ(row)) + ")\n";
+        }
+        return true;
+    });
+    const auto elapsed = millisSince(start);
+
+    std::fputs(out.c_str(), stdout);
+    std::printf(
+        "%llu of %llu blocked attempts match (%llu shown) in %.3f ms\n",
+        static_cast<unsigned long long>(matched),
+        static_cast<unsigned long long>(reader.getHeader().rowCount),
+        static_cast<unsigned long long>(printed),
+        elapsed
+    );
+    return EXIT_SUCCESS;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        return usage();
+    }
+    const std::string_view command = argv[1];
+    if (command == "index") {
+        return runIndex(argc, argv);
+    }
+    if (command == "query") {
+        return runQuery(argc, argv);
+    }
+    return usage();
+}
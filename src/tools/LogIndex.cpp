@@ -0,0 +1,270 @@
+#include "tools/LogIndex.h"
+
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <numeric>
+
+namespace potato_bonemeal_blocker {
+
+namespace {
+
+constexpr std::uint64_t align8(std::uint64_t offset) noexcept { return (offset + 7) & ~std::uint64_t{7}; }
+
+bool equalsIgnoreCase(std::string_view a, std::string_view b) noexcept {
+    return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin(), [](char l, char r) {
+               return std::tolower(static_cast<unsigned char>(l)) == std::tolower(static_cast<unsigned char>(r));
+           });
+}
+
+/**
+ * @brief Append a trivially copyable array, padded to the next section boundary
+ */
+template <typename T>
+void writeSection(std::ofstream& out, std::span<const T> values) {
+    const auto bytes = values.size_bytes();
+    out.write(reinterpret_cast<const char*>(values.data()), static_cast<std::streamsize>(bytes));
+    static constexpr char padding[8] = {};
+    out.write(padding, static_cast<std::streamsize>(align8(bytes) - bytes));
+}
+
+} // namespace
+
+LogIndexLayout LogIndexLayout::of(const LogIndexHeader& header) noexcept {
+    const auto     rows    = header.rowCount;
+    const auto     players = static_cast<std::uint64_t>(header.playerCount);
+    LogIndexLayout layout{};
+    layout.time           = align8(header.headerSize);
+    layout.x              = layout.time + rows * sizeof(std::int64_t);
+    layout.y              = layout.x + align8(rows * sizeof(std::int32_t));
+    layout.z              = layout.y + align8(rows * sizeof(std::int32_t));
+    layout.player         = layout.z + align8(rows * sizeof(std::int32_t));
+    layout.blocks         = layout.player + align8(rows * sizeof(std::uint32_t));
+    layout.postingOffsets = layout.blocks + header.blockCount * sizeof(LogBlockSummary);
+    layout.postings       = layout.postingOffsets + (players + 1) * sizeof(std::uint64_t);
+    layout.nameOffsets    = layout.postings + align8(rows * sizeof(std::uint32_t));
+    layout.names          = layout.nameOffsets + (players + 1) * sizeof(std::uint64_t);
+    layout.end            = layout.names + header.nameBytes;
+    return layout;
+}
+
+bool writeLogIndex(
+    const std::filesystem::path&    path,
+    std::vector<LogRow>&            rows,
+    const std::vector<std::string>& names,
+    std::string&                    error
+) {
+    if (rows.size() > std::numeric_limits<std::uint32_t>::max()) {
+        error = "more than 2^32 rows";
+        return false;
+    }
+
+    // Dictionary sorted by name, so lookups are a binary search
+    std::vector<std::uint32_t> order(names.size());
+    std::iota(order.begin(), order.end(), 0u);
+    std::sort(order.begin(), order.end(), [&](auto a, auto b) { return names[a] < names[b]; });
+    std::vector<std::uint32_t> rank(names.size());
+    for (std::uint32_t i = 0; i < order.size(); ++i) {
+        rank[order[i]] = i;
+    }
+
+    // Logs are nearly in time order already; stable keeps same-millisecond lines in file order
+    if (!std::is_sorted(rows.begin(), rows.end(), [](const auto& a, const auto& b) { return a.timeMs < b.timeMs; })) {
+        std::stable_sort(rows.begin(), rows.end(), [](const auto& a, const auto& b) { return a.timeMs < b.timeMs; });
+    }
+
+    LogIndexHeader header;
+    header.headerSize  = sizeof(LogIndexHeader);
+    header.rowCount    = rows.size();
+    header.playerCount = static_cast<std::uint32_t>(names.size());
+    header.blockCount  = static_cast<std::uint32_t>((rows.size() + header.blockRows - 1) / header.blockRows);
+    header.minTimeMs   = rows.empty() ? 0 : rows.front().timeMs;
+    header.maxTimeMs   = rows.empty() ? 0 : rows.back().timeMs;
+    for (const auto& name : names) {
+        header.nameBytes += name.size();
+    }
+
+    std::vector<std::int64_t>    time(rows.size());
+    std::vector<std::int32_t>    xs(rows.size()), ys(rows.size()), zs(rows.size());
+    std::vector<std::uint32_t>   player(rows.size());
+    std::vector<LogBlockSummary> blocks(header.blockCount);
+    std::vector<std::uint64_t>   postingOffsets(names.size() + 1, 0);
+    for (std::size_t row = 0; row < rows.size(); ++row) {
+        const auto& source = rows[row];
+        time[row]          = source.timeMs;
+        xs[row]            = source.x;
+        ys[row]            = source.y;
+        zs[row]            = source.z;
+        player[row]        = rank[source.player];
+        ++postingOffsets[player[row] + 1];
+
+        auto& block = blocks[row / header.blockRows];
+        if (row % header.blockRows == 0) {
+            block = LogBlockSummary{source.x, source.x, source.y, source.y, source.z, source.z};
+        }
+        block.minX = std::min(block.minX, source.x);
+        block.maxX = std::max(block.maxX, source.x);
+        block.minY = std::min(block.minY, source.y);
+        block.maxY = std::max(block.maxY, source.y);
+        block.minZ = std::min(block.minZ, source.z);
+        block.maxZ = std::max(block.maxZ, source.z);
+    }
+
+    // Counting sort of row numbers by player; rows are visited in time order, so each list is ascending
+    std::partial_sum(postingOffsets.begin(), postingOffsets.end(), postingOffsets.begin());
+    std::vector<std::uint32_t> postings(rows.size());
+    {
+        auto cursor = postingOffsets;
+        for (std::uint32_t row = 0; row < rows.size(); ++row) {
+            postings[cursor[player[row]]++] = row;
+        }
+    }
+
+    std::vector<std::uint64_t> nameOffsets(names.size() + 1, 0);
+    std::string                nameBytes;
+    nameBytes.reserve(header.nameBytes);
+    for (std::size_t i = 0; i < order.size(); ++i) {
+        nameBytes += names[order[i]];
+        nameOffsets[i + 1] = nameBytes.size();
+    }
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        error = "cannot create " + path.string();
+        return false;
+    }
+    writeSection(out, std::span<const LogIndexHeader>(&header, 1));
+    writeSection<std::int64_t>(out, time);
+    writeSection<std::int32_t>(out, xs);
+    writeSection<std::int32_t>(out, ys);
+    writeSection<std::int32_t>(out, zs);
+    writeSection<std::uint32_t>(out, player);
+    writeSection<LogBlockSummary>(out, blocks);
+    writeSection<std::uint64_t>(out, postingOffsets);
+    writeSection<std::uint32_t>(out, postings);
+    writeSection<std::uint64_t>(out, nameOffsets);
+    writeSection<char>(out, nameBytes);
+    out.flush();
+    if (!out) {
+        error = "cannot write " + path.string();
+        return false;
+    }
+    return true;
+}
+
+bool LogIndexReader::open(const std::filesystem::path& path) {
+    mError.clear();
+    if (!mFile.open(path)) {
+        mError = "cannot open " + path.string();
+        return false;
+    }
+
+    const auto bytes = mFile.data();
+    if (bytes.size() < sizeof(LogIndexHeader)) {
+        mError = "file is too short for a log index header";
+        return false;
+    }
+    std::memcpy(&mHeader, bytes.data(), sizeof(LogIndexHeader));
+    if (mHeader.magic != LogIndexHeader::MAGIC) {
+        mError = "not a log index";
+        return false;
+    }
+    if (mHeader.version > LogIndexHeader::VERSION) {
+        mError = "unsupported log index version " + std::to_string(mHeader.version);
+        return false;
+    }
+    if (mHeader.headerSize < sizeof(LogIndexHeader) || mHeader.blockRows == 0
+        || mHeader.blockCount != (mHeader.rowCount + mHeader.blockRows - 1) / mHeader.blockRows) {
+        mError = "unexpected header";
+        return false;
+    }
+
+    const auto layout = LogIndexLayout::of(mHeader);
+    if (layout.end > bytes.size()) {
+        mError = "file is shorter than its header says";
+        return false;
+    }
+    const auto rows    = mHeader.rowCount;
+    const auto players = static_cast<std::uint64_t>(mHeader.playerCount);
+    mTime              = section<std::int64_t>(layout.time, rows);
+    mX                 = section<std::int32_t>(layout.x, rows);
+    mY                 = section<std::int32_t>(layout.y, rows);
+    mZ                 = section<std::int32_t>(layout.z, rows);
+    mPlayer            = section<std::uint32_t>(layout.player, rows);
+    mBlocks            = section<LogBlockSummary>(layout.blocks, mHeader.blockCount);
+    mPostingOffsets    = section<std::uint64_t>(layout.postingOffsets, players + 1);
+    mPostings          = section<std::uint32_t>(layout.postings, rows);
+    mNameOffsets       = section<std::uint64_t>(layout.nameOffsets, players + 1);
+    mNames             = section<char>(layout.names, mHeader.nameBytes);
+    if (mPostingOffsets.back() != rows || mNameOffsets.back() != mHeader.nameBytes) {
+        mError = "inconsistent dictionary";
+        return false;
+    }
+    return true;
+}
+
+std::string_view LogIndexReader::getPlayerName(std::uint32_t player) const noexcept {
+    const auto begin = mNameOffsets[player];
+    return {mNames.data() + begin, static_cast<std::size_t>(mNameOffsets[player + 1] - begin)};
+}
+
+std::optional<std::uint32_t> LogIndexReader::findPlayer(std::string_view name) const noexcept {
+    std::uint32_t low = 0, high = mHeader.playerCount;
+    while (low < high) {
+        const auto middle = low + (high - low) / 2;
+        if (getPlayerName(middle) < name) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    if (low < mHeader.playerCount && getPlayerName(low) == name) {
+        return low;
+    }
+    // Bedrock names are case-insensitive; the dictionary is small enough to scan
+    for (std::uint32_t player = 0; player < mHeader.playerCount; ++player) {
+        if (equalsIgnoreCase(getPlayerName(player), name)) {
+            return player;
+        }
+    }
+    return std::nullopt;
+}
+
+std::string formatLogTime(std::int64_t timeMs) {
+    constexpr std::int64_t DAY_MS = 86'400'000;
+    auto                   days   = timeMs / DAY_MS;
+    auto                   rest   = timeMs % DAY_MS;
+    if (rest < 0) {
+        rest += DAY_MS;
+        --days;
+    }
+
+    // Inverse of daysFromCivil()
+    const auto z   = days + 719468;
+    const auto era = (z >= 0 ? z : z - 146096) / 146097;
+    const auto doe = static_cast<unsigned>(z - era * 146097);
+    const auto yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    const auto doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    const auto mp  = (5 * doy + 2) / 153;
+    const auto day = doy - (153 * mp + 2) / 5 + 1;
+    const auto mon = mp < 10 ? mp + 3 : mp - 9;
+    const auto yr  = static_cast<std::int64_t>(yoe) + era * 400 + (mon <= 2 ? 1 : 0);
+
+    char buffer[48];
+    std::snprintf(
+        buffer,
+        sizeof(buffer),
+        "%04lld-%02u-%02u %02lld:%02lld:%02lld.%03lld",
+        static_cast<long long>(yr),
+        mon,
+        day,
+        static_cast<long long>(rest / 3'600'000),
+        static_cast<long long>(rest / 60'000 % 60),
+        static_cast<long long>(rest / 1000 % 60),
+        static_cast<long long>(rest % 1000)
+    );
+    return buffer;
+}
+
+} // namespace potato_bonemeal_blocker
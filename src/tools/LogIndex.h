@@ -0,0 +1,266 @@
+#pragma once
+
+#include "mod/MappedFile.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <filesystem>
+#include <limits>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace potato_bonemeal_blocker {
+
+/**
+ * Blocked-attempt log index format, version 1
+ *
+ * An index is a LogIndexHeader followed by fixed sections, each starting on an
+ * 8-byte boundary and sized from the header counts alone:
+ *
+ *   time      int64[rows]    milliseconds since 1970-01-01 as written in the log (no time zone)
+ *   x, y, z   int32[rows]    one column each
+ *   player    uint32[rows]   index into the name dictionary
+ *   blocks    LogBlockSummary[blocks]   coordinate bounds of every BLOCK_ROWS rows
+ *   postings  uint64[players + 1] offsets, then uint32[rows] row numbers grouped by player
+ *   names     uint64[players + 1] offsets, then the name bytes, sorted by name
+ *
+ * Rows are sorted by time, so time ranges are found by binary search and each
+ * player's posting list is in time order too.
+ */
+
+static_assert(std::endian::native == std::endian::little, "Log indexes use native little-endian layout");
+
+/**
+ * @brief Fixed file header
+ */
+struct LogIndexHeader {
+    static constexpr std::array<char, 8> MAGIC      = {'P', 'B', 'B', 'L', 'O', 'G', 'I', 'X'};
+    static constexpr std::uint16_t       VERSION    = 1;
+    static constexpr std::uint32_t       BLOCK_ROWS = 4096;
+
+    std::array<char, 8> magic       = MAGIC;
+    std::uint16_t       version     = VERSION;
+    std::uint16_t       headerSize  = 0;
+    std::uint32_t       blockRows   = BLOCK_ROWS;
+    std::uint64_t       rowCount    = 0;
+    std::uint32_t       playerCount = 0;
+    std::uint32_t       blockCount  = 0;
+    std::int64_t        minTimeMs   = 0;
+    std::int64_t        maxTimeMs   = 0;
+    std::uint64_t       nameBytes   = 0;
+    std::uint64_t       reserved    = 0;
+};
+
+/**
+ * @brief Coordinate bounds of one block of rows, to skip blocks outside a query box
+ */
+struct LogBlockSummary {
+    std::int32_t minX = 0, maxX = 0;
+    std::int32_t minY = 0, maxY = 0;
+    std::int32_t minZ = 0, maxZ = 0;
+    std::int32_t reserved[2]{};
+};
+
+static_assert(sizeof(LogIndexHeader) == 64 && std::is_trivially_copyable_v<LogIndexHeader>);
+static_assert(sizeof(LogBlockSummary) == 32 && std::is_trivially_copyable_v<LogBlockSummary>);
+
+/**
+ * @brief Byte offsets of the sections, derived from a header
+ */
+struct LogIndexLayout {
+    std::uint64_t time, x, y, z, player, blocks, postingOffsets, postings, nameOffsets, names, end;
+
+    [[nodiscard]] static LogIndexLayout of(const LogIndexHeader& header) noexcept;
+};
+
+/**
+ * @brief One blocked attempt parsed from a log line
+ */
+struct LogRow {
+    std::int64_t  timeMs = 0;
+    std::int32_t  x      = 0;
+    std::int32_t  y      = 0;
+    std::int32_t  z      = 0;
+    std::uint32_t player = 0; ///< Index into the builder's name list
+};
+
+/**
+ * @brief Write an index
+ * @param path The index file
+ * @param rows Parsed rows in any order; sorted by time in place
+ * @param names Player names indexed by LogRow::player
+ * @param error Receives a description of the problem on failure
+ * @return true if the index was written
+ */
+bool writeLogIndex(
+    const std::filesystem::path&    path,
+    std::vector<LogRow>&            rows,
+    const std::vector<std::string>& names,
+    std::string&                    error
+);
+
+/**
+ * @brief Axis-aligned query box, bounds inclusive
+ */
+struct LogBox {
+    std::int32_t minX = std::numeric_limits<std::int32_t>::min(), maxX = std::numeric_limits<std::int32_t>::max();
+    std::int32_t minY = std::numeric_limits<std::int32_t>::min(), maxY = std::numeric_limits<std::int32_t>::max();
+    std::int32_t minZ = std::numeric_limits<std::int32_t>::min(), maxZ = std::numeric_limits<std::int32_t>::max();
+
+    [[nodiscard]] bool contains(std::int32_t x, std::int32_t y, std::int32_t z) const noexcept {
+        return x >= minX && x <= maxX && y >= minY && y <= maxY && z >= minZ && z <= maxZ;
+    }
+
+    [[nodiscard]] bool intersects(const LogBlockSummary& block) const noexcept {
+        return block.maxX >= minX && block.minX <= maxX && block.maxY >= minY && block.minY <= maxY
+            && block.maxZ >= minZ && block.minZ <= maxZ;
+    }
+};
+
+/**
+ * @brief Filter of a query; unset members match everything
+ */
+struct LogQuery {
+    std::optional<std::uint32_t> player; ///< Index from LogIndexReader::findPlayer()
+    LogBox                       box;
+    std::int64_t                 fromMs = std::numeric_limits<std::int64_t>::min(); ///< Inclusive
+    std::int64_t                 toMs   = std::numeric_limits<std::int64_t>::max(); ///< Exclusive
+};
+
+/**
+ * @brief Zero-copy reader and query engine for log indexes
+ */
+class LogIndexReader {
+public:
+    /**
+     * @brief Map and validate an index
+     * @param path The index file
+     * @return true on success; getError() describes failures
+     */
+    bool open(const std::filesystem::path& path);
+
+    [[nodiscard]] const LogIndexHeader& getHeader() const noexcept { return mHeader; }
+    [[nodiscard]] std::string_view      getError() const noexcept { return mError; }
+
+    /**
+     * @brief Look up a player by name, exactly first and then ignoring ASCII case
+     * @param name The player name
+     * @return Dictionary index of the player
+     */
+    [[nodiscard]] std::optional<std::uint32_t> findPlayer(std::string_view name) const noexcept;
+
+    /**
+     * @brief Get a player's name
+     * @param player Dictionary index
+     * @return View into the mapping
+     */
+    [[nodiscard]] std::string_view getPlayerName(std::uint32_t player) const noexcept;
+
+    /**
+     * @brief Run a query
+     * @param query The filter
+     * @param visit Called with the number of every matching row, in time order; return false to stop
+     * @return Number of rows visited
+     */
+    template <typename Visitor>
+    std::uint64_t run(const LogQuery& query, Visitor&& visit) const;
+
+    [[nodiscard]] std::int64_t  getTime(std::uint64_t row) const noexcept { return mTime[row]; }
+    [[nodiscard]] std::int32_t  getX(std::uint64_t row) const noexcept { return mX[row]; }
+    [[nodiscard]] std::int32_t  getY(std::uint64_t row) const noexcept { return mY[row]; }
+    [[nodiscard]] std::int32_t  getZ(std::uint64_t row) const noexcept { return mZ[row]; }
+    [[nodiscard]] std::uint32_t getPlayer(std::uint64_t row) const noexcept { return mPlayer[row]; }
+
+private:
+    template <typename T>
+    [[nodiscard]] std::span<const T> section(std::uint64_t offset, std::uint64_t count) const noexcept {
+        return {reinterpret_cast<const T*>(mFile.data().data() + offset), static_cast<std::size_t>(count)};
+    }
+
+    MappedFile                       mFile;
+    LogIndexHeader                   mHeader;
+    std::string                      mError;
+    std::span<const std::int64_t>    mTime;
+    std::span<const std::int32_t>    mX, mY, mZ;
+    std::span<const std::uint32_t>   mPlayer;
+    std::span<const LogBlockSummary> mBlocks;
+    std::span<const std::uint64_t>   mPostingOffsets;
+    std::span<const std::uint32_t>   mPostings;
+    std::span<const std::uint64_t>   mNameOffsets;
+    std::span<const char>            mNames;
+};
+
+template <typename Visitor>
+std::uint64_t LogIndexReader::run(const LogQuery& query, Visitor&& visit) const {
+    // Rows are in time order, so the time range is one contiguous slice
+    const auto first = static_cast<std::uint64_t>(
+        std::lower_bound(mTime.begin(), mTime.end(), query.fromMs) - mTime.begin()
+    );
+    const auto last =
+        static_cast<std::uint64_t>(std::lower_bound(mTime.begin(), mTime.end(), query.toMs) - mTime.begin());
+    if (first >= last) {
+        return 0;
+    }
+
+    std::uint64_t matched = 0;
+    if (query.player) {
+        // Posting lists hold ascending row numbers, so the same slice is a binary search away
+        const auto postings = mPostings.subspan(
+            mPostingOffsets[*query.player],
+            mPostingOffsets[*query.player + 1] - mPostingOffsets[*query.player]
+        );
+        auto it = std::lower_bound(postings.begin(), postings.end(), first);
+        for (; it != postings.end() && *it < last; ++it) {
+            if (query.box.contains(mX[*it], mY[*it], mZ[*it])) {
+                ++matched;
+                if (!visit(static_cast<std::uint64_t>(*it))) {
+                    break;
+                }
+            }
+        }
+        return matched;
+    }
+
+    const auto blockRows = mHeader.blockRows;
+    for (auto block = first / blockRows; block * blockRows < last; ++block) {
+        if (!query.box.intersects(mBlocks[block])) {
+            continue;
+        }
+        const auto begin = std::max(first, block * blockRows);
+        const auto end   = std::min(last, (block + 1) * blockRows);
+        for (auto row = begin; row < end; ++row) {
+            if (query.box.contains(mX[row], mY[row], mZ[row])) {
+                ++matched;
+                if (!visit(row)) {
+                    return matched;
+                }
+            }
+        }
+    }
+    return matched;
+}
+
+/**
+ * @brief Convert a civil date to days since 1970-01-01
+ */
+[[nodiscard]] constexpr std::int64_t daysFromCivil(std::int64_t year, unsigned month, unsigned day) noexcept {
+    year -= month <= 2 ? 1 : 0;
+    const auto era = (year >= 0 ? year : year - 399) / 400;
+    const auto yoe = static_cast<unsigned>(year - era * 400);
+    const auto doy = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    const auto doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + static_cast<std::int64_t>(doe) - 719468;
+}
+
+/**
+ * @brief Render milliseconds since 1970-01-01 as `YYYY-MM-DD HH:MM:SS.mmm`
+ */
+[[nodiscard]] std::string formatLogTime(std::int64_t timeMs);
+
+} // namespace potato_bonemeal_blocker
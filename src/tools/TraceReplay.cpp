@@ -0,0 +1,215 @@
+// Offline replay of interaction traces captured with `/potatoblocker trace start`.
+//
+// Feeds every recorded interaction through the rule matcher as fast as possible,
+// reports throughput and compares the decisions of a rule set with the recorded ones.
+//
+// Usage:
+//   potato-bonemeal-blocker-trace-replay <trace.pbbt> [--rule item,block[,minStage]]... [--repeat N]
+//
+// Without --rule the plugin's default rule (bone meal on potatoes, every stage) is replayed.
+
+#include "mod/RuleMatcher.h"
+#include "mod/TraceFormat.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+using namespace potato_bonemeal_blocker;
+
+/**
+ * @brief Resolves rule names through the palette recorded with the trace
+ */
+class PaletteResolver final : public RuleMatcher::Resolver {
+public:
+    explicit PaletteResolver(const TracePalette& palette) : mPalette(palette) {}
+
+    [[nodiscard]] std::optional<std::int16_t> resolveItem(std::string_view name) const override {
+        return mPalette.findItem(name);
+    }
+
+    [[nodiscard]] std::optional<std::uint32_t>
+    resolveBlock(std::string_view name, std::uint8_t growthStage) const override {
+        return mPalette.findBlock(name, growthStage);
+    }
+
+private:
+    const TracePalette& mPalette;
+};
+
+/**
+ * @brief Parse `item,block[,minStage]`
+ */
+std::optional<GrowthRule> parseRule(std::string_view text) {
+    const auto first = text.find(',');
+    if (first == std::string_view::npos) {
+        return std::nullopt;
+    }
+    GrowthRule rule;
+    rule.itemName = std::string(text.substr(0, first));
+    text.remove_prefix(first + 1);
+
+    const auto second = text.find(',');
+    rule.blockName    = std::string(text.substr(0, second));
+    if (second != std::string_view::npos) {
+        const auto stage = std::strtoul(std::string(text.substr(second + 1)).c_str(), nullptr, 10);
+        if (stage > RuleMatcher::MAX_GROWTH_STAGE) {
+            return std::nullopt;
+        }
+        rule.minGrowthStage = static_cast<std::uint8_t>(stage);
+    }
+    return rule.itemName.empty() || rule.blockName.empty() ? std::nullopt : std::optional<GrowthRule>(rule);
+}
+
+/**
+ * @brief Decision counts of one replay pass, compared with the recorded decisions
+ */
+struct ReplayResult {
+    std::array<std::uint64_t, 3> decisions{};  ///< Indexed by TraceDecision
+    std::uint64_t                newlyBlocked = 0;
+    std::uint64_t                newlyAllowed = 0;
+    std::uint64_t                undetermined = 0; ///< Item now covered, but the block was never recorded
+};
+
+ReplayResult replay(std::span<const TraceRecord> records, const RuleMatcher& matcher) noexcept {
+    ReplayResult result;
+    for (const auto& record : records) {
+        auto decision = TraceDecision::IGNORED;
+        if (matcher.matchesItem(record.itemId)) {
+            if (record.blockRuntimeId == TraceRecord::UNKNOWN_BLOCK) {
+                ++result.undetermined;
+                continue;
+            }
+            decision = matcher.matches(record.itemId, record.blockRuntimeId) ? TraceDecision::BLOCKED
+                                                                              : TraceDecision::ALLOWED;
+        }
+        ++result.decisions[static_cast<std::size_t>(decision)];
+
+        const bool wasBlocked = record.decision == TraceDecision::BLOCKED;
+        const bool isBlocked  = decision == TraceDecision::BLOCKED;
+        result.newlyBlocked  += static_cast<std::uint64_t>(isBlocked && !wasBlocked);
+        result.newlyAllowed  += static_cast<std::uint64_t>(wasBlocked && !isBlocked);
+    }
+    return result;
+}
+
+int usage() {
+    std::fprintf(
+        stderr,
+        "usage: potato-bonemeal-blocker-trace-replay <trace.pbbt> [--rule item,block[,minStage]]... [--repeat N]\n"
+    );
+    return EXIT_FAILURE;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        return usage();
+    }
+
+    const std::filesystem::path tracePath = argv[1];
+    std::vector<GrowthRule>     rules;
+    std::uint64_t               repeat = 1;
+    for (int i = 2; i + 1 < argc; i += 2) {
+        const std::string_view option = argv[i];
+        if (option == "--rule") {
+            const auto rule = parseRule(argv[i + 1]);
+            if (!rule) {
+                std::fprintf(stderr, "Invalid rule: %s\n", argv[i + 1]);
+                return EXIT_FAILURE;
+            }
+            rules.push_back(*rule);
+        } else if (option == "--repeat") {
+            repeat = std::max<std::uint64_t>(1, std::strtoull(argv[i + 1], nullptr, 10));
+        } else {
+            return usage();
+        }
+    }
+    if (rules.empty()) {
+        rules.push_back(GrowthRule{"minecraft:bone_meal", "minecraft:potatoes", 0});
+    }
+
+    TraceReader reader;
+    if (!reader.open(tracePath)) {
+        std::fprintf(stderr, "%s: %.*s\n", argv[1], static_cast<int>(reader.getError().size()), reader.getError().data());
+        return EXIT_FAILURE;
+    }
+    TracePalette palette;
+    if (!palette.load(palettePathFor(tracePath))) {
+        std::fprintf(stderr, "Missing palette %s\n", palettePathFor(tracePath).string().c_str());
+        return EXIT_FAILURE;
+    }
+
+    RuleMatcher matcher;
+    const auto  report  = matcher.compile(rules, PaletteResolver{palette});
+    const auto  records = reader.getRecords();
+    for (const auto& name : report.unresolved) {
+        std::printf("not in trace palette: %s\n", name.c_str());
+    }
+    std::printf(
+        "trace: %zu records, version %u, %zu palette entries; rules: %zu of %zu compiled into %zu block states\n",
+        records.size(),
+        static_cast<unsigned>(reader.getHeader().version),
+        palette.size(),
+        report.compiledRules,
+        rules.size(),
+        report.blockStates
+    );
+
+    ReplayResult result;
+    const auto   start = std::chrono::steady_clock::now();
+    for (std::uint64_t pass = 0; pass < repeat; ++pass) {
+        result = replay(records, matcher);
+#if !defined(_MSC_VER)
+        // Keep the optimizer from folding repeated passes into one
+        asm volatile("" : : "r"(&result) : "memory");
+#endif
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+
+    std::uint64_t recorded[3]{};
+    for (const auto& record : records) {
+        ++recorded[static_cast<std::size_t>(record.decision) % 3];
+    }
+
+    const auto ns    = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+    const auto total = static_cast<double>(records.size()) * static_cast<double>(repeat);
+    std::printf(
+        "replayed %llu events in %.3f ms: %.2f ns/event, %.2f Mevents/s\n",
+        static_cast<unsigned long long>(total),
+        ns / 1e6,
+        total > 0 ? ns / total : 0.0,
+        ns > 0 ? total * 1e3 / ns : 0.0
+    );
+    std::printf(
+        "recorded: ignored %llu, allowed %llu, blocked %llu\n",
+        static_cast<unsigned long long>(recorded[0]),
+        static_cast<unsigned long long>(recorded[1]),
+        static_cast<unsigned long long>(recorded[2])
+    );
+    std::printf(
+        "replayed: ignored %llu, allowed %llu, blocked %llu, undetermined %llu\n",
+        static_cast<unsigned long long>(result.decisions[0]),
+        static_cast<unsigned long long>(result.decisions[1]),
+        static_cast<unsigned long long>(result.decisions[2]),
+        static_cast<unsigned long long>(result.undetermined)
+    );
+    std::printf(
+        "changed: %llu newly blocked, %llu newly allowed\n",
+        static_cast<unsigned long long>(result.newlyBlocked),
+        static_cast<unsigned long long>(result.newlyAllowed)
+    );
+    return EXIT_SUCCESS;
+}
@@ -2,84 +2,155 @@ add_rules("mode.debug", "mode.release")
 
 add_repositories("liteldev-repo https://github.com/LiteLDev/xmake-repo.git")
 
--- Target LeviLamina 3 v1.2.0 for compatibility
--- add_requires("levilamina develop") to use develop version
--- please note that you should add bdslibrary yourself if using dev version
-if is_config("target_type", "server") then
-    add_requires("levilamina 1.2.0", {configs = {target_type = "server"}})
-else
-    add_requires("levilamina 1.2.0", {configs = {target_type = "client"}})
-end
+-- LeviLamina only ships for Windows; other platforms build the mock-backed benchmark only
+if is_plat("windows") then
+    -- Target LeviLamina 3 v1.2.0 for compatibility
+    -- add_requires("levilamina develop") to use develop version
+    -- please note that you should add bdslibrary yourself if using dev version
+    if is_config("target_type", "server") then
+        add_requires("levilamina 1.2.0", {configs = {target_type = "server"}})
+    else
+        add_requires("levilamina 1.2.0", {configs = {target_type = "client"}})
+    end
 
-add_requires("levibuildscript")
+    add_requires("levibuildscript")
 
-if not has_config("vs_runtime") then
-    set_runtimes("MD")
+    if not has_config("vs_runtime") then
+        set_runtimes("MD")
+    end
 end
 
+-- Config file parsing for the mock-backed targets; the plugin gets it through LeviLamina
+add_requires("nlohmann_json")
+
 option("target_type")
     set_default("server")
     set_showmenu(true)
     set_values("server", "client")
 option_end()
 
-target("potato-bonemeal-blocker") -- Main plugin target
-    add_rules("@levibuildscript/linkrule")
-    add_rules("@levibuildscript/modpacker")
-    add_cxflags( "/EHa", "/utf-8", "/W4", "/w44265", "/w44289", "/w44296", "/w45263", "/w44738", "/w45204")
-    add_defines("NOMINMAX", "UNICODE")
-    add_packages("levilamina")
-    set_exceptions("none") -- To avoid conflicts with /EHa.
-    set_kind("shared")
-    set_languages("c++20")
-    set_symbols("debug")
+-- Hot-path counters and latency histograms (/potatoblocker stats, metrics.prom)
+-- Disable with: xmake f --metrics=n
+option("metrics")
+    set_default(true)
+    set_showmenu(true)
+    set_description("Compile handler metrics instrumentation")
+option_end()
 
-    -- Explicit runtime library linking to resolve dependency issues
-    add_syslinks("kernel32", "user32", "gdi32", "winspool", "shell32", "ole32", "oleaut32", "uuid", "comdlg32", "advapi32")
+if is_plat("windows") then
+    target("potato-bonemeal-blocker") -- Main plugin target
+        add_rules("@levibuildscript/linkrule")
+        add_rules("@levibuildscript/modpacker")
+        add_cxflags("/utf-8", "/W4", "/w44265", "/w44289", "/w44296", "/w45263", "/w44738", "/w45204")
+        add_defines("NOMINMAX", "UNICODE")
+        add_packages("levilamina")
+        add_options("metrics")
+        if has_config("metrics") then
+            add_defines("PBB_ENABLE_METRICS")
+        end
+        set_exceptions("cxx") -- /EHsc: the handler catches C++ exceptions at one boundary, not SEH
+        set_kind("shared")
+        set_languages("c++20")
+        set_symbols("debug")
 
-    -- Ensure proper runtime library linking
-    if is_mode("release") then
-        set_runtimes("MD")  -- Multi-threaded DLL runtime
-    else
-        set_runtimes("MDd") -- Multi-threaded DLL debug runtime
-    end
-    add_headerfiles("src/mod/**.h")
-    add_files("src/mod/**.cpp")
-    add_files("src/potato-bonemeal-blocker.def")
-    add_includedirs("src")
+        -- Explicit runtime library linking to resolve dependency issues
+        add_syslinks("kernel32", "user32", "gdi32", "winspool", "shell32", "ole32", "oleaut32", "uuid", "comdlg32", "advapi32")
 
-    -- Ensure Language.cpp is included in the build
-    add_files("src/mod/Language.cpp")
-    -- Optimization flags for release builds
-    if is_mode("release") then
-        add_cxflags("/O2", "/Ob2", "/Oi", "/Ot", "/Oy")
-        add_ldflags("/OPT:REF", "/OPT:ICF")
-        add_defines("NDEBUG")
-        -- Note: Removed /GL and /LTCG to avoid linking conflicts with LeviLamina
-        -- The performance impact is minimal and build stability is more important
-    end
+        -- Ensure proper runtime library linking
+        if is_mode("release") then
+            set_runtimes("MD")  -- Multi-threaded DLL runtime
+        else
+            set_runtimes("MDd") -- Multi-threaded DLL debug runtime
+        end
+        add_headerfiles("src/mod/**.h")
+        add_files("src/mod/**.cpp")
+        add_files("src/potato-bonemeal-blocker.def")
+        add_includedirs("src")
 
-    -- Add delay loading for better dependency handling
-    add_ldflags("/DELAYLOAD:bedrock_runtime.dll")
+        -- Ensure Language.cpp is included in the build
+        add_files("src/mod/Language.cpp")
+        -- Optimization flags for release builds
+        if is_mode("release") then
+            add_cxflags("/O2", "/Ob2", "/Oi", "/Ot", "/Oy")
+            add_ldflags("/OPT:REF", "/OPT:ICF")
+            add_defines("NDEBUG")
+            -- Note: Removed /GL and /LTCG to avoid linking conflicts with LeviLamina
+            -- The performance impact is minimal and build stability is more important
+        end
 
-    -- Ensure proper module definition
-    add_ldflags("/EXPORT:ll_plugin_load")
-    add_ldflags("/EXPORT:ll_plugin_unload")
+        -- Add delay loading for better dependency handling
+        add_ldflags("/DELAYLOAD:bedrock_runtime.dll")
+
+        -- Ensure proper module definition
+        add_ldflags("/EXPORT:ll_plugin_load")
+        add_ldflags("/EXPORT:ll_plugin_unload")
+end
 
 -- Note: Additional test targets can be added here when test files are created
 -- Example targets (currently disabled due to missing files):
 -- target("potato-bonemeal-blocker-test") - requires src/test/PotatoBoneMealBlockerTest.cpp
--- target("potato-bonemeal-blocker-benchmark") - requires src/test/PerformanceBenchmark.cpp
 
--- LL3 v1.2.0 compatibility test target
-target("potato-bonemeal-blocker-ll3-test")
+-- Standalone performance benchmark: drives the real handler through the mock
+-- LeviLamina layer in src/test/mock, so it builds on Linux without LeviLamina
+target("potato-bonemeal-blocker-benchmark")
     set_kind("binary")
     set_languages("c++20")
-    add_defines("STANDALONE_LL3_TEST", "NOMINMAX", "UNICODE")
-    add_headerfiles("src/mod/**.h")
-    add_files("src/mod/PotatoBoneMealBlocker.cpp", "src/test/LL3CompatibilityTest.cpp")
-    add_includedirs("src")
-    set_symbols("debug")
-    -- Mock LeviLamina dependencies for testing
     add_defines("MOCK_LEVILAMINA")
+    add_options("metrics")
+    if has_config("metrics") then
+        add_defines("PBB_ENABLE_METRICS")
+    end
+    add_files("src/mod/**.cpp|MemoryOperators.cpp")
+    add_files("src/test/mock/**.cpp", "src/test/PerformanceBenchmark.cpp")
+    add_includedirs("src/test/mock", "src")
+    add_packages("nlohmann_json")
+    if is_plat("windows") then
+        add_cxflags("/utf-8")
+        add_defines("NOMINMAX", "UNICODE")
+    else
+        add_syslinks("pthread")
+    end
+    set_symbols("debug")
+    set_optimize("fastest")
+    set_default(false) -- Don't build by default
+
+-- Offline replay of interaction traces (/potatoblocker trace start)
+target("potato-bonemeal-blocker-trace-replay")
+    set_kind("binary")
+    set_languages("c++20")
+    add_files("src/mod/MappedFile.cpp", "src/mod/RuleMatcher.cpp", "src/mod/TraceFormat.cpp")
+    add_files("src/tools/TraceReplay.cpp")
+    add_includedirs("src")
+    if is_plat("windows") then
+        add_defines("NOMINMAX", "UNICODE")
+    end
+    set_optimize("fastest")
     set_default(false) -- Don't build by default
+
+-- Offline analysis of blocked-attempt log lines
+target("potato-bonemeal-blocker-log-analyzer")
+    set_kind("binary")
+    set_languages("c++20")
+    add_files("src/mod/Language.cpp", "src/mod/MappedFile.cpp")
+    add_files("src/tools/LogAnalyzer.cpp", "src/tools/LogIndex.cpp")
+    add_includedirs("src")
+    if is_plat("windows") then
+        add_defines("NOMINMAX", "UNICODE")
+    else
+        add_syslinks("pthread")
+    end
+    set_optimize("fastest")
+    set_default(false) -- Don't build by default
+
+-- Multi-process test of the host_share segment; forks its workers, so POSIX only
+if not is_plat("windows") then
+    target("potato-bonemeal-blocker-host-share-harness")
+        set_kind("binary")
+        set_languages("c++20")
+        add_files("src/mod/HostShare.cpp", "src/mod/SharedMemory.cpp")
+        add_files("src/tools/HostShareHarness.cpp")
+        add_includedirs("src")
+        add_syslinks("pthread", "rt")
+        set_optimize("fastest")
+        set_default(false) -- Don't build by default
+end